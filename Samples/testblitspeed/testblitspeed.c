@@ -0,0 +1,640 @@
+/*
+  Copyright (C) 1997-2019 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+/* Simple program:  Time every SIMD blitter this CPU can run against the
+   generated scalar blitter it replaces, for each kind of blit it handles,
+   and check that both draw exactly the same pixels. The colour-key
+   blitters are timed against the SDL_blit_N.c ones the same way. */
+
+#include <xtl.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "SDL.h"
+
+/* The blitters aren't public, so this reaches into the library's source */
+#include "video/SDL_blit.h"
+#include "video/SDL_blit_auto.h"
+#include "video/SDL_blit_simd.h"
+#include "video/SDL_pixels_c.h"
+
+#define BLIT_WIDTH      256
+#define BLIT_HEIGHT     256
+#define NUM_ITERATIONS  50
+
+static const int blit_flags[] = {
+    SDL_COPY_NEAREST,
+    SDL_COPY_MODULATE_COLOR,
+    SDL_COPY_MODULATE_ALPHA,
+    SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA,
+    SDL_COPY_BLEND,
+    SDL_COPY_BLEND_PREMULTIPLIED,
+    SDL_COPY_ADD,
+    SDL_COPY_MOD,
+    SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND,
+    SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND_PREMULTIPLIED,
+    SDL_COPY_MODULATE_COLOR | SDL_COPY_ADD,
+    SDL_COPY_MODULATE_ALPHA | SDL_COPY_MOD,
+    SDL_COPY_MODULATE_COLOR | SDL_COPY_BLEND | SDL_COPY_NEAREST,
+    SDL_COPY_MODULATE_ALPHA | SDL_COPY_ADD | SDL_COPY_NEAREST,
+    SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND_PREMULTIPLIED | SDL_COPY_NEAREST
+};
+
+static Uint32 src_pixels[BLIT_WIDTH * BLIT_HEIGHT];
+static Uint32 dst_pixels[BLIT_WIDTH * BLIT_HEIGHT];
+static Uint32 scalar_pixels[BLIT_WIDTH * BLIT_HEIGHT];
+static Uint32 simd_pixels[BLIT_WIDTH * BLIT_HEIGHT];
+
+static SDL_bool
+HasCPUFeatures(Uint32 cpu)
+{
+    if ((cpu & SDL_CPU_MMX) && !SDL_HasMMX()) {
+        return SDL_FALSE;
+    }
+    if ((cpu & SDL_CPU_SSE) && !SDL_HasSSE()) {
+        return SDL_FALSE;
+    }
+    if ((cpu & SDL_CPU_SSE2) && !SDL_HasSSE2()) {
+        return SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
+
+/* The generated blitter SDL would pick for these formats and flags */
+static SDL_BlitFunc
+FindScalarBlit(Uint32 src_format, Uint32 dst_format, int flags)
+{
+    int i;
+
+    for (i = 0; SDL_GeneratedBlitFuncTable[i].func; ++i) {
+        const SDL_BlitFuncEntry *entry = &SDL_GeneratedBlitFuncTable[i];
+        if (entry->src_format == src_format && entry->dst_format == dst_format &&
+            (entry->flags & flags) == flags && entry->cpu == SDL_CPU_ANY) {
+            return entry->func;
+        }
+    }
+    return NULL;
+}
+
+static void
+SetupBlitInfo(SDL_BlitInfo *info, SDL_PixelFormat *src_fmt, SDL_PixelFormat *dst_fmt,
+              int flags, Uint32 *dst)
+{
+    SDL_zerop(info);
+    info->src = (Uint8 *) src_pixels;
+    info->src_pitch = BLIT_WIDTH * 4;
+    info->src_fmt = src_fmt;
+    info->dst = (Uint8 *) dst;
+    info->dst_pitch = BLIT_WIDTH * 4;
+    info->dst_fmt = dst_fmt;
+    info->flags = flags;
+    info->r = 0xC0;
+    info->g = 0x80;
+    info->b = 0x40;
+    info->a = 0xA0;
+
+    if (flags & SDL_COPY_NEAREST) {
+        /* stretch the top left corner over everything */
+        info->src_w = BLIT_WIDTH / 3;
+        info->src_h = BLIT_HEIGHT / 3;
+    } else {
+        info->src_w = BLIT_WIDTH;
+        info->src_h = BLIT_HEIGHT;
+    }
+    info->dst_w = BLIT_WIDTH;
+    info->dst_h = BLIT_HEIGHT;
+}
+
+static void
+RunBlit(SDL_BlitFunc blit, SDL_PixelFormat *src_fmt, SDL_PixelFormat *dst_fmt,
+        int flags, Uint32 *dst)
+{
+    SDL_BlitInfo info;
+
+    SetupBlitInfo(&info, src_fmt, dst_fmt, flags, dst);
+    blit(&info);
+}
+
+static double
+TimeBlit(SDL_BlitFunc blit, SDL_PixelFormat *src_fmt, SDL_PixelFormat *dst_fmt,
+         int flags, Uint32 *dst)
+{
+    Uint64 start, elapsed;
+    int i;
+
+    /* Blending onto the results of the last blit is just as much work */
+    SDL_memcpy(dst, dst_pixels, sizeof(dst_pixels));
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < NUM_ITERATIONS; ++i) {
+        RunBlit(blit, src_fmt, dst_fmt, flags, dst);
+    }
+    elapsed = SDL_GetPerformanceCounter() - start;
+
+    /* Leave one blit's worth of output to compare */
+    SDL_memcpy(dst, dst_pixels, sizeof(dst_pixels));
+    RunBlit(blit, src_fmt, dst_fmt, flags, dst);
+
+    return ((double) elapsed * 1000) / SDL_GetPerformanceFrequency() / NUM_ITERATIONS;
+}
+
+/* Times a colour-keyed blit of src onto a copy of dst left in out */
+static double
+TimeKeyBlit(SDL_BlitFunc blit, SDL_Surface *src, SDL_Surface *dst, SDL_Surface *out)
+{
+    SDL_BlitInfo info;
+    Uint64 start, elapsed = 0;
+    int i;
+
+    for (i = 0; i <= NUM_ITERATIONS; ++i) {
+        SDL_memcpy(out->pixels, dst->pixels, dst->pitch * dst->h);
+        info = src->map->info;
+        info.src = (Uint8 *) src->pixels;
+        info.src_w = info.dst_w = src->w;
+        info.src_h = info.dst_h = src->h;
+        info.src_pitch = src->pitch;
+        info.src_skip = src->pitch - src->w * src->format->BytesPerPixel;
+        info.dst = (Uint8 *) out->pixels;
+        info.dst_pitch = out->pitch;
+        info.dst_skip = out->pitch - out->w * out->format->BytesPerPixel;
+        start = SDL_GetPerformanceCounter();
+        blit(&info);
+        /* the first one warms the caches up */
+        if (i > 0) {
+            elapsed += SDL_GetPerformanceCounter() - start;
+        }
+    }
+    return ((double) elapsed * 1000) / SDL_GetPerformanceFrequency() / NUM_ITERATIONS;
+}
+
+static int
+TestKeyBlits(void)
+{
+    int i, mismatches = 0;
+
+    for (i = 0; SDL_SIMDKeyBlitFuncTable[i].func; ++i) {
+        const SDL_BlitFuncEntry *entry = &SDL_SIMDKeyBlitFuncTable[i];
+        SDL_Surface *src, *dst, *scalar_out, *simd_out;
+        SDL_BlitFunc scalar;
+        double scalar_ms, simd_ms;
+        Uint32 key;
+        SDL_bool same;
+        int y;
+
+        if (!HasCPUFeatures(entry->cpu)) {
+            continue;
+        }
+        src = SDL_CreateRGBSurfaceWithFormatFrom(src_pixels, BLIT_WIDTH, BLIT_HEIGHT, 0, BLIT_WIDTH * 4, entry->src_format);
+        dst = SDL_CreateRGBSurfaceWithFormatFrom(dst_pixels, BLIT_WIDTH, BLIT_HEIGHT, 0, BLIT_WIDTH * 4, entry->dst_format);
+        scalar_out = SDL_CreateRGBSurfaceWithFormatFrom(scalar_pixels, BLIT_WIDTH, BLIT_HEIGHT, 0, BLIT_WIDTH * 4, entry->dst_format);
+        simd_out = SDL_CreateRGBSurfaceWithFormatFrom(simd_pixels, BLIT_WIDTH, BLIT_HEIGHT, 0, BLIT_WIDTH * 4, entry->dst_format);
+        if (!src || !dst || !scalar_out || !simd_out) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create surfaces: %s\n", SDL_GetError());
+            return 1;
+        }
+
+        /* key out about a third of the sprite in runs, like the background around one */
+        key = (src->format->BytesPerPixel == 2) ? *(Uint16 *) src->pixels : *(Uint32 *) src->pixels;
+        for (y = 0; y < BLIT_HEIGHT; ++y) {
+            Uint8 *row = (Uint8 *) src->pixels + y * src->pitch;
+            int x;
+            for (x = (y * 7) % 64; x < BLIT_WIDTH; x += 96) {
+                const int n = SDL_min(32, BLIT_WIDTH - x);
+                if (src->format->BytesPerPixel == 2) {
+                    SDL_memset4(row + x * 2, key | (key << 16), n / 2);
+                } else {
+                    SDL_memset4(row + x * 4, key, n);
+                }
+            }
+        }
+        SDL_SetColorKey(src, SDL_TRUE, key);
+        SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
+
+        /* the library sets the blit up, then the scalar one is picked like it was before */
+        SDL_BlitSurface(src, NULL, dst, NULL);
+        scalar = SDL_CalculateBlitN(src);
+
+        scalar_ms = TimeKeyBlit(scalar, src, dst, scalar_out);
+        simd_ms = TimeKeyBlit(entry->func, src, dst, simd_out);
+        same = (SDL_memcmp(scalar_pixels, simd_pixels, sizeof(simd_pixels)) == 0);
+        if (!same) {
+            ++mismatches;
+        }
+
+        SDL_Log("%s -> %s colorkey cpu 0x%02x: scalar %.3f ms, simd %.3f ms, %.2fx%s\n",
+                SDL_GetPixelFormatName(entry->src_format),
+                SDL_GetPixelFormatName(entry->dst_format), entry->cpu,
+                scalar_ms, simd_ms, simd_ms > 0.0 ? (scalar_ms / simd_ms) : 0.0,
+                same ? "" : " MISMATCH");
+
+        SDL_FreeSurface(src);
+        SDL_FreeSurface(dst);
+        SDL_FreeSurface(scalar_out);
+        SDL_FreeSurface(simd_out);
+    }
+    return mismatches;
+}
+
+/* Times SDL_ConvertPixels() against a blit between surfaces wrapped around
+   the same pixels, which is what it did for every conversion before, and
+   checks they agree on everything but the unused bits */
+static int
+TestConvertPixels(void)
+{
+    static const Uint32 formats[][2] = {
+        { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888 },
+        { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888 },
+        { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGRA8888 },
+        { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888 },
+        { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888 },
+        { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888 },
+        { SDL_PIXELFORMAT_RGB24, SDL_PIXELFORMAT_ARGB8888 },
+        { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR24 },
+        { SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_ARGB8888 },
+        { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB565 },
+        { SDL_PIXELFORMAT_RGB555, SDL_PIXELFORMAT_ABGR8888 },
+        { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB555 }
+    };
+    int i, mismatches = 0;
+
+    for (i = 0; i < (int) SDL_arraysize(formats); ++i) {
+        const Uint32 src_format = formats[i][0], dst_format = formats[i][1];
+        const int src_pitch = BLIT_WIDTH * SDL_BYTESPERPIXEL(src_format);
+        const int dst_pitch = BLIT_WIDTH * SDL_BYTESPERPIXEL(dst_format);
+        SDL_Surface *src, *dst;
+        Uint32 Rmask, Gmask, Bmask, Amask, used;
+        Uint64 start, blit = 0, convert = 0;
+        SDL_bool same = SDL_TRUE;
+        int bpp, j;
+
+        src = SDL_CreateRGBSurfaceWithFormatFrom(src_pixels, BLIT_WIDTH, BLIT_HEIGHT, 0, src_pitch, src_format);
+        dst = SDL_CreateRGBSurfaceWithFormatFrom(scalar_pixels, BLIT_WIDTH, BLIT_HEIGHT, 0, dst_pitch, dst_format);
+        if (!src || !dst) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create surfaces: %s\n", SDL_GetError());
+            return 1;
+        }
+        SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
+
+        for (j = 0; j < NUM_ITERATIONS; ++j) {
+            start = SDL_GetPerformanceCounter();
+            SDL_BlitSurface(src, NULL, dst, NULL);
+            /* a new blit map every time, like SDL_ConvertPixels() had */
+            SDL_InvalidateMap(src->map);
+            blit += SDL_GetPerformanceCounter() - start;
+
+            start = SDL_GetPerformanceCounter();
+            SDL_ConvertPixels(BLIT_WIDTH, BLIT_HEIGHT, src_format, src_pixels, src_pitch,
+                              dst_format, simd_pixels, dst_pitch);
+            convert += SDL_GetPerformanceCounter() - start;
+        }
+
+        SDL_PixelFormatEnumToMasks(dst_format, &bpp, &Rmask, &Gmask, &Bmask, &Amask);
+        used = Rmask | Gmask | Bmask | Amask;
+        for (j = 0; j < BLIT_WIDTH * BLIT_HEIGHT; ++j) {
+            const Uint8 *a = (const Uint8 *) scalar_pixels + j * (bpp / 8);
+            const Uint8 *b = (const Uint8 *) simd_pixels + j * (bpp / 8);
+            Uint32 pixel_a, pixel_b;
+
+            RETRIEVE_RGB_PIXEL(a, bpp / 8, pixel_a);
+            RETRIEVE_RGB_PIXEL(b, bpp / 8, pixel_b);
+            if ((pixel_a ^ pixel_b) & used) {
+                same = SDL_FALSE;
+                ++mismatches;
+                break;
+            }
+        }
+
+        SDL_Log("%s -> %s convert: blit map %.3f ms, direct %.3f ms, %.2fx%s\n",
+                SDL_GetPixelFormatName(src_format), SDL_GetPixelFormatName(dst_format),
+                ((double) blit * 1000) / SDL_GetPerformanceFrequency() / NUM_ITERATIONS,
+                ((double) convert * 1000) / SDL_GetPerformanceFrequency() / NUM_ITERATIONS,
+                convert ? ((double) blit / convert) : 0.0, same ? "" : " MISMATCH");
+
+        SDL_FreeSurface(src);
+        SDL_FreeSurface(dst);
+    }
+    return mismatches;
+}
+
+/* Times 32x32 sprites blitted to a back buffer and a layer of another format
+   in turn, with the mappings to both kept and with a new mapping on every
+   switch, which is what it took before, and checks they draw the same */
+static int
+TestSwitchingTargets(void)
+{
+    static const Uint32 formats[] = {
+        SDL_PIXELFORMAT_INDEX8, SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_ARGB8888
+    };
+    static const Uint32 targets[] = { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB565 };
+    SDL_Surface *dst[2][2] = { { NULL, NULL }, { NULL, NULL } };
+    int i, j, k, mismatches = 0;
+
+    for (i = 0; i < 2; ++i) {
+        for (j = 0; j < 2; ++j) {
+            dst[i][j] = SDL_CreateRGBSurfaceWithFormat(0, 320, 240, 0, targets[j]);
+            if (!dst[i][j]) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create surface: %s\n", SDL_GetError());
+                goto done;
+            }
+        }
+    }
+
+    for (i = 0; i < (int) SDL_arraysize(formats); ++i) {
+        SDL_Surface *sprite;
+        Uint64 start, kept = 0, remapped = 0;
+
+        sprite = SDL_CreateRGBSurfaceWithFormat(0, 32, 32, 0, formats[i]);
+        if (!sprite) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create surface: %s\n", SDL_GetError());
+            break;
+        }
+        SDL_memcpy(sprite->pixels, src_pixels, sprite->pitch * sprite->h);
+        if (sprite->format->palette) {
+            SDL_Color colors[256];
+
+            for (j = 0; j < 256; ++j) {
+                colors[j].r = (Uint8) src_pixels[j];
+                colors[j].g = (Uint8) (src_pixels[j] >> 8);
+                colors[j].b = (Uint8) (src_pixels[j] >> 16);
+                colors[j].a = 0xFF;
+            }
+            SDL_SetPaletteColors(sprite->format->palette, colors, 0, 256);
+        }
+        if (SDL_ISPIXELFORMAT_ALPHA(formats[i])) {
+            SDL_SetSurfaceBlendMode(sprite, SDL_BLENDMODE_BLEND);
+        } else {
+            SDL_SetColorKey(sprite, SDL_TRUE, 0);
+        }
+        for (j = 0; j < 2; ++j) {
+            SDL_FillRect(dst[0][j], NULL, 0);
+            SDL_FillRect(dst[1][j], NULL, 0);
+        }
+
+        for (j = 0; j < NUM_ITERATIONS; ++j) {
+            for (k = 0; k < 2; ++k) {
+                int n;
+
+                start = SDL_GetPerformanceCounter();
+                for (n = 0; n < 64; ++n) {
+                    SDL_Rect dstrect;
+                    dstrect.x = (n * 37 + j) % (320 - 32);
+                    dstrect.y = (n * 53 + j) % (240 - 32);
+                    if (k) {
+                        SDL_InvalidateMap(sprite->map);
+                    }
+                    SDL_BlitSurface(sprite, NULL, dst[k][n & 1], &dstrect);
+                }
+                if (k) {
+                    remapped += SDL_GetPerformanceCounter() - start;
+                } else {
+                    kept += SDL_GetPerformanceCounter() - start;
+                }
+            }
+        }
+
+        for (j = 0; j < 2; ++j) {
+            if (SDL_memcmp(dst[0][j]->pixels, dst[1][j]->pixels, dst[0][j]->pitch * dst[0][j]->h) != 0) {
+                ++mismatches;
+            }
+        }
+        SDL_Log("%s sprites to two formats in turn: remapped %.3f ms, kept %.3f ms, %.2fx\n",
+                SDL_GetPixelFormatName(formats[i]),
+                ((double) remapped * 1000) / SDL_GetPerformanceFrequency() / NUM_ITERATIONS,
+                ((double) kept * 1000) / SDL_GetPerformanceFrequency() / NUM_ITERATIONS,
+                kept ? ((double) remapped / kept) : 0.0);
+        SDL_FreeSurface(sprite);
+    }
+
+done:
+    for (i = 0; i < 2; ++i) {
+        SDL_FreeSurface(dst[i][0]);
+        SDL_FreeSurface(dst[i][1]);
+    }
+    return mismatches;
+}
+
+/* Times clearing and copying whole surfaces of different sizes, and the small
+   sprite blits after each, which are what the cache was left to. Fills and
+   copies past SDL_STREAMING_THRESHOLD write around the cache. */
+static void
+TestStreaming(void)
+{
+    static const int sizes[][2] = {
+        { 64, 64 }, { 256, 256 }, { 640, 480 }, { 1280, 720 }, { 1920, 1080 }
+    };
+    SDL_Surface *sprite;
+    int i;
+
+    sprite = SDL_CreateRGBSurfaceWithFormat(0, 256, 256, 0, SDL_PIXELFORMAT_ARGB8888);
+    if (!sprite) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create surface: %s\n", SDL_GetError());
+        return;
+    }
+    SDL_memcpy(sprite->pixels, src_pixels, SDL_min(sizeof(src_pixels), (size_t) (sprite->pitch * sprite->h)));
+    SDL_SetSurfaceBlendMode(sprite, SDL_BLENDMODE_BLEND);
+
+    /* Without the SSE paths, nothing here writes around the cache */
+#if HAVE_SSE_INTRINSICS
+    SDL_Log("Fills and copies of %d bytes and up stream: %s\n", SDL_STREAMING_THRESHOLD,
+            SDL_HasSSE() ? "yes" : "no, this CPU has no SSE");
+#else
+    SDL_Log("Fills and copies of %d bytes and up stream: no, built without SSE intrinsics\n",
+            SDL_STREAMING_THRESHOLD);
+#endif
+
+    for (i = 0; i < (int) SDL_arraysize(sizes); ++i) {
+        const int w = sizes[i][0], h = sizes[i][1];
+        SDL_Surface *src, *dst;
+        Uint64 start, fill = 0, copy = 0, sprites = 0;
+        double mb, fill_ms, copy_ms, sprites_ms;
+        int j, k;
+
+        src = SDL_CreateRGBSurfaceWithFormat(0, w, h, 0, SDL_PIXELFORMAT_ARGB8888);
+        dst = SDL_CreateRGBSurfaceWithFormat(0, w, h, 0, SDL_PIXELFORMAT_ARGB8888);
+        if (!src || !dst) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create surfaces: %s\n", SDL_GetError());
+            SDL_FreeSurface(src);
+            SDL_FreeSurface(dst);
+            break;
+        }
+        SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
+
+        for (j = 0; j < NUM_ITERATIONS; ++j) {
+            start = SDL_GetPerformanceCounter();
+            SDL_FillRect(dst, NULL, 0xFF000000 | j);
+            fill += SDL_GetPerformanceCounter() - start;
+
+            start = SDL_GetPerformanceCounter();
+            for (k = 0; k < 16; ++k) {
+                SDL_Rect srcrect, dstrect;
+                srcrect.x = (k * 48) % 224;
+                srcrect.y = (k * 80) % 224;
+                srcrect.w = srcrect.h = 32;
+                dstrect.x = (k * 37) % SDL_max(1, w - 32);
+                dstrect.y = (k * 53) % SDL_max(1, h - 32);
+                SDL_BlitSurface(sprite, &srcrect, dst, &dstrect);
+            }
+            sprites += SDL_GetPerformanceCounter() - start;
+
+            start = SDL_GetPerformanceCounter();
+            SDL_BlitSurface(src, NULL, dst, NULL);
+            copy += SDL_GetPerformanceCounter() - start;
+        }
+
+        mb = (double) (w * 4) * h / (1024.0 * 1024.0);
+        fill_ms = ((double) fill * 1000) / SDL_GetPerformanceFrequency() / NUM_ITERATIONS;
+        copy_ms = ((double) copy * 1000) / SDL_GetPerformanceFrequency() / NUM_ITERATIONS;
+        sprites_ms = ((double) sprites * 1000) / SDL_GetPerformanceFrequency() / NUM_ITERATIONS;
+        SDL_Log("%dx%d: fill %.3f ms (%.0f MB/s), copy %.3f ms (%.0f MB/s), 16 sprites after fill %.3f ms\n",
+                w, h, fill_ms, fill_ms > 0.0 ? mb * 1000 / fill_ms : 0.0,
+                copy_ms, copy_ms > 0.0 ? mb * 1000 / copy_ms : 0.0, sprites_ms);
+
+        SDL_FreeSurface(src);
+        SDL_FreeSurface(dst);
+    }
+    SDL_FreeSurface(sprite);
+}
+
+/* Times a scratch surface made and freed for every use against one borrowed
+   from and returned to a surface pool, as text or effects code would do */
+static void
+TestSurfacePool(void)
+{
+    SDL_SurfacePool *pool;
+    SDL_SurfacePoolStats stats;
+    SDL_Surface *dst;
+    Uint64 start, created = 0, pooled = 0;
+    int i, j;
+
+    pool = SDL_CreateSurfacePool(0);
+    dst = SDL_CreateRGBSurfaceWithFormat(0, 320, 240, 0, SDL_PIXELFORMAT_RGB565);
+    if (!pool || !dst) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create surface pool: %s\n", SDL_GetError());
+        SDL_DestroySurfacePool(pool);
+        SDL_FreeSurface(dst);
+        return;
+    }
+
+    for (i = 0; i < NUM_ITERATIONS; ++i) {
+        for (j = 0; j < 2; ++j) {
+            SDL_Surface *scratch;
+            int n;
+
+            start = SDL_GetPerformanceCounter();
+            for (n = 0; n < 64; ++n) {
+                const int w = 32 + (n & 3) * 16;
+
+                if (j) {
+                    scratch = SDL_BorrowPoolSurface(pool, w, 16, SDL_PIXELFORMAT_ARGB8888);
+                } else {
+                    scratch = SDL_CreateRGBSurfaceWithFormat(0, w, 16, 0, SDL_PIXELFORMAT_ARGB8888);
+                }
+                if (!scratch) {
+                    continue;
+                }
+                SDL_FillRect(scratch, NULL, 0x80FFFFFF);
+                SDL_BlitSurface(scratch, NULL, dst, NULL);
+                if (j) {
+                    SDL_ReturnPoolSurface(pool, scratch);
+                } else {
+                    SDL_FreeSurface(scratch);
+                }
+            }
+            if (j) {
+                pooled += SDL_GetPerformanceCounter() - start;
+            } else {
+                created += SDL_GetPerformanceCounter() - start;
+            }
+        }
+    }
+
+    SDL_GetSurfacePoolStats(pool, &stats);
+    SDL_Log("64 scratch surfaces: created %.3f ms, pooled %.3f ms, %.2fx, %.0f%% hits, %d idle\n",
+            ((double) created * 1000) / SDL_GetPerformanceFrequency() / NUM_ITERATIONS,
+            ((double) pooled * 1000) / SDL_GetPerformanceFrequency() / NUM_ITERATIONS,
+            pooled ? ((double) created / pooled) : 0.0, stats.hit_rate * 100.0f, stats.idle_surfaces);
+
+    SDL_DestroySurfacePool(pool);
+    SDL_FreeSurface(dst);
+}
+
+int
+main(int argc, char *argv[])
+{
+    int i, j, mismatches = 0;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    srand(0);
+    for (i = 0; i < (int) SDL_arraysize(src_pixels); ++i) {
+        src_pixels[i] = ((Uint32) rand() << 16) ^ (Uint32) rand();
+        dst_pixels[i] = ((Uint32) rand() << 16) ^ (Uint32) rand();
+    }
+    /* make sure fully transparent and fully opaque pixels show up */
+    for (i = 0; i + 3 < (int) SDL_arraysize(src_pixels); i += 7) {
+        src_pixels[i] |= 0xFF000000;
+        src_pixels[i + 3] &= 0x00FFFFFF;
+    }
+
+    for (i = 0; SDL_SIMDBlitFuncTable[i].func; ++i) {
+        const SDL_BlitFuncEntry *entry = &SDL_SIMDBlitFuncTable[i];
+        SDL_PixelFormat *src_fmt, *dst_fmt;
+
+        if (!HasCPUFeatures(entry->cpu)) {
+            continue;
+        }
+        src_fmt = SDL_AllocFormat(entry->src_format);
+        dst_fmt = SDL_AllocFormat(entry->dst_format);
+
+        for (j = 0; j < (int) SDL_arraysize(blit_flags); ++j) {
+            const int flags = blit_flags[j];
+            SDL_BlitFunc scalar = FindScalarBlit(entry->src_format, entry->dst_format, flags);
+            double scalar_ms, simd_ms;
+            SDL_bool same;
+
+            if ((entry->flags & flags) != flags || !scalar) {
+                continue;
+            }
+            scalar_ms = TimeBlit(scalar, src_fmt, dst_fmt, flags, scalar_pixels);
+            simd_ms = TimeBlit(entry->func, src_fmt, dst_fmt, flags, simd_pixels);
+            same = (SDL_memcmp(scalar_pixels, simd_pixels, sizeof(simd_pixels)) == 0);
+            if (!same) {
+                ++mismatches;
+            }
+
+            SDL_Log("%s -> %s flags 0x%04x cpu 0x%02x: scalar %.3f ms, simd %.3f ms, %.2fx%s\n",
+                    SDL_GetPixelFormatName(entry->src_format),
+                    SDL_GetPixelFormatName(entry->dst_format), flags, entry->cpu,
+                    scalar_ms, simd_ms, simd_ms > 0.0 ? (scalar_ms / simd_ms) : 0.0,
+                    same ? "" : " MISMATCH");
+        }
+
+        SDL_FreeFormat(src_fmt);
+        SDL_FreeFormat(dst_fmt);
+    }
+
+    mismatches += TestKeyBlits();
+    mismatches += TestConvertPixels();
+    mismatches += TestSwitchingTargets();
+    TestStreaming();
+    TestSurfacePool();
+
+    SDL_Log("%d mismatches\n", mismatches);
+    SDL_Quit();
+    return mismatches ? 1 : 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,325 @@
+/*
+  Copyright (C) 1997-2019 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+/* Simple program:  Check that SDL_LoadBMP_RWFormat() decodes BMPs of every
+   kind it handles to the same pixels as loading them and converting them
+   afterwards, and time both for a 24-bit image. */
+
+#include <xtl.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "SDL.h"
+
+#define PATTERN_WIDTH   256
+#define PATTERN_HEIGHT  256
+#define NUM_ITERATIONS  50
+
+/* Random pixels, which also make up the palettes */
+static Uint32 src_pixels[PATTERN_WIDTH * PATTERN_HEIGHT];
+
+/* Whether two surfaces of the same size and format have the same pixels */
+static SDL_bool
+SamePixels(SDL_Surface *a, SDL_Surface *b)
+{
+    int y;
+
+    if (a->w != b->w || a->h != b->h || a->format->format != b->format->format) {
+        return SDL_FALSE;
+    }
+    for (y = 0; y < a->h; ++y) {
+        if (SDL_memcmp((Uint8 *) a->pixels + y * a->pitch, (Uint8 *) b->pixels + y * b->pitch,
+                       a->w * a->format->BytesPerPixel) != 0) {
+            return SDL_FALSE;
+        }
+    }
+    return SDL_TRUE;
+}
+
+/* Times loading a 24-bit BMP from memory and converting it afterwards against
+   decoding it straight into the format it's wanted in, and checks both give
+   the same pixels */
+static int
+TestLoadBMP(void)
+{
+    static const Uint32 formats[] = {
+        SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_ARGB8888
+    };
+    SDL_Surface *image;
+    SDL_RWops *rw;
+    Uint8 *file;
+    int size, i, j, y, mismatches = 0;
+
+    image = SDL_CreateRGBSurfaceWithFormat(0, 640, 480, 0, SDL_PIXELFORMAT_RGB24);
+    if (!image) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create surface: %s\n", SDL_GetError());
+        return 0;
+    }
+    for (y = 0; y < image->h; ++y) {
+        SDL_memcpy((Uint8 *) image->pixels + y * image->pitch,
+                   (Uint8 *) src_pixels + (y % PATTERN_HEIGHT) * PATTERN_WIDTH * 4, image->w * 3);
+    }
+
+    /* a BMP's headers are 54 bytes, and its rows are padded to 4 bytes */
+    size = 54 + image->h * ((image->w * 3 + 3) & ~3);
+    file = (Uint8 *) SDL_malloc(size);
+    rw = file ? SDL_RWFromMem(file, size) : NULL;
+    if (!rw || SDL_SaveBMP_RW(image, rw, 1) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't save BMP: %s\n", SDL_GetError());
+        SDL_free(file);
+        SDL_FreeSurface(image);
+        return 0;
+    }
+    SDL_FreeSurface(image);
+
+    for (i = 0; i < (int) SDL_arraysize(formats); ++i) {
+        SDL_Surface *converted = NULL, *decoded = NULL;
+        Uint64 start, convert = 0, decode = 0;
+
+        for (j = 0; j < NUM_ITERATIONS; ++j) {
+            SDL_FreeSurface(converted);
+            SDL_FreeSurface(decoded);
+
+            start = SDL_GetPerformanceCounter();
+            image = SDL_LoadBMP_RW(SDL_RWFromConstMem(file, size), 1);
+            converted = image ? SDL_ConvertSurfaceFormat(image, formats[i], 0) : NULL;
+            SDL_FreeSurface(image);
+            convert += SDL_GetPerformanceCounter() - start;
+
+            start = SDL_GetPerformanceCounter();
+            decoded = SDL_LoadBMP_RWFormat(SDL_RWFromConstMem(file, size), 1, formats[i]);
+            decode += SDL_GetPerformanceCounter() - start;
+        }
+
+        if (!converted || !decoded) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't load BMP: %s\n", SDL_GetError());
+            ++mismatches;
+        } else {
+            const SDL_bool same = SamePixels(converted, decoded);
+
+            if (!same) {
+                ++mismatches;
+            }
+            SDL_Log("640x480 BMP -> %s: load and convert %.3f ms, decode into format %.3f ms, %.2fx%s\n",
+                    SDL_GetPixelFormatName(formats[i]),
+                    ((double) convert * 1000) / SDL_GetPerformanceFrequency() / NUM_ITERATIONS,
+                    ((double) decode * 1000) / SDL_GetPerformanceFrequency() / NUM_ITERATIONS,
+                    decode ? ((double) convert / decode) : 0.0,
+                    same ? "" : " MISMATCH");
+        }
+        SDL_FreeSurface(converted);
+        SDL_FreeSurface(decoded);
+    }
+
+    SDL_free(file);
+    return mismatches;
+}
+
+/* A 6x4 BI_RLE8 image, bottom row first: a run and three indices as they
+   are, a run then a jump right 2 and down 1, a run, and the end of the image
+   before the last row */
+static const Uint8 rle8_data[] = {
+    3, 1,   0, 3, 2, 3, 4, 0,   0, 0,
+    2, 5,   0, 2, 2, 1,
+    2, 6,   0, 0,
+    0, 1
+};
+static const Uint8 rle8_indices[4][6] = {
+    { 0, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, 0, 6, 6 },
+    { 5, 5, 0, 0, 0, 0 },
+    { 1, 1, 1, 2, 3, 4 }
+};
+
+/* An 8x2 BI_RLE4 image: a run of two indices taking turns and three indices
+   as they are, then a run and the end of the image partway through the row */
+static const Uint8 rle4_data[] = {
+    5, 0x78,   0, 3, 0x12, 0x30,   0, 0,
+    4, 0x9A,   0, 1
+};
+static const Uint8 rle4_indices[2][8] = {
+    { 9, 10, 9, 10, 0, 0, 0, 0 },
+    { 7, 8, 7, 8, 7, 1, 2, 3 }
+};
+
+/* Writes a bottom-up BMP with a BITMAPINFOHEADER, the first ncolors colours
+   of src_pixels as its palette and the given pixels to file, and returns its
+   size */
+static int
+BuildBMP(Uint8 *file, int size, int w, int h, int bpp, Uint32 compression,
+         int ncolors, const void *pixels, int pixels_size)
+{
+    const int offset = 14 + 40 + ncolors * 4;
+    SDL_RWops *rw;
+    int i;
+
+    rw = SDL_RWFromMem(file, size);
+    if (!rw || offset + pixels_size > size) {
+        return 0;
+    }
+    SDL_RWwrite(rw, "BM", 1, 2);
+    SDL_WriteLE32(rw, offset + pixels_size);
+    SDL_WriteLE16(rw, 0);
+    SDL_WriteLE16(rw, 0);
+    SDL_WriteLE32(rw, offset);
+    SDL_WriteLE32(rw, 40);
+    SDL_WriteLE32(rw, w);
+    SDL_WriteLE32(rw, h);
+    SDL_WriteLE16(rw, 1);
+    SDL_WriteLE16(rw, bpp);
+    SDL_WriteLE32(rw, compression);
+    SDL_WriteLE32(rw, pixels_size);
+    SDL_WriteLE32(rw, 0);
+    SDL_WriteLE32(rw, 0);
+    SDL_WriteLE32(rw, ncolors);
+    SDL_WriteLE32(rw, 0);
+    for (i = 0; i < ncolors; ++i) {
+        SDL_WriteLE32(rw, src_pixels[i] & 0x00FFFFFF);
+    }
+    SDL_RWwrite(rw, pixels, 1, pixels_size);
+    SDL_RWclose(rw);
+    return offset + pixels_size;
+}
+
+/* Checks a run-length encoded BMP decodes to the expected indices, and to
+   the palette colours of them in ARGB8888 */
+static int
+CheckDecodeRLE(const char *name, const Uint8 *file, int size, const Uint8 *expected, int w, int h)
+{
+    SDL_Surface *indexed, *argb;
+    SDL_bool same = SDL_TRUE;
+    int x, y;
+
+    indexed = SDL_LoadBMP_RWFormat(SDL_RWFromConstMem(file, size), 1, 0);
+    argb = SDL_LoadBMP_RWFormat(SDL_RWFromConstMem(file, size), 1, SDL_PIXELFORMAT_ARGB8888);
+    if (!indexed || !argb || indexed->format->format != SDL_PIXELFORMAT_INDEX8 ||
+        indexed->w != w || indexed->h != h || argb->w != w || argb->h != h) {
+        same = SDL_FALSE;
+    } else {
+        for (y = 0; y < h; ++y) {
+            const Uint8 *index = (const Uint8 *) indexed->pixels + y * indexed->pitch;
+            const Uint32 *pixel = (const Uint32 *) ((const Uint8 *) argb->pixels + y * argb->pitch);
+
+            for (x = 0; x < w; ++x) {
+                if (index[x] != expected[y * w + x] ||
+                    pixel[x] != (0xFF000000 | (src_pixels[expected[y * w + x]] & 0x00FFFFFF))) {
+                    same = SDL_FALSE;
+                }
+            }
+        }
+    }
+    SDL_Log("%s BMP: %s\n", name, same ? "decoded" : "MISMATCH");
+
+    SDL_FreeSurface(indexed);
+    SDL_FreeSurface(argb);
+    return same ? 0 : 1;
+}
+
+/* Checks a BMP decoded straight into a format gives the same pixels as
+   loading it and converting it afterwards */
+static int
+CheckDecodeBMP(const char *name, const Uint8 *file, int size)
+{
+    static const Uint32 formats[] = {
+        0, SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB565
+    };
+    int i, mismatches = 0;
+
+    for (i = 0; i < (int) SDL_arraysize(formats); ++i) {
+        SDL_Surface *image, *converted, *decoded;
+        SDL_bool same;
+
+        image = SDL_LoadBMP_RW(SDL_RWFromConstMem(file, size), 1);
+        converted = (image && formats[i]) ? SDL_ConvertSurfaceFormat(image, formats[i], 0) : image;
+        decoded = SDL_LoadBMP_RWFormat(SDL_RWFromConstMem(file, size), 1, formats[i]);
+        same = (converted && decoded && SamePixels(converted, decoded)) ? SDL_TRUE : SDL_FALSE;
+        if (!same) {
+            ++mismatches;
+        }
+        SDL_Log("%s BMP -> %s: %s\n", name,
+                formats[i] ? SDL_GetPixelFormatName(formats[i]) : "its own format",
+                same ? "same as load and convert" : "MISMATCH");
+
+        if (converted != image) {
+            SDL_FreeSurface(converted);
+        }
+        SDL_FreeSurface(image);
+        SDL_FreeSurface(decoded);
+    }
+    return mismatches;
+}
+
+/* Checks the parts of SDL_LoadBMP_RWFormat() a 24-bit image doesn't go
+   through: run-length encoding, 1 and 4 bit indices, and 32-bit images
+   whose alpha only shows up a few rows in */
+static int
+TestDecodeBMP(void)
+{
+    static Uint8 file[1024];
+    Uint32 pixels[9 * 6];
+    int size, i, mismatches = 0;
+
+    size = BuildBMP(file, sizeof(file), 6, 4, 8, 1 /* BI_RLE8 */, 7, rle8_data, sizeof(rle8_data));
+    mismatches += CheckDecodeRLE("6x4 RLE8", file, size, &rle8_indices[0][0], 6, 4);
+
+    size = BuildBMP(file, sizeof(file), 8, 2, 4, 2 /* BI_RLE4 */, 16, rle4_data, sizeof(rle4_data));
+    mismatches += CheckDecodeRLE("8x2 RLE4", file, size, &rle4_indices[0][0], 8, 2);
+
+    /* rows of 13 pixels are 2 bytes at 1 bit a pixel and 7 bytes at 4, padded to 4 and 8 */
+    size = BuildBMP(file, sizeof(file), 13, 5, 1, 0 /* BI_RGB */, 2, src_pixels, 5 * 4);
+    mismatches += CheckDecodeBMP("13x5 1-bit", file, size);
+
+    size = BuildBMP(file, sizeof(file), 13, 5, 4, 0 /* BI_RGB */, 16, src_pixels, 5 * 8);
+    mismatches += CheckDecodeBMP("13x5 4-bit", file, size);
+
+    /* the first three rows have no alpha, so they were taken to be opaque
+       until the fourth turned up */
+    for (i = 0; i < (int) SDL_arraysize(pixels); ++i) {
+        pixels[i] = (i < 9 * 3) ? (src_pixels[i] & 0x00FFFFFF) : src_pixels[i];
+    }
+    size = BuildBMP(file, sizeof(file), 9, 6, 32, 0 /* BI_RGB */, 0, pixels, sizeof(pixels));
+    mismatches += CheckDecodeBMP("9x6 32-bit", file, size);
+
+    return mismatches;
+}
+
+int
+main(int argc, char *argv[])
+{
+    int i, mismatches = 0;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    srand(0);
+    for (i = 0; i < (int) SDL_arraysize(src_pixels); ++i) {
+        src_pixels[i] = ((Uint32) rand() << 16) ^ (Uint32) rand();
+    }
+    /* make sure fully transparent and fully opaque pixels show up */
+    for (i = 0; i + 3 < (int) SDL_arraysize(src_pixels); i += 7) {
+        src_pixels[i] |= 0xFF000000;
+        src_pixels[i + 3] &= 0x00FFFFFF;
+    }
+
+    mismatches += TestLoadBMP();
+    mismatches += TestDecodeBMP();
+
+    SDL_Log("%d mismatches\n", mismatches);
+    SDL_Quit();
+    return mismatches ? 1 : 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
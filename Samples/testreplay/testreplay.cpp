@@ -0,0 +1,110 @@
+/*
+  Copyright (C) 1997-2019 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+/* Simple program:  Replay a frame recorded with SDL_RenderCaptureFrame() on the
+   software renderer, as fast as possible, and report how long it took.
+   testsprite2 --capture FILE records one.
+
+   Usage: testreplay [FILE] [ITERATIONS], FILE defaults to D:\capture.rcap */
+
+#include <xtl.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "SDL.h"
+
+#define NUM_ITERATIONS  100
+
+static SDL_RenderCapture *capture;
+static SDL_Surface *surface;
+static SDL_Renderer *renderer;
+
+/* Call this instead of exit(), so we can clean up SDL: atexit() is evil. */
+static void
+quit(int rc)
+{
+    SDL_FreeRenderCapture(capture);
+    if (renderer) {
+        SDL_DestroyRenderer(renderer);
+    }
+    SDL_FreeSurface(surface);
+    SDL_Quit();
+    exit(rc);
+}
+
+int
+main(int argc, char *argv[])
+{
+    const char *file = "D:\\capture.rcap";
+    int iterations = NUM_ITERATIONS;
+    Uint64 start, elapsed;
+    double ms;
+    int i, w, h;
+
+    for (i = 1; i < argc; ++i) {
+        if (SDL_isdigit(*argv[i])) {
+            iterations = SDL_atoi(argv[i]);
+        } else {
+            file = argv[i];
+        }
+    }
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    capture = SDL_LoadRenderCapture(SDL_RWFromFile(file, "rb"), 1);
+    if (!capture) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't load %s: %s\n", file, SDL_GetError());
+        quit(2);
+    }
+    SDL_GetRenderCaptureSize(capture, &w, &h);
+
+    /* Draw into memory, so nothing but the renderer is measured */
+    surface = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (!surface) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create surface: %s\n", SDL_GetError());
+        quit(2);
+    }
+    renderer = SDL_CreateSoftwareRenderer(surface);
+    if (!renderer) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create renderer: %s\n", SDL_GetError());
+        quit(2);
+    }
+
+    /* The first replay creates and uploads the textures, leave it out of the timing */
+    if (SDL_RenderReplayCapture(renderer, capture) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't replay %s: %s\n", file, SDL_GetError());
+        quit(2);
+    }
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < iterations; ++i) {
+        if (SDL_RenderReplayCapture(renderer, capture) < 0) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't replay %s: %s\n", file, SDL_GetError());
+            quit(2);
+        }
+    }
+    elapsed = SDL_GetPerformanceCounter() - start;
+
+    ms = ((double) elapsed * 1000) / SDL_GetPerformanceFrequency();
+    SDL_Log("%d replays of %s (%dx%d) in %.2f ms, %.3f ms per frame\n",
+            iterations, file, w, h, ms, iterations ? (ms / iterations) : 0.0);
+
+    quit(0);
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
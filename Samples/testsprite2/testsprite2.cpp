@@ -45,6 +45,10 @@ static const Uint32 fps_check_delay = 5000;
 /* -1: infinite random moves (default); >=0: enables N deterministic moves */
 static int iterations = -1;
 
+/* Where to record a frame for testreplay, see SDL_RenderCaptureFrame() */
+static const char *capture_file;
+static SDL_RWops *capture_rw;
+
 int done;
 
 /* Call this instead of exit(), so we can clean up SDL: atexit() is evil. */
@@ -260,6 +264,31 @@ loop()
             continue;
         MoveSprites(state->renderers[i], sprites[i]);
     }
+    if (capture_file) {
+        if (capture_rw) {
+            /* the frame just presented has been written out, unless writing failed */
+            const int status = SDL_RenderGetCaptureStatus(state->renderers[0]);
+
+            SDL_RWclose(capture_rw);
+            capture_rw = NULL;
+            if (status < 0) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't capture to %s: %s\n", capture_file, SDL_GetError());
+                quit(2);
+            }
+            SDL_Log("Captured a frame to %s\n", capture_file);
+            capture_file = NULL;
+        } else {
+            capture_rw = SDL_RWFromFile(capture_file, "wb");
+            if (!capture_rw || SDL_RenderCaptureFrame(state->renderers[0], capture_rw) < 0) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't capture to %s: %s\n", capture_file, SDL_GetError());
+                if (capture_rw) {
+                    SDL_RWclose(capture_rw);
+                    capture_rw = NULL;
+                }
+                capture_file = NULL;
+            }
+        }
+    }
 #ifdef __EMSCRIPTEN__
     if (done) {
         emscripten_cancel_main_loop();
@@ -326,6 +355,11 @@ main(int argc, char *argv[])
                     if (iterations < -1) iterations = -1;
                     consumed = 2;
                 }
+            } else if (SDL_strcasecmp(argv[i], "--capture") == 0) {
+                if (argv[i + 1]) {
+                    capture_file = argv[i + 1];
+                    consumed = 2;
+                }
             } else if (SDL_strcasecmp(argv[i], "--cyclecolor") == 0) {
                 cycle_color = SDL_TRUE;
                 consumed = 1;
@@ -341,7 +375,7 @@ main(int argc, char *argv[])
             }
         }
         if (consumed < 0) {
-            static const char *options[] = { "[--blend none|blend|add|mod]", "[--cyclecolor]", "[--cyclealpha]", "[--iterations N]", "[num_sprites]", "[icon.bmp]", NULL };
+            static const char *options[] = { "[--blend none|blend|add|mod]", "[--cyclecolor]", "[--cyclealpha]", "[--iterations N]", "[--capture FILE]", "[num_sprites]", "[icon.bmp]", NULL };
             SDLTest_CommonLogUsage(state, argv[0], options);
             quit(1);
         }
@@ -1086,6 +1086,36 @@ extern "C" {
  */
 #define SDL_HINT_RENDER_BATCHING  "SDL_RENDER_BATCHING"
 
+/**
+ *  \brief  A variable controlling how many threads the software renderer draws with.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - One thread per CPU core (default)
+ *    "1"       - Draw on the thread that flushes the command queue only
+ *    "N"       - Split drawing across N threads
+ *
+ *  The window surface is cut into horizontal bands that are drawn at the same
+ *  time. Fills and unscaled copies are split this way, everything else is still
+ *  drawn in order on the calling thread. This hint is read when the renderer is
+ *  created.
+ */
+#define SDL_HINT_RENDER_THREADS  "SDL_RENDER_THREADS"
+
+/**
+ *  \brief  A variable controlling how many threads large images are converted with.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - One thread per CPU core (default)
+ *    "1"       - Convert on the calling thread only
+ *    "N"       - Split conversions across N threads
+ *
+ *  SDL_ConvertSurface() and SDL_ConvertPixels() split images of 256x256 pixels
+ *  and up into bands of rows that are converted at the same time. The result
+ *  is the same either way. This hint is read the first time a large image is
+ *  converted.
+ */
+#define SDL_HINT_CONVERT_THREADS  "SDL_CONVERT_THREADS"
+
 
 /**
  *  \brief  A variable controlling whether SDL logs all events pushed onto its internal queue.
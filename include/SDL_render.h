@@ -85,6 +85,70 @@ typedef struct SDL_RendererInfo
     int max_texture_height;     /**< The maximum texture height */
 } SDL_RendererInfo;
 
+/**
+ *  \brief Usage of the per-renderer arena that holds queued render commands
+ *         and their vertex data between flushes.
+ *
+ *  \sa SDL_RenderGetArenaInfo()
+ *  \sa SDL_RenderReserveArena()
+ */
+typedef struct SDL_RenderArenaInfo
+{
+    int commands_queued;         /**< Commands currently waiting to be flushed */
+    int commands_capacity;       /**< Commands that can be queued without allocating */
+    int commands_high_water;     /**< Most commands ever queued between two flushes */
+    int vertex_bytes_queued;     /**< Vertex bytes currently waiting to be flushed */
+    int vertex_bytes_capacity;   /**< Vertex bytes that can be queued without allocating */
+    int vertex_bytes_high_water; /**< Most vertex bytes ever queued between two flushes */
+} SDL_RenderArenaInfo;
+
+/**
+ *  \brief Why the renderer sent its queued commands to the backend.
+ *
+ *  \sa SDL_RenderStats
+ */
+typedef enum
+{
+    SDL_RENDER_FLUSH_PRESENT,        /**< SDL_RenderPresent() */
+    SDL_RENDER_FLUSH_EXPLICIT,       /**< SDL_RenderFlush() */
+    SDL_RENDER_FLUSH_TEXTURE_UPDATE, /**< A texture used by queued draws was updated, locked or destroyed */
+    SDL_RENDER_FLUSH_TARGET_SWITCH,  /**< SDL_SetRenderTarget() */
+    SDL_RENDER_FLUSH_READ_PIXELS,    /**< SDL_RenderReadPixels() */
+    SDL_RENDER_FLUSH_NOT_BATCHING,   /**< Batching is off, so every call flushes */
+    SDL_RENDER_FLUSH_OTHER,          /**< Anything else, like native API access */
+    SDL_NUM_RENDER_FLUSH_REASONS
+} SDL_RenderFlushReason;
+
+/**
+ *  \brief Counters for one frame of rendering, as seen by the command queue.
+ *
+ *  Binds and blend changes are counted between consecutive draws, which is
+ *  what a backend has to change its state for.
+ *
+ *  \sa SDL_RenderGetStats()
+ */
+typedef struct SDL_RenderStats
+{
+    Uint32 frame;               /**< Frames presented before this one */
+    int viewport_commands;      /**< Viewport changes */
+    int cliprect_commands;      /**< Clip rectangle changes */
+    int draw_color_commands;    /**< Draw color changes */
+    int clear_commands;         /**< Clears */
+    int point_commands;         /**< Point draws */
+    int line_commands;          /**< Line draws */
+    int fill_commands;          /**< Rectangle fills */
+    int copy_commands;          /**< Texture copies, after merging */
+    int copy_ex_commands;       /**< Rotated or flipped texture copies, after merging */
+    int sprites;                /**< Sprites drawn by all of the copy commands */
+    int culled;                 /**< Points, line segments, rectangles and sprites dropped
+                                     before queueing because they were out of sight */
+    int vertex_bytes;           /**< Vertex data sent to the backend */
+    int texture_binds;          /**< Draws that used a different texture than the draw before */
+    int blend_changes;          /**< Draws that used a different blend mode than the draw before */
+    int flushes;                /**< Times the queue was sent to the backend */
+    int flush_reasons[SDL_NUM_RENDER_FLUSH_REASONS]; /**< Flushes, by SDL_RenderFlushReason */
+} SDL_RenderStats;
+
 /**
  *  \brief The access pattern allowed for a texture.
  */
@@ -430,6 +494,29 @@ extern DECLSPEC int SDLCALL SDL_LockTexture(SDL_Texture * texture,
                                             const SDL_Rect * rect,
                                             void **pixels, int *pitch);
 
+/**
+ *  \brief Lock a portion of the texture for write-only pixel access, and get
+ *         a surface for the locked pixels, to blit or draw into directly.
+ *
+ *  \param texture   The texture to lock for access, which was created with
+ *                   ::SDL_TEXTUREACCESS_STREAMING.
+ *  \param rect      A pointer to the rectangle to lock for access. If the rect
+ *                   is NULL, the entire texture will be locked.
+ *  \param surface   This is filled in with a surface for the locked area. It
+ *                   can only be used until the texture is unlocked. Locking
+ *                   the same area again gives back the same surface, so blits
+ *                   to it, say from an 8-bit surface whose palette changes
+ *                   every frame, don't have to be set up again each time.
+ *
+ *  \return 0 on success, or -1 if the texture is not valid or was not created with ::SDL_TEXTUREACCESS_STREAMING.
+ *
+ *  \sa SDL_LockTexture()
+ *  \sa SDL_UnlockTexture()
+ */
+extern DECLSPEC int SDLCALL SDL_LockTextureToSurface(SDL_Texture * texture,
+                                                     const SDL_Rect * rect,
+                                                     SDL_Surface ** surface);
+
 /**
  *  \brief Unlock a texture, uploading the changes to video memory, if needed.
  *
@@ -977,6 +1064,61 @@ extern DECLSPEC int SDLCALL SDL_RenderCopyExF(SDL_Renderer * renderer,
                                             const SDL_FPoint *center,
                                             const SDL_RendererFlip flip);
 
+/**
+ *  \brief Copy many portions of one texture to the current rendering target.
+ *
+ *  This draws the same as calling SDL_RenderCopyF() once per sprite, but the
+ *  checks are done once for the whole batch and the sprites are queued as a
+ *  single draw.
+ *
+ *  \param renderer The renderer which should copy parts of a texture.
+ *  \param texture  The source texture.
+ *  \param srcrects An array of count source rectangles, or NULL to use the
+ *                  entire texture for every sprite.
+ *  \param dstrects An array of count destination rectangles.
+ *  \param count    The number of sprites to draw.
+ *
+ *  \return 0 on success, or -1 on error
+ *
+ *  \sa SDL_RenderCopyExBatch()
+ */
+extern DECLSPEC int SDLCALL SDL_RenderCopyBatch(SDL_Renderer * renderer,
+                                                SDL_Texture * texture,
+                                                const SDL_Rect * srcrects,
+                                                const SDL_FRect * dstrects,
+                                                int count);
+
+/**
+ *  \brief Copy many portions of one texture to the current rendering target,
+ *         each with its own rotation and flip.
+ *
+ *  This draws the same as calling SDL_RenderCopyExF() once per sprite.
+ *
+ *  \param renderer The renderer which should copy parts of a texture.
+ *  \param texture  The source texture.
+ *  \param srcrects An array of count source rectangles, or NULL to use the
+ *                  entire texture for every sprite.
+ *  \param dstrects An array of count destination rectangles.
+ *  \param angles   An array of count angles in degrees, or NULL for no rotation.
+ *  \param centers  An array of count rotation centers, or NULL to rotate each
+ *                  sprite around dstrect.w/2, dstrect.h/2.
+ *  \param flips    An array of count SDL_RendererFlip values, or NULL for no
+ *                  flipping.
+ *  \param count    The number of sprites to draw.
+ *
+ *  \return 0 on success, or -1 on error
+ *
+ *  \sa SDL_RenderCopyBatch()
+ */
+extern DECLSPEC int SDLCALL SDL_RenderCopyExBatch(SDL_Renderer * renderer,
+                                                  SDL_Texture * texture,
+                                                  const SDL_Rect * srcrects,
+                                                  const SDL_FRect * dstrects,
+                                                  const double * angles,
+                                                  const SDL_FPoint * centers,
+                                                  const SDL_RendererFlip * flips,
+                                                  int count);
+
 /**
  *  \brief Read pixels from the current rendering target.
  *
@@ -1043,6 +1185,253 @@ extern DECLSPEC void SDLCALL SDL_DestroyRenderer(SDL_Renderer * renderer);
  */
 extern DECLSPEC int SDLCALL SDL_RenderFlush(SDL_Renderer * renderer);
 
+/**
+ *  \brief Get the usage and high-water marks of the renderer's command arena.
+ *
+ *  Queued commands and vertex data live in a per-renderer arena that is
+ *  rewound on every flush and only grows while the application warms up.
+ *  The high-water marks can be fed back into SDL_RenderReserveArena() so
+ *  that later runs don't allocate at all.
+ *
+ *  \param renderer The renderer to query
+ *  \param info     A pointer to an SDL_RenderArenaInfo struct to be filled in
+ *
+ *  \return 0 on success, or -1 on error
+ *
+ *  \sa SDL_RenderReserveArena()
+ */
+extern DECLSPEC int SDLCALL SDL_RenderGetArenaInfo(SDL_Renderer * renderer,
+                                                   SDL_RenderArenaInfo * info);
+
+/**
+ *  \brief Size the renderer's command arena up front.
+ *
+ *  This flushes any pending commands, then makes sure at least \c commands
+ *  render commands and \c vertex_bytes bytes of vertex data can be queued
+ *  without allocating. The arena never shrinks.
+ *
+ *  \param renderer     The renderer to size
+ *  \param commands     The number of commands to reserve space for
+ *  \param vertex_bytes The number of vertex bytes to reserve space for
+ *
+ *  \return 0 on success, or -1 on error
+ *
+ *  \sa SDL_RenderGetArenaInfo()
+ */
+extern DECLSPEC int SDLCALL SDL_RenderReserveArena(SDL_Renderer * renderer,
+                                                   int commands, int vertex_bytes);
+
+/**
+ *  \brief Get the statistics for the last frame the renderer presented.
+ *
+ *  \param renderer The renderer to query.
+ *  \param stats    A pointer filled in with the counters.
+ *
+ *  \return 0 on success, or -1 on error
+ *
+ *  \sa SDL_RenderPresent()
+ */
+extern DECLSPEC int SDLCALL SDL_RenderGetStats(SDL_Renderer * renderer, SDL_RenderStats * stats);
+
+/**
+ *  \brief A packer that places many small images on a few large textures.
+ *
+ *  Sprites that share an atlas page can be merged into a single draw by the
+ *  renderer, see SDL_RenderCopyBatch().
+ */
+struct SDL_TextureAtlas;
+typedef struct SDL_TextureAtlas SDL_TextureAtlas;
+
+/**
+ *  \brief An image placed in a texture atlas.
+ *
+ *  The atlas owns this structure. It may move the image to another page or
+ *  position when it is defragmented, so read texture and rect each time they
+ *  are used instead of caching them.
+ */
+typedef struct SDL_AtlasEntry
+{
+    SDL_Texture *texture;       /**< The atlas page holding the image */
+    SDL_Rect rect;              /**< Where the image is on that page */
+} SDL_AtlasEntry;
+
+/**
+ *  \brief Information about how well a texture atlas is packed.
+ */
+typedef struct SDL_AtlasInfo
+{
+    int pages;                  /**< Number of textures in use */
+    int entries;                /**< Number of images in the atlas */
+    int total_pixels;           /**< Pixels across all pages */
+    int used_pixels;            /**< Pixels covered by images */
+    int reclaimable_pixels;     /**< Pixels freed by SDL_AtlasRemove() that a defragment would recover */
+    float efficiency;           /**< used_pixels / total_pixels, from 0.0 to 1.0 */
+} SDL_AtlasInfo;
+
+/**
+ *  \brief Create a texture atlas for a renderer.
+ *
+ *  \param renderer  The renderer the atlas pages are created for.
+ *  \param format    The pixel format of the pages, or 0 for SDL_PIXELFORMAT_ARGB8888.
+ *  \param page_w    The width of each page.
+ *  \param page_h    The height of each page.
+ *  \param padding   Empty pixels kept between images, so filtering doesn't bleed.
+ *  \param max_pages The most pages the atlas may create, or 0 for no limit.
+ *
+ *  \return The atlas, or NULL on error.
+ *
+ *  \note The atlas must be destroyed before its renderer.
+ *
+ *  \sa SDL_DestroyTextureAtlas()
+ */
+extern DECLSPEC SDL_TextureAtlas * SDLCALL SDL_CreateTextureAtlas(SDL_Renderer * renderer,
+                                                                  Uint32 format,
+                                                                  int page_w, int page_h,
+                                                                  int padding, int max_pages);
+
+/**
+ *  \brief Copy a surface into a texture atlas.
+ *
+ *  If there is no room the atlas first defragments itself, then adds a page
+ *  if it is allowed to.
+ *
+ *  \param atlas   The texture atlas.
+ *  \param surface The image to add, in any format.
+ *
+ *  \return The entry for the image, or NULL if it doesn't fit.
+ *
+ *  \sa SDL_AtlasRemove()
+ */
+extern DECLSPEC SDL_AtlasEntry * SDLCALL SDL_AtlasAddSurface(SDL_TextureAtlas * atlas,
+                                                             SDL_Surface * surface);
+
+/**
+ *  \brief Evict an image from a texture atlas.
+ *
+ *  The space is reused by later images of the same size or smaller, and fully
+ *  recovered by SDL_AtlasDefragment().
+ *
+ *  \param atlas The texture atlas.
+ *  \param entry The entry to remove; it is invalid afterwards.
+ */
+extern DECLSPEC void SDLCALL SDL_AtlasRemove(SDL_TextureAtlas * atlas, SDL_AtlasEntry * entry);
+
+/**
+ *  \brief Repack all images in a texture atlas, and free any pages left empty.
+ *
+ *  Entries are updated in place. This uploads every page again, so it is best
+ *  done between levels rather than every frame.
+ *
+ *  \param atlas The texture atlas.
+ *
+ *  \return 0 on success, or -1 on error; the atlas is unchanged on error.
+ */
+extern DECLSPEC int SDLCALL SDL_AtlasDefragment(SDL_TextureAtlas * atlas);
+
+/**
+ *  \brief Get the allocation efficiency of a texture atlas.
+ *
+ *  \param atlas The texture atlas.
+ *  \param info  A pointer filled in with the current figures.
+ *
+ *  \return 0 on success, or -1 on error
+ */
+extern DECLSPEC int SDLCALL SDL_GetAtlasInfo(SDL_TextureAtlas * atlas, SDL_AtlasInfo * info);
+
+/**
+ *  \brief Destroy a texture atlas, its pages and all of its entries.
+ *
+ *  \param atlas The texture atlas.
+ */
+extern DECLSPEC void SDLCALL SDL_DestroyTextureAtlas(SDL_TextureAtlas * atlas);
+
+/**
+ *  \brief A recorded frame of rendering, loaded with SDL_LoadRenderCapture().
+ */
+struct SDL_RenderCapture;
+typedef struct SDL_RenderCapture SDL_RenderCapture;
+
+/**
+ *  \brief Record the next frame drawn with a renderer.
+ *
+ *  Every draw call, state change and the contents of every texture used are
+ *  written to \c dst until the next call to SDL_RenderPresent(), so call this
+ *  right after presenting a frame. Coordinates are recorded after the
+ *  renderer's scale and logical size have been applied.
+ *
+ *  \param renderer The renderer to record.
+ *  \param dst      The stream the capture is written to, it must stay open
+ *                  until the frame is presented.
+ *
+ *  \return 0 on success, or -1 on error
+ *
+ *  \sa SDL_RenderGetCaptureStatus()
+ *  \sa SDL_LoadRenderCapture()
+ */
+extern DECLSPEC int SDLCALL SDL_RenderCaptureFrame(SDL_Renderer * renderer, SDL_RWops * dst);
+
+/**
+ *  \brief Find out whether the last frame captured was written completely.
+ *
+ *  Writing a capture can fail partway through the frame, for example when
+ *  the disk fills up, and SDL_RenderPresent() can't report it. Call this
+ *  after presenting a captured frame.
+ *
+ *  \param renderer The renderer the frame was captured from.
+ *
+ *  \return 1 while a frame is still being captured, 0 if the last capture
+ *          was written completely or there hasn't been one, or -1 if it
+ *          wasn't, with SDL_GetError() saying so.
+ *
+ *  \sa SDL_RenderCaptureFrame()
+ */
+extern DECLSPEC int SDLCALL SDL_RenderGetCaptureStatus(SDL_Renderer * renderer);
+
+/**
+ *  \brief Load a frame written by SDL_RenderCaptureFrame().
+ *
+ *  \param src     The stream to read the capture from.
+ *  \param freesrc Non-zero to close the stream after reading.
+ *
+ *  \return The capture, or NULL on error
+ *
+ *  \sa SDL_RenderReplayCapture()
+ *  \sa SDL_FreeRenderCapture()
+ */
+extern DECLSPEC SDL_RenderCapture * SDLCALL SDL_LoadRenderCapture(SDL_RWops * src, int freesrc);
+
+/**
+ *  \brief Get the output size of the renderer a capture was recorded on.
+ *
+ *  \param capture The capture to query.
+ *  \param w       A pointer filled in with the width.
+ *  \param h       A pointer filled in with the height.
+ *
+ *  \return 0 on success, or -1 on error
+ */
+extern DECLSPEC int SDLCALL SDL_GetRenderCaptureSize(SDL_RenderCapture * capture, int *w, int *h);
+
+/**
+ *  \brief Draw a captured frame again.
+ *
+ *  The frame is queued and flushed exactly as recorded, but not presented.
+ *  Textures are created on the first replay and reused after that, so
+ *  replaying the same capture repeatedly measures only the drawing.
+ *
+ *  \param renderer The renderer to draw with.
+ *  \param capture  The capture to replay.
+ *
+ *  \return 0 on success, or -1 on error
+ */
+extern DECLSPEC int SDLCALL SDL_RenderReplayCapture(SDL_Renderer * renderer, SDL_RenderCapture * capture);
+
+/**
+ *  \brief Free a capture and any textures created to replay it.
+ *
+ *  \param capture The capture to free.
+ */
+extern DECLSPEC void SDLCALL SDL_FreeRenderCapture(SDL_RenderCapture * capture);
+
 
 /**
  *  \brief Bind the texture to the current OpenGL/ES/ES2 context for use with
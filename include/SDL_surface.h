@@ -148,6 +148,102 @@ extern DECLSPEC SDL_Surface *SDLCALL SDL_CreateRGBSurfaceWithFormatFrom
     (void *pixels, int width, int height, int depth, int pitch, Uint32 format);
 extern DECLSPEC void SDLCALL SDL_FreeSurface(SDL_Surface * surface);
 
+/**
+ *  \brief A cache of idle surfaces, kept by pixel format and size.
+ *
+ *  Code that needs a scratch surface every frame can borrow one from a pool
+ *  and return it afterwards, instead of creating and freeing it, so after the
+ *  first few frames it doesn't allocate at all. Returned surfaces keep their
+ *  blit mappings, so blitting them again doesn't have to find a blitter.
+ *
+ *  A pool is not thread-safe; use one per thread, or lock around it.
+ */
+struct SDL_SurfacePool;
+typedef struct SDL_SurfacePool SDL_SurfacePool;
+
+/**
+ *  \brief How well a surface pool is being reused.
+ */
+typedef struct SDL_SurfacePoolStats
+{
+    Uint32 hits;                /**< Borrows handed an idle surface */
+    Uint32 misses;              /**< Borrows that had to create a surface */
+    Uint32 returns;             /**< Surfaces kept for reuse when returned */
+    Uint32 discards;            /**< Surfaces freed when returned, or evicted to stay in budget */
+    int idle_surfaces;          /**< Surfaces waiting to be borrowed */
+    int idle_bytes;             /**< Pixel memory held by those surfaces */
+    float hit_rate;             /**< hits / (hits + misses), from 0.0 to 1.0 */
+} SDL_SurfacePoolStats;
+
+/**
+ *  \brief Create a surface pool.
+ *
+ *  \param max_bytes The most pixel memory the idle surfaces may hold, or 0
+ *                   for no limit. The surfaces borrowed least recently are
+ *                   freed first to stay under it.
+ *
+ *  \return The pool, or NULL on error.
+ *
+ *  \sa SDL_DestroySurfacePool()
+ */
+extern DECLSPEC SDL_SurfacePool * SDLCALL SDL_CreateSurfacePool(int max_bytes);
+
+/**
+ *  \brief Borrow a surface from a pool, creating it if none is idle.
+ *
+ *  The surface is set up like one from SDL_CreateRGBSurfaceWithFormat(),
+ *  except that its pixels, and the colors of its palette, are left as the
+ *  last borrower left them.
+ *
+ *  \param pool   The surface pool.
+ *  \param width  The width of the surface.
+ *  \param height The height of the surface.
+ *  \param format The pixel format of the surface.
+ *
+ *  \return The surface, or NULL on error.
+ *
+ *  \sa SDL_ReturnPoolSurface()
+ */
+extern DECLSPEC SDL_Surface * SDLCALL SDL_BorrowPoolSurface(SDL_SurfacePool * pool,
+                                                            int width, int height,
+                                                            Uint32 format);
+
+/**
+ *  \brief Give a surface to a pool for later borrowers.
+ *
+ *  This takes the place of SDL_FreeSurface(). The surface's color key,
+ *  modulation, blend mode, RLE flag, clipping rectangle and userdata are
+ *  reset, and it must not be used afterwards. Surfaces SDL didn't allocate
+ *  the pixels of, and any that don't fit in the pool's budget, are freed.
+ *
+ *  \param pool    The surface pool.
+ *  \param surface The surface, from SDL_BorrowPoolSurface() or any of the
+ *                 SDL_CreateRGBSurface() functions that allocate pixels.
+ */
+extern DECLSPEC void SDLCALL SDL_ReturnPoolSurface(SDL_SurfacePool * pool,
+                                                   SDL_Surface * surface);
+
+/**
+ *  \brief Get how many borrows a surface pool has served from idle surfaces.
+ *
+ *  \param pool  The surface pool.
+ *  \param stats A pointer filled in with the counts since the pool was made.
+ *
+ *  \return 0 on success, or -1 on error
+ */
+extern DECLSPEC int SDLCALL SDL_GetSurfacePoolStats(SDL_SurfacePool * pool,
+                                                    SDL_SurfacePoolStats * stats);
+
+/**
+ *  \brief Free a surface pool and its idle surfaces.
+ *
+ *  Surfaces still borrowed are not affected, and can be freed with
+ *  SDL_FreeSurface().
+ *
+ *  \param pool The surface pool.
+ */
+extern DECLSPEC void SDLCALL SDL_DestroySurfacePool(SDL_SurfacePool * pool);
+
 /**
  *  \brief Set the palette used by a surface.
  *
@@ -200,6 +296,37 @@ extern DECLSPEC SDL_Surface *SDLCALL SDL_LoadBMP_RW(SDL_RWops * src,
  */
 #define SDL_LoadBMP(file)   SDL_LoadBMP_RW(SDL_RWFromFile(file, "rb"), 1)
 
+/**
+ *  Load a surface from a seekable SDL data stream (memory or file), decoding
+ *  it straight into the given pixel format.
+ *
+ *  This reads the pixels in large blocks and converts each row into place,
+ *  instead of loading the image in its own format and converting it again
+ *  with SDL_ConvertSurfaceFormat(). Run-length encoded (BI_RLE8 and BI_RLE4)
+ *  images are decoded as well.
+ *
+ *  If \c format is 0 the image is loaded in its own format, as
+ *  SDL_LoadBMP_RW() does. Palette formats other than the image's own, and
+ *  FOURCC formats, are still converted after loading.
+ *
+ *  If \c freesrc is non-zero, the stream will be closed after being read.
+ *
+ *  The new surface should be freed with SDL_FreeSurface().
+ *
+ *  \return the new surface, or NULL if there was an error.
+ */
+extern DECLSPEC SDL_Surface *SDLCALL SDL_LoadBMP_RWFormat(SDL_RWops * src,
+                                                          int freesrc,
+                                                          Uint32 format);
+
+/**
+ *  Load a surface from a file, decoding it straight into the given format.
+ *
+ *  Convenience macro.
+ */
+#define SDL_LoadBMPFormat(file, format) \
+        SDL_LoadBMP_RWFormat(SDL_RWFromFile(file, "rb"), 1, format)
+
 /**
  *  Save a surface to a seekable SDL data stream (memory or file).
  *
@@ -224,6 +351,53 @@ extern DECLSPEC int SDLCALL SDL_SaveBMP_RW
 #define SDL_SaveBMP(surface, file) \
         SDL_SaveBMP_RW(surface, SDL_RWFromFile(file, "wb"), 1)
 
+/**
+ *  Save the RLE encoding of a surface to an SDL data stream (memory or file).
+ *
+ *  The surface has to be RLE encoded already, which happens the first time
+ *  it is blitted with RLE acceleration. The encoding is made for the format
+ *  of that blit's destination, along with the surface's colorkey, alpha
+ *  modulation and blend mode, and the surface is loaded with those.
+ *
+ *  If \c freedst is non-zero, the stream will be closed after being written.
+ *
+ *  \return 0 if successful or -1 if there was an error.
+ *
+ *  \sa SDL_LoadRLESurface_RW()
+ */
+extern DECLSPEC int SDLCALL SDL_SaveRLESurface_RW
+    (SDL_Surface * surface, SDL_RWops * dst, int freedst);
+
+/**
+ *  Save the RLE encoding of a surface to a file.
+ *
+ *  Convenience macro.
+ */
+#define SDL_SaveRLESurface(surface, file) \
+        SDL_SaveRLESurface_RW(surface, SDL_RWFromFile(file, "wb"), 1)
+
+/**
+ *  Load a surface saved with SDL_SaveRLESurface_RW() from an SDL data stream.
+ *
+ *  The surface comes back RLE encoded without any pixels, so blitting it to
+ *  a destination of the format it was encoded for doesn't encode it again.
+ *  Other destinations, or locking the surface, decode it first. The file
+ *  has to come from a machine with the same byte order.
+ *
+ *  If \c freesrc is non-zero, the stream will be closed after being read.
+ *
+ *  \return the new surface, or NULL if there was an error.
+ */
+extern DECLSPEC SDL_Surface *SDLCALL SDL_LoadRLESurface_RW(SDL_RWops * src,
+                                                          int freesrc);
+
+/**
+ *  Load a surface saved with SDL_SaveRLESurface_RW() from a file.
+ *
+ *  Convenience macro.
+ */
+#define SDL_LoadRLESurface(file)    SDL_LoadRLESurface_RW(SDL_RWFromFile(file, "rb"), 1)
+
 /**
  *  \brief Sets the RLE acceleration hint for a surface.
  *
@@ -353,6 +527,21 @@ extern DECLSPEC int SDLCALL SDL_SetSurfaceBlendMode(SDL_Surface * surface,
 extern DECLSPEC int SDLCALL SDL_GetSurfaceBlendMode(SDL_Surface * surface,
                                                     SDL_BlendMode *blendMode);
 
+/**
+ *  \brief Multiply the color of every pixel in a surface by its alpha.
+ *
+ *  \param surface The surface to convert.
+ *
+ *  \return 0 on success, or -1 if the surface is not valid.
+ *
+ *  The surface's blend mode is set to ::SDL_BLENDMODE_BLEND_PREMULTIPLIED,
+ *  which blends the converted pixels without multiplying them again. This
+ *  is meant to be done once, after the pixels are loaded.
+ *
+ *  \sa SDL_SetSurfaceBlendMode()
+ */
+extern DECLSPEC int SDLCALL SDL_PremultiplySurfaceAlpha(SDL_Surface * surface);
+
 /**
  *  Sets the clipping rectangle for the destination surface in a blit.
  *
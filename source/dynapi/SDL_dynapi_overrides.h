@@ -724,3 +724,30 @@
 #define SDL_RWwrite SDL_RWwrite_REAL
 #define SDL_RWclose SDL_RWclose_REAL
 #define SDL_LoadFile SDL_LoadFile_REAL
+#define SDL_RenderGetArenaInfo SDL_RenderGetArenaInfo_REAL
+#define SDL_RenderReserveArena SDL_RenderReserveArena_REAL
+#define SDL_RenderCopyBatch SDL_RenderCopyBatch_REAL
+#define SDL_RenderCopyExBatch SDL_RenderCopyExBatch_REAL
+#define SDL_CreateTextureAtlas SDL_CreateTextureAtlas_REAL
+#define SDL_AtlasAddSurface SDL_AtlasAddSurface_REAL
+#define SDL_AtlasRemove SDL_AtlasRemove_REAL
+#define SDL_AtlasDefragment SDL_AtlasDefragment_REAL
+#define SDL_GetAtlasInfo SDL_GetAtlasInfo_REAL
+#define SDL_DestroyTextureAtlas SDL_DestroyTextureAtlas_REAL
+#define SDL_RenderGetStats SDL_RenderGetStats_REAL
+#define SDL_RenderCaptureFrame SDL_RenderCaptureFrame_REAL
+#define SDL_LoadRenderCapture SDL_LoadRenderCapture_REAL
+#define SDL_GetRenderCaptureSize SDL_GetRenderCaptureSize_REAL
+#define SDL_RenderReplayCapture SDL_RenderReplayCapture_REAL
+#define SDL_FreeRenderCapture SDL_FreeRenderCapture_REAL
+#define SDL_PremultiplySurfaceAlpha SDL_PremultiplySurfaceAlpha_REAL
+#define SDL_SaveRLESurface_RW SDL_SaveRLESurface_RW_REAL
+#define SDL_LoadRLESurface_RW SDL_LoadRLESurface_RW_REAL
+#define SDL_LockTextureToSurface SDL_LockTextureToSurface_REAL
+#define SDL_CreateSurfacePool SDL_CreateSurfacePool_REAL
+#define SDL_BorrowPoolSurface SDL_BorrowPoolSurface_REAL
+#define SDL_ReturnPoolSurface SDL_ReturnPoolSurface_REAL
+#define SDL_GetSurfacePoolStats SDL_GetSurfacePoolStats_REAL
+#define SDL_DestroySurfacePool SDL_DestroySurfacePool_REAL
+#define SDL_LoadBMP_RWFormat SDL_LoadBMP_RWFormat_REAL
+#define SDL_RenderGetCaptureStatus SDL_RenderGetCaptureStatus_REAL
@@ -780,3 +780,30 @@ SDL_DYNAPI_PROC(size_t,SDL_RWread,(SDL_RWops *a, void *b, size_t c, size_t d),(a
 SDL_DYNAPI_PROC(size_t,SDL_RWwrite,(SDL_RWops *a, const void *b, size_t c, size_t d),(a,b,c,d),return)
 SDL_DYNAPI_PROC(int,SDL_RWclose,(SDL_RWops *a),(a),return)
 SDL_DYNAPI_PROC(void*,SDL_LoadFile,(const char *a, size_t *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_RenderGetArenaInfo,(SDL_Renderer *a, SDL_RenderArenaInfo *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_RenderReserveArena,(SDL_Renderer *a, int b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_RenderCopyBatch,(SDL_Renderer *a, SDL_Texture *b, const SDL_Rect *c, const SDL_FRect *d, int e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(int,SDL_RenderCopyExBatch,(SDL_Renderer *a, SDL_Texture *b, const SDL_Rect *c, const SDL_FRect *d, const double *e, const SDL_FPoint *f, const SDL_RendererFlip *g, int h),(a,b,c,d,e,f,g,h),return)
+SDL_DYNAPI_PROC(SDL_TextureAtlas*,SDL_CreateTextureAtlas,(SDL_Renderer *a, Uint32 b, int c, int d, int e, int f),(a,b,c,d,e,f),return)
+SDL_DYNAPI_PROC(SDL_AtlasEntry*,SDL_AtlasAddSurface,(SDL_TextureAtlas *a, SDL_Surface *b),(a,b),return)
+SDL_DYNAPI_PROC(void,SDL_AtlasRemove,(SDL_TextureAtlas *a, SDL_AtlasEntry *b),(a,b),)
+SDL_DYNAPI_PROC(int,SDL_AtlasDefragment,(SDL_TextureAtlas *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_GetAtlasInfo,(SDL_TextureAtlas *a, SDL_AtlasInfo *b),(a,b),return)
+SDL_DYNAPI_PROC(void,SDL_DestroyTextureAtlas,(SDL_TextureAtlas *a),(a),)
+SDL_DYNAPI_PROC(int,SDL_RenderGetStats,(SDL_Renderer *a, SDL_RenderStats *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_RenderCaptureFrame,(SDL_Renderer *a, SDL_RWops *b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_RenderCapture*,SDL_LoadRenderCapture,(SDL_RWops *a, int b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_GetRenderCaptureSize,(SDL_RenderCapture *a, int *b, int *c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_RenderReplayCapture,(SDL_Renderer *a, SDL_RenderCapture *b),(a,b),return)
+SDL_DYNAPI_PROC(void,SDL_FreeRenderCapture,(SDL_RenderCapture *a),(a),)
+SDL_DYNAPI_PROC(int,SDL_PremultiplySurfaceAlpha,(SDL_Surface *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_SaveRLESurface_RW,(SDL_Surface *a, SDL_RWops *b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(SDL_Surface*,SDL_LoadRLESurface_RW,(SDL_RWops *a, int b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_LockTextureToSurface,(SDL_Texture *a, const SDL_Rect *b, SDL_Surface **c),(a,b,c),return)
+SDL_DYNAPI_PROC(SDL_SurfacePool*,SDL_CreateSurfacePool,(int a),(a),return)
+SDL_DYNAPI_PROC(SDL_Surface*,SDL_BorrowPoolSurface,(SDL_SurfacePool *a, int b, int c, Uint32 d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(void,SDL_ReturnPoolSurface,(SDL_SurfacePool *a, SDL_Surface *b),(a,b),)
+SDL_DYNAPI_PROC(int,SDL_GetSurfacePoolStats,(SDL_SurfacePool *a, SDL_SurfacePoolStats *b),(a,b),return)
+SDL_DYNAPI_PROC(void,SDL_DestroySurfacePool,(SDL_SurfacePool *a),(a),)
+SDL_DYNAPI_PROC(SDL_Surface*,SDL_LoadBMP_RWFormat,(SDL_RWops *a, int b, Uint32 c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_RenderGetCaptureStatus,(SDL_Renderer *a),(a),return)
@@ -0,0 +1,801 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2019 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+/* Runtime texture atlas: packs small surfaces onto a few large textures */
+
+#include "SDL_render.h"
+
+/* Each page is packed with a skyline: the outline of the tops of everything placed so far,
+   stored left to right. Space given back by SDL_AtlasRemove() goes on a list of holes that
+   is checked first, and SDL_AtlasDefragment() repacks everything to get rid of them. */
+
+typedef struct SDL_AtlasSkyline
+{
+    int x, y, w;
+} SDL_AtlasSkyline;
+
+typedef struct SDL_AtlasPacker
+{
+    int w, h;
+    SDL_AtlasSkyline *nodes;
+    int num_nodes;
+    int max_nodes;
+    SDL_Rect *holes;
+    int num_holes;
+    int max_holes;
+    int hole_pixels;
+} SDL_AtlasPacker;
+
+typedef struct SDL_AtlasPage
+{
+    SDL_Texture *texture;
+    SDL_Surface *shadow;        /* CPU copy of the page, so it can be repacked */
+    SDL_AtlasPacker packer;
+    int num_entries;
+} SDL_AtlasPage;
+
+typedef struct SDL_AtlasItem
+{
+    SDL_AtlasEntry entry;       /* must be first, this is what the app gets */
+    int page;
+    struct SDL_AtlasItem *prev;
+    struct SDL_AtlasItem *next;
+} SDL_AtlasItem;
+
+struct SDL_TextureAtlas
+{
+    SDL_Renderer *renderer;
+    Uint32 format;
+    int page_w, page_h;
+    int padding;
+    int max_pages;
+    SDL_AtlasPage *pages;
+    int num_pages;
+    SDL_AtlasItem *items;
+    int num_items;
+};
+
+
+static int
+PackerInit(SDL_AtlasPacker *packer, int w, int h)
+{
+    SDL_zerop(packer);
+    packer->nodes = (SDL_AtlasSkyline *) SDL_malloc(16 * sizeof (SDL_AtlasSkyline));
+    if (!packer->nodes) {
+        return SDL_OutOfMemory();
+    }
+    packer->max_nodes = 16;
+    packer->num_nodes = 1;
+    packer->nodes[0].x = 0;
+    packer->nodes[0].y = 0;
+    packer->nodes[0].w = w;
+    packer->w = w;
+    packer->h = h;
+    return 0;
+}
+
+static void
+PackerQuit(SDL_AtlasPacker *packer)
+{
+    SDL_free(packer->nodes);
+    SDL_free(packer->holes);
+    SDL_zerop(packer);
+}
+
+static int
+PackerAddHole(SDL_AtlasPacker *packer, int x, int y, int w, int h)
+{
+    if (w <= 0 || h <= 0) {
+        return 0;
+    }
+    if (packer->num_holes == packer->max_holes) {
+        const int max_holes = packer->max_holes ? (packer->max_holes * 2) : 16;
+        SDL_Rect *holes = (SDL_Rect *) SDL_realloc(packer->holes, max_holes * sizeof (SDL_Rect));
+        if (!holes) {
+            return SDL_OutOfMemory();
+        }
+        packer->holes = holes;
+        packer->max_holes = max_holes;
+    }
+    packer->holes[packer->num_holes].x = x;
+    packer->holes[packer->num_holes].y = y;
+    packer->holes[packer->num_holes].w = w;
+    packer->holes[packer->num_holes].h = h;
+    packer->num_holes++;
+    return 0;
+}
+
+/* Takes the tightest hole that fits, and gives back what is left of it. */
+static SDL_bool
+PackerAllocHole(SDL_AtlasPacker *packer, int w, int h, SDL_Rect *rect)
+{
+    SDL_Rect hole;
+    int best = -1;
+    int best_area = 0;
+    int i;
+
+    for (i = 0; i < packer->num_holes; i++) {
+        const SDL_Rect *candidate = &packer->holes[i];
+        if (candidate->w >= w && candidate->h >= h) {
+            const int area = candidate->w * candidate->h;
+            if (best < 0 || area < best_area) {
+                best = i;
+                best_area = area;
+            }
+        }
+    }
+    if (best < 0) {
+        return SDL_FALSE;
+    }
+
+    hole = packer->holes[best];
+    packer->holes[best] = packer->holes[--packer->num_holes];
+    packer->hole_pixels -= w * h;
+
+    rect->x = hole.x;
+    rect->y = hole.y;
+    rect->w = w;
+    rect->h = h;
+
+    /* if there's no memory for the leftovers they're only lost until the next defragment. */
+    PackerAddHole(packer, hole.x + w, hole.y, hole.w - w, h);
+    PackerAddHole(packer, hole.x, hole.y + h, hole.w, hole.h - h);
+    return SDL_TRUE;
+}
+
+/* Returns how high a w*h rect would sit if its left edge is at node i, or -1 if it won't fit. */
+static int
+SkylineFit(const SDL_AtlasPacker *packer, int i, int w, int h)
+{
+    int y = 0;
+    int left = w;
+
+    if (packer->nodes[i].x + w > packer->w) {
+        return -1;
+    }
+    while (left > 0) {
+        y = SDL_max(y, packer->nodes[i].y);
+        if (y + h > packer->h) {
+            return -1;
+        }
+        left -= packer->nodes[i].w;
+        i++;
+    }
+    return y;
+}
+
+static SDL_bool
+PackerAllocSkyline(SDL_AtlasPacker *packer, int w, int h, SDL_Rect *rect)
+{
+    SDL_AtlasSkyline *nodes;
+    int best = -1;
+    int best_bottom = 0;
+    int best_w = 0;
+    int best_y = 0;
+    int i;
+
+    /* bottom-left rule: lowest resulting top edge, then the narrowest spot. */
+    for (i = 0; i < packer->num_nodes; i++) {
+        const int y = SkylineFit(packer, i, w, h);
+        if (y >= 0) {
+            if (best < 0 || (y + h) < best_bottom ||
+                ((y + h) == best_bottom && packer->nodes[i].w < best_w)) {
+                best = i;
+                best_bottom = y + h;
+                best_w = packer->nodes[i].w;
+                best_y = y;
+            }
+        }
+    }
+    if (best < 0) {
+        return SDL_FALSE;
+    }
+
+    if (packer->num_nodes == packer->max_nodes) {
+        nodes = (SDL_AtlasSkyline *) SDL_realloc(packer->nodes, packer->max_nodes * 2 * sizeof (SDL_AtlasSkyline));
+        if (!nodes) {
+            SDL_OutOfMemory();
+            return SDL_FALSE;
+        }
+        packer->nodes = nodes;
+        packer->max_nodes *= 2;
+    }
+    nodes = packer->nodes;
+
+    rect->x = nodes[best].x;
+    rect->y = best_y;
+    rect->w = w;
+    rect->h = h;
+
+    /* raise the skyline over the new rect... */
+    SDL_memmove(&nodes[best + 1], &nodes[best], (packer->num_nodes - best) * sizeof (SDL_AtlasSkyline));
+    nodes[best].x = rect->x;
+    nodes[best].y = best_bottom;
+    nodes[best].w = w;
+    packer->num_nodes++;
+
+    /* ...trim the nodes it covers... */
+    i = best + 1;
+    while (i < packer->num_nodes) {
+        const int right = nodes[i - 1].x + nodes[i - 1].w;
+        if (nodes[i].x >= right) {
+            break;
+        }
+        if (nodes[i].x + nodes[i].w <= right) {
+            SDL_memmove(&nodes[i], &nodes[i + 1], (packer->num_nodes - i - 1) * sizeof (SDL_AtlasSkyline));
+            packer->num_nodes--;
+        } else {
+            nodes[i].w -= right - nodes[i].x;
+            nodes[i].x = right;
+            break;
+        }
+    }
+
+    /* ...and merge neighbours at the same height. */
+    for (i = 0; i < packer->num_nodes - 1; ) {
+        if (nodes[i].y == nodes[i + 1].y) {
+            nodes[i].w += nodes[i + 1].w;
+            SDL_memmove(&nodes[i + 1], &nodes[i + 2], (packer->num_nodes - i - 2) * sizeof (SDL_AtlasSkyline));
+            packer->num_nodes--;
+        } else {
+            i++;
+        }
+    }
+    return SDL_TRUE;
+}
+
+static SDL_bool
+PackerAlloc(SDL_AtlasPacker *packer, int w, int h, SDL_Rect *rect)
+{
+    if (PackerAllocHole(packer, w, h, rect)) {
+        return SDL_TRUE;
+    }
+    return PackerAllocSkyline(packer, w, h, rect);
+}
+
+static SDL_AtlasPage *
+AddAtlasPage(SDL_TextureAtlas *atlas)
+{
+    SDL_AtlasPage *pages;
+    SDL_AtlasPage *page;
+
+    pages = (SDL_AtlasPage *) SDL_realloc(atlas->pages, (atlas->num_pages + 1) * sizeof (SDL_AtlasPage));
+    if (!pages) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    atlas->pages = pages;
+
+    page = &pages[atlas->num_pages];
+    SDL_zerop(page);
+    page->shadow = SDL_CreateRGBSurfaceWithFormat(0, atlas->page_w, atlas->page_h, 0, atlas->format);
+    if (!page->shadow) {
+        return NULL;
+    }
+    page->texture = SDL_CreateTexture(atlas->renderer, atlas->format, SDL_TEXTUREACCESS_STATIC, atlas->page_w, atlas->page_h);
+    if (!page->texture) {
+        SDL_FreeSurface(page->shadow);
+        return NULL;
+    }
+    /* the packer may run over the edge by the padding, since that part is never drawn. */
+    if (PackerInit(&page->packer, atlas->page_w + atlas->padding, atlas->page_h + atlas->padding) < 0) {
+        SDL_DestroyTexture(page->texture);
+        SDL_FreeSurface(page->shadow);
+        return NULL;
+    }
+
+    /* start from a clear page, so the padding between images is transparent. */
+    SDL_UpdateTexture(page->texture, NULL, page->shadow->pixels, page->shadow->pitch);
+
+    atlas->num_pages++;
+    return page;
+}
+
+static void
+FreeAtlasPage(SDL_AtlasPage *page)
+{
+    SDL_DestroyTexture(page->texture);
+    SDL_FreeSurface(page->shadow);
+    PackerQuit(&page->packer);
+}
+
+static Uint8 *
+GetShadowPixels(const SDL_Surface *shadow, int x, int y)
+{
+    return (Uint8 *) shadow->pixels + (y * shadow->pitch) + (x * shadow->format->BytesPerPixel);
+}
+
+static void
+CopyShadowRect(SDL_Surface *dst, int x, int y, const SDL_Surface *src, const SDL_Rect *rect)
+{
+    const Uint8 *srcpixels = GetShadowPixels(src, rect->x, rect->y);
+    Uint8 *dstpixels = GetShadowPixels(dst, x, y);
+    const size_t length = rect->w * dst->format->BytesPerPixel;
+    int row;
+
+    for (row = 0; row < rect->h; row++) {
+        SDL_memcpy(dstpixels, srcpixels, length);
+        srcpixels += src->pitch;
+        dstpixels += dst->pitch;
+    }
+}
+
+static void
+ClearShadowRect(SDL_Surface *shadow, const SDL_Rect *rect)
+{
+    Uint8 *pixels = GetShadowPixels(shadow, rect->x, rect->y);
+    const size_t length = rect->w * shadow->format->BytesPerPixel;
+    int row;
+
+    for (row = 0; row < rect->h; row++) {
+        SDL_memset(pixels, 0, length);
+        pixels += shadow->pitch;
+    }
+}
+
+/* The part of an allocation that is on the page: the image plus whatever padding fits. */
+static void
+GetPaddedRect(const SDL_TextureAtlas *atlas, const SDL_Rect *rect, SDL_Rect *padded)
+{
+    padded->x = rect->x;
+    padded->y = rect->y;
+    padded->w = SDL_min(rect->w + atlas->padding, atlas->page_w - rect->x);
+    padded->h = SDL_min(rect->h + atlas->padding, atlas->page_h - rect->y);
+}
+
+static int
+CopySurfaceToPage(SDL_TextureAtlas *atlas, SDL_AtlasPage *page, SDL_Surface *surface, const SDL_Rect *rect)
+{
+    SDL_Surface *converted = NULL;
+    SDL_Surface *src = surface;
+    SDL_Rect padded;
+    int retval;
+
+    /* colorkeys and palettes need a real conversion, anything else can go straight in. */
+    if (SDL_ISPIXELFORMAT_INDEXED(surface->format->format) || SDL_HasColorKey(surface)) {
+        converted = SDL_ConvertSurfaceFormat(surface, atlas->format, 0);
+        if (!converted) {
+            return -1;
+        }
+        src = converted;
+    }
+
+    if (SDL_LockSurface(src) < 0) {
+        SDL_FreeSurface(converted);
+        return -1;
+    }
+    retval = SDL_ConvertPixels(rect->w, rect->h, src->format->format, src->pixels, src->pitch,
+                               atlas->format, GetShadowPixels(page->shadow, rect->x, rect->y), page->shadow->pitch);
+    SDL_UnlockSurface(src);
+    SDL_FreeSurface(converted);
+    if (retval < 0) {
+        return retval;
+    }
+
+    /* send the padding along too, a hole can still have an old image's pixels in it. */
+    GetPaddedRect(atlas, rect, &padded);
+    return SDL_UpdateTexture(page->texture, &padded, GetShadowPixels(page->shadow, padded.x, padded.y), page->shadow->pitch);
+}
+
+static int
+GetReclaimablePixels(const SDL_TextureAtlas *atlas)
+{
+    int pixels = 0;
+    int i;
+    for (i = 0; i < atlas->num_pages; i++) {
+        pixels += atlas->pages[i].packer.hole_pixels;
+    }
+    return pixels;
+}
+
+static int
+FindAtlasSpace(SDL_TextureAtlas *atlas, int w, int h, SDL_Rect *rect)
+{
+    int i;
+    for (i = 0; i < atlas->num_pages; i++) {
+        if (PackerAlloc(&atlas->pages[i].packer, w, h, rect)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+SDL_TextureAtlas *
+SDL_CreateTextureAtlas(SDL_Renderer * renderer, Uint32 format, int page_w, int page_h, int padding, int max_pages)
+{
+    SDL_TextureAtlas *atlas;
+
+    if (!renderer) {
+        SDL_InvalidParamError("renderer");
+        return NULL;
+    }
+    if (page_w <= 0 || page_h <= 0) {
+        SDL_SetError("Texture atlas pages must be at least 1x1");
+        return NULL;
+    }
+    if (padding < 0) {
+        SDL_InvalidParamError("padding");
+        return NULL;
+    }
+    if (max_pages < 0) {
+        SDL_InvalidParamError("max_pages");
+        return NULL;
+    }
+    if (!format) {
+        format = SDL_PIXELFORMAT_ARGB8888;
+    }
+    if (SDL_ISPIXELFORMAT_INDEXED(format) || SDL_ISPIXELFORMAT_FOURCC(format)) {
+        SDL_SetError("Texture atlas pages need a packed pixel format");
+        return NULL;
+    }
+
+    atlas = (SDL_TextureAtlas *) SDL_calloc(1, sizeof (*atlas));
+    if (!atlas) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    atlas->renderer = renderer;
+    atlas->format = format;
+    atlas->page_w = page_w;
+    atlas->page_h = page_h;
+    atlas->padding = padding;
+    atlas->max_pages = max_pages;
+    return atlas;
+}
+
+SDL_AtlasEntry *
+SDL_AtlasAddSurface(SDL_TextureAtlas * atlas, SDL_Surface * surface)
+{
+    SDL_AtlasItem *item;
+    SDL_AtlasPage *page;
+    SDL_Rect rect;
+    int w, h;
+    int index;
+
+    if (!atlas) {
+        SDL_InvalidParamError("atlas");
+        return NULL;
+    }
+    if (!surface) {
+        SDL_InvalidParamError("surface");
+        return NULL;
+    }
+    if (surface->w <= 0 || surface->h <= 0) {
+        SDL_SetError("Can't add an empty surface to a texture atlas");
+        return NULL;
+    }
+    if (surface->w > atlas->page_w || surface->h > atlas->page_h) {
+        SDL_SetError("Surface is larger than a texture atlas page");
+        return NULL;
+    }
+
+    item = (SDL_AtlasItem *) SDL_calloc(1, sizeof (*item));
+    if (!item) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    w = surface->w + atlas->padding;
+    h = surface->h + atlas->padding;
+
+    index = FindAtlasSpace(atlas, w, h, &rect);
+    if (index < 0 && GetReclaimablePixels(atlas) >= (w * h)) {
+        /* there might be enough room once the holes are squeezed out. */
+        if (SDL_AtlasDefragment(atlas) == 0) {
+            index = FindAtlasSpace(atlas, w, h, &rect);
+        }
+    }
+    if (index < 0) {
+        if (atlas->max_pages && atlas->num_pages >= atlas->max_pages) {
+            SDL_free(item);
+            SDL_SetError("Texture atlas is full");
+            return NULL;
+        }
+        if (!AddAtlasPage(atlas)) {
+            SDL_free(item);
+            return NULL;
+        }
+        index = atlas->num_pages - 1;
+        if (!PackerAlloc(&atlas->pages[index].packer, w, h, &rect)) {
+            SDL_free(item);
+            return NULL;
+        }
+    }
+
+    page = &atlas->pages[index];
+    rect.w = surface->w;
+    rect.h = surface->h;
+    if (CopySurfaceToPage(atlas, page, surface, &rect) < 0) {
+        if (PackerAddHole(&page->packer, rect.x, rect.y, w, h) == 0) {
+            page->packer.hole_pixels += w * h;
+        }
+        SDL_free(item);
+        return NULL;
+    }
+
+    item->entry.texture = page->texture;
+    item->entry.rect = rect;
+    item->page = index;
+    item->next = atlas->items;
+    if (atlas->items) {
+        atlas->items->prev = item;
+    }
+    atlas->items = item;
+    atlas->num_items++;
+    page->num_entries++;
+
+    return &item->entry;
+}
+
+void
+SDL_AtlasRemove(SDL_TextureAtlas * atlas, SDL_AtlasEntry * entry)
+{
+    SDL_AtlasItem *item = (SDL_AtlasItem *) entry;
+    SDL_AtlasPage *page;
+    SDL_Rect padded;
+
+    if (!atlas || !entry) {
+        return;
+    }
+
+    page = &atlas->pages[item->page];
+
+    /* clear it on the CPU copy only; whatever lands here next uploads over it. */
+    GetPaddedRect(atlas, &entry->rect, &padded);
+    ClearShadowRect(page->shadow, &padded);
+    if (PackerAddHole(&page->packer, entry->rect.x, entry->rect.y,
+                      entry->rect.w + atlas->padding, entry->rect.h + atlas->padding) == 0) {
+        page->packer.hole_pixels += (entry->rect.w + atlas->padding) * (entry->rect.h + atlas->padding);
+    }
+    page->num_entries--;
+
+    if (item->prev) {
+        item->prev->next = item->next;
+    } else {
+        atlas->items = item->next;
+    }
+    if (item->next) {
+        item->next->prev = item->prev;
+    }
+    atlas->num_items--;
+    SDL_free(item);
+}
+
+static int SDLCALL
+CompareItemsBySize(const void *a, const void *b)
+{
+    const SDL_AtlasItem *A = *(const SDL_AtlasItem **) a;
+    const SDL_AtlasItem *B = *(const SDL_AtlasItem **) b;
+
+    /* tallest first packs a skyline best. */
+    if (A->entry.rect.h != B->entry.rect.h) {
+        return B->entry.rect.h - A->entry.rect.h;
+    }
+    return B->entry.rect.w - A->entry.rect.w;
+}
+
+int
+SDL_AtlasDefragment(SDL_TextureAtlas * atlas)
+{
+    SDL_AtlasItem **items = NULL;
+    SDL_Rect *rects = NULL;
+    int *indices = NULL;
+    SDL_AtlasPacker *packers = NULL;
+    SDL_Surface **shadows = NULL;
+    SDL_Texture **textures = NULL;
+    SDL_AtlasItem *item;
+    int num_packers = 0;
+    int num_pages;
+    int i, j;
+    int retval = -1;
+
+    if (!atlas) {
+        return SDL_InvalidParamError("atlas");
+    }
+
+    /* Plan the new layout first, so nothing changes unless all of it works out. */
+    num_pages = SDL_max(atlas->num_pages, 1);
+    items = (SDL_AtlasItem **) SDL_malloc(SDL_max(atlas->num_items, 1) * sizeof (*items));
+    rects = (SDL_Rect *) SDL_malloc(SDL_max(atlas->num_items, 1) * sizeof (*rects));
+    indices = (int *) SDL_malloc(SDL_max(atlas->num_items, 1) * sizeof (*indices));
+    packers = (SDL_AtlasPacker *) SDL_calloc(num_pages, sizeof (*packers));
+    if (!items || !rects || !indices || !packers) {
+        SDL_OutOfMemory();
+        goto done;
+    }
+
+    for (i = 0, item = atlas->items; item; item = item->next) {
+        items[i++] = item;
+    }
+    SDL_qsort(items, atlas->num_items, sizeof (*items), CompareItemsBySize);
+
+    for (i = 0; i < atlas->num_items; i++) {
+        const int w = items[i]->entry.rect.w + atlas->padding;
+        const int h = items[i]->entry.rect.h + atlas->padding;
+        for (j = 0; j < num_packers; j++) {
+            if (PackerAlloc(&packers[j], w, h, &rects[i])) {
+                break;
+            }
+        }
+        if (j == num_packers) {
+            if (atlas->max_pages && num_packers >= atlas->max_pages) {
+                SDL_SetError("Texture atlas contents don't fit after repacking");
+                goto done;
+            }
+            if (num_packers == num_pages) {
+                SDL_AtlasPacker *grown = (SDL_AtlasPacker *) SDL_realloc(packers, (num_pages * 2) * sizeof (*packers));
+                if (!grown) {
+                    SDL_OutOfMemory();
+                    goto done;
+                }
+                packers = grown;
+                SDL_memset(&packers[num_pages], 0, num_pages * sizeof (*packers));
+                num_pages *= 2;
+            }
+            if (PackerInit(&packers[num_packers], atlas->page_w + atlas->padding, atlas->page_h + atlas->padding) < 0) {
+                goto done;
+            }
+            num_packers++;
+            if (!PackerAlloc(&packers[j], w, h, &rects[i])) {
+                goto done;
+            }
+        }
+        rects[i].w = items[i]->entry.rect.w;
+        rects[i].h = items[i]->entry.rect.h;
+        indices[i] = j;
+    }
+
+    /* Now everything the new layout needs, while the old one is still intact. */
+    if (num_packers > atlas->num_pages) {
+        SDL_AtlasPage *pages = (SDL_AtlasPage *) SDL_realloc(atlas->pages, num_packers * sizeof (SDL_AtlasPage));
+        if (!pages) {
+            SDL_OutOfMemory();
+            goto done;
+        }
+        atlas->pages = pages;
+    }
+    shadows = (SDL_Surface **) SDL_calloc(SDL_max(num_packers, 1), sizeof (*shadows));
+    textures = (SDL_Texture **) SDL_calloc(SDL_max(num_packers, 1), sizeof (*textures));
+    if (!shadows || !textures) {
+        SDL_OutOfMemory();
+        goto done;
+    }
+    for (j = 0; j < num_packers; j++) {
+        shadows[j] = SDL_CreateRGBSurfaceWithFormat(0, atlas->page_w, atlas->page_h, 0, atlas->format);
+        if (!shadows[j]) {
+            goto done;
+        }
+        if (j < atlas->num_pages) {
+            textures[j] = atlas->pages[j].texture;
+        } else {
+            textures[j] = SDL_CreateTexture(atlas->renderer, atlas->format, SDL_TEXTUREACCESS_STATIC, atlas->page_w, atlas->page_h);
+            if (!textures[j]) {
+                goto done;
+            }
+        }
+    }
+
+    for (i = 0; i < atlas->num_items; i++) {
+        CopyShadowRect(shadows[indices[i]], rects[i].x, rects[i].y, atlas->pages[items[i]->page].shadow, &items[i]->entry.rect);
+    }
+
+    /* Commit: pages past the new layout are empty now and get freed. */
+    for (j = num_packers; j < atlas->num_pages; j++) {
+        FreeAtlasPage(&atlas->pages[j]);
+    }
+    for (j = 0; j < num_packers; j++) {
+        SDL_AtlasPage *page = &atlas->pages[j];
+        if (j < atlas->num_pages) {
+            SDL_FreeSurface(page->shadow);
+            PackerQuit(&page->packer);
+        }
+        page->texture = textures[j];
+        page->shadow = shadows[j];
+        page->packer = packers[j];
+        page->num_entries = 0;
+        shadows[j] = NULL;
+        textures[j] = NULL;
+        SDL_UpdateTexture(page->texture, NULL, page->shadow->pixels, page->shadow->pitch);
+    }
+    atlas->num_pages = num_packers;
+    num_packers = 0;  /* they belong to the pages now. */
+
+    for (i = 0; i < atlas->num_items; i++) {
+        SDL_AtlasPage *page = &atlas->pages[indices[i]];
+        items[i]->page = indices[i];
+        items[i]->entry.texture = page->texture;
+        items[i]->entry.rect = rects[i];
+        page->num_entries++;
+    }
+    retval = 0;
+
+done:
+    if (retval < 0) {
+        for (j = 0; j < num_packers; j++) {
+            PackerQuit(&packers[j]);
+            if (shadows) {
+                SDL_FreeSurface(shadows[j]);
+            }
+            if (textures && j >= atlas->num_pages) {
+                SDL_DestroyTexture(textures[j]);
+            }
+        }
+    }
+    SDL_free(textures);
+    SDL_free(shadows);
+    SDL_free(packers);
+    SDL_free(indices);
+    SDL_free(rects);
+    SDL_free(items);
+    return retval;
+}
+
+int
+SDL_GetAtlasInfo(SDL_TextureAtlas * atlas, SDL_AtlasInfo * info)
+{
+    const SDL_AtlasItem *item;
+
+    if (!atlas) {
+        return SDL_InvalidParamError("atlas");
+    }
+    if (!info) {
+        return SDL_InvalidParamError("info");
+    }
+
+    SDL_zerop(info);
+    info->pages = atlas->num_pages;
+    info->entries = atlas->num_items;
+    info->total_pixels = atlas->num_pages * atlas->page_w * atlas->page_h;
+    for (item = atlas->items; item; item = item->next) {
+        info->used_pixels += item->entry.rect.w * item->entry.rect.h;
+    }
+    info->reclaimable_pixels = GetReclaimablePixels(atlas);
+    if (info->total_pixels > 0) {
+        info->efficiency = (float) info->used_pixels / (float) info->total_pixels;
+    }
+    return 0;
+}
+
+void
+SDL_DestroyTextureAtlas(SDL_TextureAtlas * atlas)
+{
+    SDL_AtlasItem *item;
+    int i;
+
+    if (!atlas) {
+        return;
+    }
+
+    item = atlas->items;
+    while (item) {
+        SDL_AtlasItem *next = item->next;
+        SDL_free(item);
+        item = next;
+    }
+    for (i = 0; i < atlas->num_pages; i++) {
+        FreeAtlasPage(&atlas->pages[i]);
+    }
+    SDL_free(atlas->pages);
+    SDL_free(atlas);
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -27,6 +27,7 @@
 #include "SDL_log.h"
 #include "SDL_render.h"
 #include "SDL_sysrender.h"
+#include "SDL_rendercapture_c.h"
 #include "software/SDL_render_sw_c.h"
 
 #if defined(__ANDROID__)
@@ -67,6 +68,10 @@
     SDL_COMPOSE_BLENDMODE(SDL_BLENDFACTOR_SRC_ALPHA, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD, \
                           SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD)
 
+#define SDL_BLENDMODE_BLEND_PREMULTIPLIED_FULL \
+    SDL_COMPOSE_BLENDMODE(SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD, \
+                          SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD)
+
 #define SDL_BLENDMODE_ADD_FULL \
     SDL_COMPOSE_BLENDMODE(SDL_BLENDFACTOR_SRC_ALPHA, SDL_BLENDFACTOR_ONE, SDL_BLENDOPERATION_ADD, \
                           SDL_BLENDFACTOR_ZERO, SDL_BLENDFACTOR_ONE, SDL_BLENDOPERATION_ADD)
@@ -199,11 +204,91 @@ DebugLogRenderCommands(const SDL_RenderCommand *cmd)
 #endif
 }
 
+static void
+ResetRenderArena(SDL_Renderer *renderer)
+{
+    /* Rewind the frame arena so the commands and vertex space get reused next time.
+       Only the first block is touched here; later blocks are reset as they're reached. */
+    if (renderer->render_commands_queued > renderer->render_commands_high_water) {
+        renderer->render_commands_high_water = renderer->render_commands_queued;
+    }
+    if (renderer->vertex_data_used > renderer->vertex_data_high_water) {
+        renderer->vertex_data_high_water = renderer->vertex_data_used;
+    }
+
+    renderer->render_command_block = renderer->render_command_blocks;
+    if (renderer->render_command_block) {
+        renderer->render_command_block->used = 0;
+    }
+    renderer->render_commands = NULL;
+    renderer->render_commands_tail = NULL;
+    renderer->render_commands_queued = 0;
+    renderer->vertex_data_used = 0;
+}
+
+static void
+UpdateRenderStats(SDL_Renderer *renderer, const SDL_RenderFlushReason reason)
+{
+    SDL_RenderStats *stats = &renderer->stats;
+    const SDL_RenderCommand *cmd;
+
+    stats->flushes++;
+    stats->flush_reasons[reason]++;
+    stats->vertex_bytes += (int) renderer->vertex_data_used;
+
+    for (cmd = renderer->render_commands; cmd; cmd = cmd->next) {
+        switch (cmd->command) {
+            case SDL_RENDERCMD_NO_OP:
+                continue;
+            case SDL_RENDERCMD_SETVIEWPORT:
+                stats->viewport_commands++;
+                continue;
+            case SDL_RENDERCMD_SETCLIPRECT:
+                stats->cliprect_commands++;
+                continue;
+            case SDL_RENDERCMD_SETDRAWCOLOR:
+                stats->draw_color_commands++;
+                continue;
+            case SDL_RENDERCMD_CLEAR:
+                stats->clear_commands++;
+                continue;
+            case SDL_RENDERCMD_DRAW_POINTS:
+                stats->point_commands++;
+                break;
+            case SDL_RENDERCMD_DRAW_LINES:
+                stats->line_commands++;
+                break;
+            case SDL_RENDERCMD_FILL_RECTS:
+                stats->fill_commands++;
+                break;
+            case SDL_RENDERCMD_COPY:
+                stats->copy_commands++;
+                stats->sprites += (int) cmd->data.draw.count;
+                break;
+            case SDL_RENDERCMD_COPY_EX:
+                stats->copy_ex_commands++;
+                stats->sprites += (int) cmd->data.draw.count;
+                break;
+        }
+
+        /* only draws get here; compare against the previous draw, even across flushes. */
+        if (!renderer->stats_drawn || (cmd->data.draw.texture != renderer->stats_texture)) {
+            if (cmd->data.draw.texture) {
+                stats->texture_binds++;
+            }
+            renderer->stats_texture = cmd->data.draw.texture;
+        }
+        if (!renderer->stats_drawn || (cmd->data.draw.blend != renderer->stats_blend)) {
+            stats->blend_changes++;
+            renderer->stats_blend = cmd->data.draw.blend;
+        }
+        renderer->stats_drawn = SDL_TRUE;
+    }
+}
+
 static int
-FlushRenderCommands(SDL_Renderer *renderer)
+FlushRenderCommands(SDL_Renderer *renderer, const SDL_RenderFlushReason reason)
 {
-    SDL_AllocVertGap *prevgap = &renderer->vertex_data_gaps;
-    SDL_AllocVertGap *gap = prevgap;
     int retval;
 
     SDL_assert((renderer->render_commands == NULL) == (renderer->render_commands_tail == NULL));
@@ -214,25 +299,15 @@ FlushRenderCommands(SDL_Renderer *renderer)
     }
 
     DebugLogRenderCommands(renderer->render_commands);
+    UpdateRenderStats(renderer, reason);
+    if (renderer->capture) {
+        SDL_CaptureFlush(renderer);
+    }
 
     retval = renderer->RunCommandQueue(renderer, renderer->render_commands, renderer->vertex_data, renderer->vertex_data_used);
 
-    while (gap) {
-        prevgap = gap;
-        gap = gap->next;
-    }
-    prevgap->next = renderer->vertex_data_gaps_pool;
-    renderer->vertex_data_gaps_pool = renderer->vertex_data_gaps.next;
-    renderer->vertex_data_gaps.next = NULL;
+    ResetRenderArena(renderer);
 
-    /* Move the whole render command queue to the unused pool so we can reuse them next time. */
-    if (renderer->render_commands_tail != NULL) {
-        renderer->render_commands_tail->next = renderer->render_commands_pool;
-        renderer->render_commands_pool = renderer->render_commands;
-        renderer->render_commands_tail = NULL;
-        renderer->render_commands = NULL;
-    }
-    renderer->vertex_data_used = 0;
     renderer->render_command_generation++;
     renderer->color_queued = SDL_FALSE;
     renderer->viewport_queued = SDL_FALSE;
@@ -246,7 +321,7 @@ FlushRenderCommandsIfTextureNeeded(SDL_Texture *texture)
     SDL_Renderer *renderer = texture->renderer;
     if (texture->last_command_generation == renderer->render_command_generation) {
         /* the current command queue depends on this texture, flush the queue now before it changes */
-        return FlushRenderCommands(renderer);
+        return FlushRenderCommands(renderer, SDL_RENDER_FLUSH_TEXTURE_UPDATE);
     }
     return 0;
 }
@@ -254,137 +329,114 @@ FlushRenderCommandsIfTextureNeeded(SDL_Texture *texture)
 static SDL_INLINE int
 FlushRenderCommandsIfNotBatching(SDL_Renderer *renderer)
 {
-    return renderer->batching ? 0 : FlushRenderCommands(renderer);
+    return renderer->batching ? 0 : FlushRenderCommands(renderer, SDL_RENDER_FLUSH_NOT_BATCHING);
 }
 
 int
 SDL_RenderFlush(SDL_Renderer * renderer)
 {
-    return FlushRenderCommands(renderer);
-}
-
-static SDL_AllocVertGap *
-AllocateVertexGap(SDL_Renderer *renderer)
-{
-    SDL_AllocVertGap *retval = renderer->vertex_data_gaps_pool;
-    if (retval) {
-        renderer->vertex_data_gaps_pool = retval->next;
-        retval->next = NULL;
-    } else {
-        retval = (SDL_AllocVertGap *) SDL_malloc(sizeof (SDL_AllocVertGap));
-        if (!retval) {
-            SDL_OutOfMemory();
-        }
-    }
-    return retval;
+    return FlushRenderCommands(renderer, SDL_RENDER_FLUSH_EXPLICIT);
 }
 
-
-void *
-SDL_AllocateRenderVertices(SDL_Renderer *renderer, const size_t numbytes, const size_t alignment, size_t *offset)
+static SDL_bool
+GrowRenderVertices(SDL_Renderer *renderer, const size_t needed)
 {
-    const size_t needed = renderer->vertex_data_used + numbytes + alignment;
-    size_t aligner, aligned;
-    void *retval;
-
-    SDL_AllocVertGap *prevgap = &renderer->vertex_data_gaps;
-    SDL_AllocVertGap *gap = prevgap->next;
-    while (gap) {
-        const size_t gapoffset = gap->offset;
-        aligner = (alignment && ((gap->offset % alignment) != 0)) ? (alignment - (gap->offset % alignment)) : 0;
-        aligned = gapoffset + aligner;
-
-        /* Can we use this gap? */
-        if ((aligner < gap->len) && ((gap->len - aligner) >= numbytes)) {
-            /* we either finished this gap off, trimmed the left, trimmed the right, or split it into two gaps. */
-            if (gap->len == numbytes) {  /* finished it off, remove it */
-                SDL_assert(aligned == gapoffset);
-                prevgap->next = gap->next;
-                gap->next = renderer->vertex_data_gaps_pool;
-                renderer->vertex_data_gaps_pool = gap;
-            } else if (aligned == gapoffset) {  /* trimmed the left */
-                gap->offset += numbytes;
-                gap->len -= numbytes;
-            } else if (((aligned - gapoffset) + numbytes) == gap->len) {  /* trimmed the right */
-                gap->len -= numbytes;
-            } else {  /* split into two gaps */
-                SDL_AllocVertGap *newgap = AllocateVertexGap(renderer);
-                if (!newgap) {
-                    return NULL;
-                }
-                newgap->offset = aligned + numbytes;
-                newgap->len = gap->len - (aligner + numbytes);
-                newgap->next = gap->next;
-                // gap->offset doesn't change.
-                gap->len = aligner;
-                gap->next = newgap;
-            }
-
-            if (offset) {
-                *offset = aligned;
-            }
-            return ((Uint8 *) renderer->vertex_data) + aligned;
-        }
-
-        /* Try the next gap */
-        prevgap = gap;
-        gap = gap->next;
-    }
-
-    /* no gaps with enough space; get a new piece of the vertex buffer */
     while (needed > renderer->vertex_data_allocation) {
         const size_t current_allocation = renderer->vertex_data ? renderer->vertex_data_allocation : 1024;
         const size_t newsize = current_allocation * 2;
         void *ptr = SDL_realloc(renderer->vertex_data, newsize);
         if (ptr == NULL) {
             SDL_OutOfMemory();
-            return NULL;
+            return SDL_FALSE;
         }
         renderer->vertex_data = ptr;
         renderer->vertex_data_allocation = newsize;
     }
+    return SDL_TRUE;
+}
 
-    aligner = (alignment && ((renderer->vertex_data_used % alignment) != 0)) ? (alignment - (renderer->vertex_data_used % alignment)) : 0;
-    aligned = renderer->vertex_data_used + aligner;
+void *
+SDL_AllocateRenderVertices(SDL_Renderer *renderer, const size_t numbytes, const size_t alignment, size_t *offset)
+{
+    /* The vertex buffer is a linear arena: it only grows until it covers the busiest batch,
+       and any alignment padding is simply skipped until the next flush rewinds it. */
+    const size_t aligner = (alignment && ((renderer->vertex_data_used % alignment) != 0)) ? (alignment - (renderer->vertex_data_used % alignment)) : 0;
+    const size_t aligned = renderer->vertex_data_used + aligner;
+
+    if (!GrowRenderVertices(renderer, aligned + numbytes)) {
+        return NULL;
+    }
 
-    retval = ((Uint8 *) renderer->vertex_data) + aligned;
     if (offset) {
         *offset = aligned;
     }
 
-    if (aligner) {  /* made a new gap... */
-        SDL_AllocVertGap *newgap = AllocateVertexGap(renderer);
-        if (newgap) {  /* just let it slide as lost space if malloc fails. */
-            newgap->offset = renderer->vertex_data_used;
-            newgap->len = aligner;
-            newgap->next = NULL;
-            prevgap->next = newgap;
-        }
-    }
+    renderer->vertex_data_used = aligned + numbytes;
 
-    renderer->vertex_data_used += aligner + numbytes;
+    return ((Uint8 *) renderer->vertex_data) + aligned;
+}
 
-    return retval;
+static SDL_RenderCommandBlock *
+AllocateRenderCommandBlock(const size_t capacity)
+{
+    SDL_RenderCommandBlock *block;
+
+    /* the commands live right after the header, so a block is a single allocation. */
+    block = (SDL_RenderCommandBlock *) SDL_malloc(sizeof (*block) + (capacity * sizeof (SDL_RenderCommand)));
+    if (!block) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    block->commands = (SDL_RenderCommand *) (block + 1);
+    block->capacity = capacity;
+    block->used = 0;
+    block->next = NULL;
+    return block;
+}
+
+static void
+FreeRenderCommandBlocks(SDL_Renderer *renderer)
+{
+    SDL_RenderCommandBlock *block = renderer->render_command_blocks;
+    while (block) {
+        SDL_RenderCommandBlock *next = block->next;
+        SDL_free(block);
+        block = next;
+    }
+    renderer->render_command_blocks = NULL;
+    renderer->render_command_block = NULL;
 }
 
 static SDL_RenderCommand *
 AllocateRenderCommand(SDL_Renderer *renderer)
 {
+    SDL_RenderCommandBlock *block = renderer->render_command_block;
     SDL_RenderCommand *retval = NULL;
 
     /* !!! FIXME: are there threading limitations in SDL's render API? If not, we need to mutex this. */
-    retval = renderer->render_commands_pool;
-    if (retval != NULL) {
-        renderer->render_commands_pool = retval->next;
-        retval->next = NULL;
-    } else {
-        retval = SDL_calloc(1, sizeof (*retval));
-        if (!retval) {
-            SDL_OutOfMemory();
-            return NULL;
+    if (!block || (block->used == block->capacity)) {
+        SDL_RenderCommandBlock *next = block ? block->next : renderer->render_command_blocks;
+        if (next) {
+            next->used = 0;
+        } else {
+            /* Still warming up; each new block doubles the arena. */
+            next = AllocateRenderCommandBlock(block ? (block->capacity * 2) : 64);
+            if (!next) {
+                return NULL;
+            }
+            if (block) {
+                block->next = next;
+            } else {
+                renderer->render_command_blocks = next;
+            }
         }
+        block = renderer->render_command_block = next;
     }
 
+    retval = &block->commands[block->used++];
+    SDL_zerop(retval);
+    renderer->render_commands_queued++;
+
     SDL_assert((renderer->render_commands == NULL) == (renderer->render_commands_tail == NULL));
     if (renderer->render_commands_tail != NULL) {
         renderer->render_commands_tail->next = retval;
@@ -396,6 +448,141 @@ AllocateRenderCommand(SDL_Renderer *renderer)
     return retval;
 }
 
+static void
+DiscardLastRenderCommand(SDL_Renderer *renderer, SDL_RenderCommand *prev)
+{
+    /* Only the command AllocateRenderCommand() just handed out can be given back. */
+    SDL_assert(renderer->render_command_block && (renderer->render_command_block->used > 0));
+    SDL_assert(prev && (prev->next == renderer->render_commands_tail));
+    SDL_assert(renderer->render_commands_tail == &renderer->render_command_block->commands[renderer->render_command_block->used - 1]);
+
+    renderer->render_command_block->used--;
+    renderer->render_commands_queued--;
+    prev->next = NULL;
+    renderer->render_commands_tail = prev;
+}
+
+static size_t
+GetRenderCommandCapacity(const SDL_Renderer *renderer)
+{
+    const SDL_RenderCommandBlock *block;
+    size_t capacity = 0;
+    for (block = renderer->render_command_blocks; block; block = block->next) {
+        capacity += block->capacity;
+    }
+    return capacity;
+}
+
+int
+SDL_RenderGetArenaInfo(SDL_Renderer * renderer, SDL_RenderArenaInfo * info)
+{
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (!info) {
+        return SDL_InvalidParamError("info");
+    }
+
+    info->commands_queued = (int) renderer->render_commands_queued;
+    info->commands_capacity = (int) GetRenderCommandCapacity(renderer);
+    info->commands_high_water = (int) SDL_max(renderer->render_commands_high_water, renderer->render_commands_queued);
+    info->vertex_bytes_queued = (int) renderer->vertex_data_used;
+    info->vertex_bytes_capacity = (int) renderer->vertex_data_allocation;
+    info->vertex_bytes_high_water = (int) SDL_max(renderer->vertex_data_high_water, renderer->vertex_data_used);
+    return 0;
+}
+
+int
+SDL_RenderReserveArena(SDL_Renderer * renderer, int commands, int vertex_bytes)
+{
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (commands < 0) {
+        return SDL_InvalidParamError("commands");
+    }
+    if (vertex_bytes < 0) {
+        return SDL_InvalidParamError("vertex_bytes");
+    }
+
+    /* The arena can only be reshaped while nothing in it is in use. */
+    if (FlushRenderCommands(renderer, SDL_RENDER_FLUSH_OTHER) < 0) {
+        return -1;
+    }
+
+    if ((size_t) commands > GetRenderCommandCapacity(renderer)) {
+        /* Replace the blocks with a single one, so the whole batch is contiguous. */
+        SDL_RenderCommandBlock *block = AllocateRenderCommandBlock((size_t) commands);
+        if (!block) {
+            return -1;
+        }
+        FreeRenderCommandBlocks(renderer);
+        renderer->render_command_blocks = renderer->render_command_block = block;
+    }
+
+    if (!GrowRenderVertices(renderer, (size_t) vertex_bytes)) {
+        return -1;
+    }
+    return 0;
+}
+
+int
+SDL_RenderCaptureFrame(SDL_Renderer * renderer, SDL_RWops * dst)
+{
+    int w, h;
+
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (!dst) {
+        return SDL_InvalidParamError("dst");
+    }
+    if (renderer->capture) {
+        return SDL_SetError("A frame is already being captured");
+    }
+    if (SDL_GetRendererOutputSize(renderer, &w, &h) < 0) {
+        return -1;
+    }
+
+    /* start from an empty queue, so the first draw records the full state */
+    if (FlushRenderCommands(renderer, SDL_RENDER_FLUSH_OTHER) < 0) {
+        return -1;
+    }
+    renderer->color_queued = SDL_FALSE;
+    renderer->viewport_queued = SDL_FALSE;
+    renderer->cliprect_queued = SDL_FALSE;
+
+    if (SDL_CaptureBegin(renderer, dst, w, h) < 0) {
+        return -1;
+    }
+    renderer->capture_status = 0;
+    return 0;
+}
+
+int
+SDL_RenderGetCaptureStatus(SDL_Renderer * renderer)
+{
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (renderer->capture) {
+        return 1;
+    }
+    if (renderer->capture_status < 0) {
+        return SDL_SetError("Couldn't write the whole render capture");
+    }
+    return 0;
+}
+
+int
+SDL_RenderGetStats(SDL_Renderer * renderer, SDL_RenderStats * stats)
+{
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+
+    SDL_memcpy(stats, &renderer->last_stats, sizeof (*stats));
+    return 0;
+}
+
 static int
 QueueCmdSetViewport(SDL_Renderer *renderer)
 {
@@ -413,6 +600,9 @@ QueueCmdSetViewport(SDL_Renderer *renderer)
             } else {
                 SDL_memcpy(&renderer->last_queued_viewport, &renderer->viewport, sizeof (SDL_Rect));
                 renderer->viewport_queued = SDL_TRUE;
+                if (renderer->capture) {
+                    SDL_CaptureViewport(renderer);
+                }
             }
         }
     }
@@ -436,6 +626,9 @@ QueueCmdSetClipRect(SDL_Renderer *renderer)
             SDL_memcpy(&renderer->last_queued_cliprect, &renderer->clip_rect, sizeof (SDL_Rect));
             renderer->last_queued_cliprect_enabled = renderer->clipping_enabled;
             renderer->cliprect_queued = SDL_TRUE;
+            if (renderer->capture) {
+                SDL_CaptureClipRect(renderer);
+            }
         }
     }
     return retval;
@@ -484,6 +677,9 @@ QueueCmdClear(SDL_Renderer *renderer)
     cmd->data.color.g = renderer->g;
     cmd->data.color.b = renderer->b;
     cmd->data.color.a = renderer->a;
+    if (renderer->capture) {
+        SDL_CaptureClear(renderer);
+    }
     return 0;
 }
 
@@ -506,7 +702,6 @@ PrepQueueCmdDraw(SDL_Renderer *renderer, const Uint8 r, const Uint8 g, const Uin
 static SDL_RenderCommand *
 PrepQueueCmdDrawSolid(SDL_Renderer *renderer, const SDL_RenderCommandType cmdtype)
 {
-    /* !!! FIXME: drop this draw if viewport w or h is zero. */
     SDL_RenderCommand *cmd = NULL;
     if (PrepQueueCmdDraw(renderer, renderer->r, renderer->g, renderer->b, renderer->a) == 0) {
         cmd = AllocateRenderCommand(renderer);
@@ -525,16 +720,118 @@ PrepQueueCmdDrawSolid(SDL_Renderer *renderer, const SDL_RenderCommandType cmdtyp
     return cmd;
 }
 
+/* Draws that can't touch the viewport or the clip rect are dropped before they're
+   queued. The bounds are in the same coordinates the Queue functions get, and have a
+   pixel of slack on every side since the backends round differently, so nothing that
+   might have been visible is lost. Returns SDL_FALSE if nothing is visible at all. */
+static SDL_bool
+GetCullBounds(SDL_Renderer *renderer, SDL_FRect *bounds)
+{
+    SDL_Rect visible;
+
+    visible.x = 0;
+    visible.y = 0;
+    visible.w = renderer->viewport.w;
+    visible.h = renderer->viewport.h;
+    if (renderer->clipping_enabled) {
+        if (!SDL_IntersectRect(&visible, &renderer->clip_rect, &visible)) {
+            return SDL_FALSE;
+        }
+    } else if (SDL_RectEmpty(&visible)) {
+        return SDL_FALSE;
+    }
+
+    bounds->x = (float) (visible.x - 1);
+    bounds->y = (float) (visible.y - 1);
+    bounds->w = (float) (visible.w + 2);
+    bounds->h = (float) (visible.h + 2);
+    return SDL_TRUE;
+}
+
+static SDL_INLINE SDL_bool
+IsCulled(const SDL_FRect *bounds, float minx, float miny, float maxx, float maxy)
+{
+    if ((maxx < bounds->x) || (maxy < bounds->y) ||
+        (minx > (bounds->x + bounds->w)) || (miny > (bounds->y + bounds->h))) {
+        return SDL_TRUE;
+    }
+    return SDL_FALSE;
+}
+
+static SDL_bool
+IsRectCulled(const SDL_FRect *bounds, const SDL_FRect *rect)
+{
+    /* a negative size flips the rectangle rather than emptying it */
+    const float x2 = rect->x + rect->w;
+    const float y2 = rect->y + rect->h;
+    return IsCulled(bounds, SDL_min(rect->x, x2), SDL_min(rect->y, y2), SDL_max(rect->x, x2), SDL_max(rect->y, y2));
+}
+
+static SDL_bool
+IsRotatedRectCulled(const SDL_FRect *bounds, const SDL_FRect *rect, const SDL_FPoint *center)
+{
+    /* Whatever the angle, the corners stay as far from the center as they were, so
+       a square around that circle holds the rotated rectangle. */
+    const float cx = rect->x + center->x;
+    const float cy = rect->y + center->y;
+    const float dx = SDL_max(SDL_fabs(center->x), SDL_fabs(rect->w - center->x));
+    const float dy = SDL_max(SDL_fabs(center->y), SDL_fabs(rect->h - center->y));
+    const float radius = (float) SDL_sqrt((dx * dx) + (dy * dy));
+    return IsCulled(bounds, cx - radius, cy - radius, cx + radius, cy + radius);
+}
+
 static int
 QueueCmdDrawPoints(SDL_Renderer *renderer, const SDL_FPoint * points, const int count)
 {
-    SDL_RenderCommand *cmd = PrepQueueCmdDrawSolid(renderer, SDL_RENDERCMD_DRAW_POINTS);
+    SDL_RenderCommand *cmd;
+    SDL_FPoint *visible = NULL;
+    SDL_FRect bounds;
+    SDL_bool isstack;
+    int i, num_visible;
     int retval = -1;
-    if (cmd != NULL) {
-        retval = renderer->QueueDrawPoints(renderer, cmd, points, count);
-        if (retval < 0) {
-            cmd->command = SDL_RENDERCMD_NO_OP;
+
+    if (!GetCullBounds(renderer, &bounds)) {
+        renderer->stats.culled += count;
+        return 0;
+    }
+    for (num_visible = 0; num_visible < count; ++num_visible) {
+        const SDL_FPoint *pt = &points[num_visible];
+        if (IsCulled(&bounds, pt->x, pt->y, pt->x, pt->y)) {
+            break;
+        }
+    }
+    if (num_visible < count) {
+        /* keep the points that might show up, in order */
+        visible = SDL_small_alloc(SDL_FPoint, count, &isstack);
+        if (!visible) {
+            return SDL_OutOfMemory();
         }
+        SDL_memcpy(visible, points, num_visible * sizeof (*visible));
+        for (i = num_visible; i < count; ++i) {
+            if (!IsCulled(&bounds, points[i].x, points[i].y, points[i].x, points[i].y)) {
+                visible[num_visible++] = points[i];
+            }
+        }
+        renderer->stats.culled += count - num_visible;
+        points = visible;
+    }
+
+    if (num_visible > 0) {
+        cmd = PrepQueueCmdDrawSolid(renderer, SDL_RENDERCMD_DRAW_POINTS);
+        if (cmd != NULL) {
+            retval = renderer->QueueDrawPoints(renderer, cmd, points, num_visible);
+            if (retval < 0) {
+                cmd->command = SDL_RENDERCMD_NO_OP;
+            } else if (renderer->capture) {
+                SDL_CaptureDrawPoints(renderer, points, num_visible);
+            }
+        }
+    } else {
+        retval = 0;
+    }
+
+    if (visible) {
+        SDL_small_free(visible, isstack);
     }
     return retval;
 }
@@ -542,12 +839,33 @@ QueueCmdDrawPoints(SDL_Renderer *renderer, const SDL_FPoint * points, const int
 static int
 QueueCmdDrawLines(SDL_Renderer *renderer, const SDL_FPoint * points, const int count)
 {
-    SDL_RenderCommand *cmd = PrepQueueCmdDrawSolid(renderer, SDL_RENDERCMD_DRAW_LINES);
+    SDL_RenderCommand *cmd;
+    SDL_FRect bounds;
+    float minx, miny, maxx, maxy;
+    int i;
     int retval = -1;
+
+    /* the segments are joined, so the whole line goes or none of it does */
+    minx = maxx = points[0].x;
+    miny = maxy = points[0].y;
+    for (i = 1; i < count; ++i) {
+        minx = SDL_min(minx, points[i].x);
+        miny = SDL_min(miny, points[i].y);
+        maxx = SDL_max(maxx, points[i].x);
+        maxy = SDL_max(maxy, points[i].y);
+    }
+    if (!GetCullBounds(renderer, &bounds) || IsCulled(&bounds, minx, miny, maxx, maxy)) {
+        renderer->stats.culled += count - 1;
+        return 0;
+    }
+
+    cmd = PrepQueueCmdDrawSolid(renderer, SDL_RENDERCMD_DRAW_LINES);
     if (cmd != NULL) {
         retval = renderer->QueueDrawLines(renderer, cmd, points, count);
         if (retval < 0) {
             cmd->command = SDL_RENDERCMD_NO_OP;
+        } else if (renderer->capture) {
+            SDL_CaptureDrawLines(renderer, points, count);
         }
     }
     return retval;
@@ -556,13 +874,53 @@ QueueCmdDrawLines(SDL_Renderer *renderer, const SDL_FPoint * points, const int c
 static int
 QueueCmdFillRects(SDL_Renderer *renderer, const SDL_FRect * rects, const int count)
 {
-    SDL_RenderCommand *cmd = PrepQueueCmdDrawSolid(renderer, SDL_RENDERCMD_FILL_RECTS);
+    SDL_RenderCommand *cmd;
+    SDL_FRect *visible = NULL;
+    SDL_FRect bounds;
+    SDL_bool isstack;
+    int i, num_visible;
     int retval = -1;
-    if (cmd != NULL) {
-        retval = renderer->QueueFillRects(renderer, cmd, rects, count);
-        if (retval < 0) {
-            cmd->command = SDL_RENDERCMD_NO_OP;
+
+    if (!GetCullBounds(renderer, &bounds)) {
+        renderer->stats.culled += count;
+        return 0;
+    }
+    for (num_visible = 0; num_visible < count; ++num_visible) {
+        if (IsRectCulled(&bounds, &rects[num_visible])) {
+            break;
+        }
+    }
+    if (num_visible < count) {
+        visible = SDL_small_alloc(SDL_FRect, count, &isstack);
+        if (!visible) {
+            return SDL_OutOfMemory();
+        }
+        SDL_memcpy(visible, rects, num_visible * sizeof (*visible));
+        for (i = num_visible; i < count; ++i) {
+            if (!IsRectCulled(&bounds, &rects[i])) {
+                visible[num_visible++] = rects[i];
+            }
         }
+        renderer->stats.culled += count - num_visible;
+        rects = visible;
+    }
+
+    if (num_visible > 0) {
+        cmd = PrepQueueCmdDrawSolid(renderer, SDL_RENDERCMD_FILL_RECTS);
+        if (cmd != NULL) {
+            retval = renderer->QueueFillRects(renderer, cmd, rects, num_visible);
+            if (retval < 0) {
+                cmd->command = SDL_RENDERCMD_NO_OP;
+            } else if (renderer->capture) {
+                SDL_CaptureFillRects(renderer, rects, num_visible);
+            }
+        }
+    } else {
+        retval = 0;
+    }
+
+    if (visible) {
+        SDL_small_free(visible, isstack);
     }
     return retval;
 }
@@ -570,7 +928,6 @@ QueueCmdFillRects(SDL_Renderer *renderer, const SDL_FRect * rects, const int cou
 static SDL_RenderCommand *
 PrepQueueCmdDrawTexture(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_RenderCommandType cmdtype)
 {
-    /* !!! FIXME: drop this draw if viewport w or h is zero. */
     SDL_RenderCommand *cmd = NULL;
     if (PrepQueueCmdDraw(renderer, texture->r, texture->g, texture->b, texture->a) == 0) {
         cmd = AllocateRenderCommand(renderer);
@@ -589,15 +946,56 @@ PrepQueueCmdDrawTexture(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_
     return cmd;
 }
 
+static SDL_bool
+CanCoalesceCopy(const SDL_Renderer *renderer, const SDL_RenderCommand *prev, const SDL_RenderCommand *cmd)
+{
+    size_t stride;
+
+    /* Only a copy queued right after another one, with no state change in between, can
+       join it. The scale mode is a property of the texture, so it matches too. */
+    if (!prev || (prev->next != cmd) || (prev->command != cmd->command) || (cmd->data.draw.count == 0)) {
+        return SDL_FALSE;
+    }
+    if ((prev->data.draw.texture != cmd->data.draw.texture) ||
+        (prev->data.draw.blend != cmd->data.draw.blend) ||
+        (prev->data.draw.r != cmd->data.draw.r) || (prev->data.draw.g != cmd->data.draw.g) ||
+        (prev->data.draw.b != cmd->data.draw.b) || (prev->data.draw.a != cmd->data.draw.a)) {
+        return SDL_FALSE;
+    }
+
+    /* Every copy queues the same amount of vertex data, so the new one tells us the stride.
+       The quads also have to be adjacent, which they are unless alignment padding got in. */
+    stride = (renderer->vertex_data_used - cmd->data.draw.first) / cmd->data.draw.count;
+    return ((prev->data.draw.first + (prev->data.draw.count * stride)) == cmd->data.draw.first) ? SDL_TRUE : SDL_FALSE;
+}
+
 static int
 QueueCmdCopy(SDL_Renderer *renderer, SDL_Texture * texture, const SDL_Rect * srcrect, const SDL_FRect * dstrect)
 {
-    SDL_RenderCommand *cmd = PrepQueueCmdDrawTexture(renderer, texture, SDL_RENDERCMD_COPY);
+    SDL_RenderCommand *prev = renderer->render_commands_tail;
+    SDL_RenderCommand *cmd;
+    SDL_FRect bounds;
     int retval = -1;
+
+    if (!GetCullBounds(renderer, &bounds) || IsRectCulled(&bounds, dstrect)) {
+        renderer->stats.culled++;
+        return 0;
+    }
+
+    cmd = PrepQueueCmdDrawTexture(renderer, texture, SDL_RENDERCMD_COPY);
     if (cmd != NULL) {
         retval = renderer->QueueCopy(renderer, cmd, texture, srcrect, dstrect);
         if (retval < 0) {
             cmd->command = SDL_RENDERCMD_NO_OP;
+            return retval;
+        }
+        if (CanCoalesceCopy(renderer, prev, cmd)) {
+            /* fold it into the previous copy, so the backend draws both in one go. */
+            prev->data.draw.count += cmd->data.draw.count;
+            DiscardLastRenderCommand(renderer, prev);
+        }
+        if (renderer->capture) {
+            SDL_CaptureCopy(renderer, texture, srcrect, dstrect);
         }
     }
     return retval;
@@ -608,13 +1006,134 @@ QueueCmdCopyEx(SDL_Renderer *renderer, SDL_Texture * texture,
                const SDL_Rect * srcquad, const SDL_FRect * dstrect,
                const double angle, const SDL_FPoint *center, const SDL_RendererFlip flip)
 {
-    SDL_RenderCommand *cmd = PrepQueueCmdDrawTexture(renderer, texture, SDL_RENDERCMD_COPY_EX);
+    SDL_RenderCommand *prev = renderer->render_commands_tail;
+    SDL_RenderCommand *cmd;
+    SDL_FRect bounds;
     int retval = -1;
     SDL_assert(renderer->QueueCopyEx != NULL);  /* should have caught at higher level. */
+
+    if (!GetCullBounds(renderer, &bounds) || IsRotatedRectCulled(&bounds, dstrect, center)) {
+        renderer->stats.culled++;
+        return 0;
+    }
+
+    cmd = PrepQueueCmdDrawTexture(renderer, texture, SDL_RENDERCMD_COPY_EX);
     if (cmd != NULL) {
         retval = renderer->QueueCopyEx(renderer, cmd, texture, srcquad, dstrect, angle, center, flip);
         if (retval < 0) {
             cmd->command = SDL_RENDERCMD_NO_OP;
+            return retval;
+        }
+        if (CanCoalesceCopy(renderer, prev, cmd)) {
+            prev->data.draw.count += cmd->data.draw.count;
+            DiscardLastRenderCommand(renderer, prev);
+        }
+        if (renderer->capture) {
+            SDL_CaptureCopyEx(renderer, texture, srcquad, dstrect, angle, center, flip);
+        }
+    }
+    return retval;
+}
+
+static int
+QueueCmdCopyBatch(SDL_Renderer *renderer, SDL_Texture * texture,
+                  const SDL_Rect * srcrects, const SDL_FRect * dstrects, const int count)
+{
+    SDL_RenderCommand *prev = renderer->render_commands_tail;
+    SDL_RenderCommand *cmd;
+    SDL_FRect bounds;
+    int i;
+    int retval = -1;
+
+    /* if any sprite is out of sight, leave it to the single copies to drop it */
+    if (renderer->QueueCopyBatch && GetCullBounds(renderer, &bounds)) {
+        for (i = 0; i < count; i++) {
+            if (IsRectCulled(&bounds, &dstrects[i])) {
+                break;
+            }
+        }
+    } else {
+        i = 0;
+    }
+
+    if (i < count) {
+        /* one at a time, they still end up merged into a single command. */
+        for (i = 0; i < count; i++) {
+            retval = QueueCmdCopy(renderer, texture, &srcrects[i], &dstrects[i]);
+            if (retval < 0) {
+                break;
+            }
+        }
+        return retval;
+    }
+
+    cmd = PrepQueueCmdDrawTexture(renderer, texture, SDL_RENDERCMD_COPY);
+    if (cmd != NULL) {
+        retval = renderer->QueueCopyBatch(renderer, cmd, texture, srcrects, dstrects, count);
+        if (retval < 0) {
+            cmd->command = SDL_RENDERCMD_NO_OP;
+            return retval;
+        }
+        if (CanCoalesceCopy(renderer, prev, cmd)) {
+            prev->data.draw.count += cmd->data.draw.count;
+            DiscardLastRenderCommand(renderer, prev);
+        }
+        if (renderer->capture) {
+            /* captures don't know about batches, each sprite is recorded as a copy. */
+            for (i = 0; i < count; i++) {
+                SDL_CaptureCopy(renderer, texture, &srcrects[i], &dstrects[i]);
+            }
+        }
+    }
+    return retval;
+}
+
+static int
+QueueCmdCopyExBatch(SDL_Renderer *renderer, SDL_Texture * texture,
+                    const SDL_Rect * srcquads, const SDL_FRect * dstrects, const double *angles,
+                    const SDL_FPoint *centers, const SDL_RendererFlip *flips, const int count)
+{
+    SDL_RenderCommand *prev = renderer->render_commands_tail;
+    SDL_RenderCommand *cmd;
+    SDL_FRect bounds;
+    int i;
+    int retval = -1;
+
+    if (renderer->QueueCopyExBatch && GetCullBounds(renderer, &bounds)) {
+        for (i = 0; i < count; i++) {
+            if (IsRotatedRectCulled(&bounds, &dstrects[i], &centers[i])) {
+                break;
+            }
+        }
+    } else {
+        i = 0;
+    }
+
+    if (i < count) {
+        for (i = 0; i < count; i++) {
+            retval = QueueCmdCopyEx(renderer, texture, &srcquads[i], &dstrects[i], angles[i], &centers[i], flips[i]);
+            if (retval < 0) {
+                break;
+            }
+        }
+        return retval;
+    }
+
+    cmd = PrepQueueCmdDrawTexture(renderer, texture, SDL_RENDERCMD_COPY_EX);
+    if (cmd != NULL) {
+        retval = renderer->QueueCopyExBatch(renderer, cmd, texture, srcquads, dstrects, angles, centers, flips, count);
+        if (retval < 0) {
+            cmd->command = SDL_RENDERCMD_NO_OP;
+            return retval;
+        }
+        if (CanCoalesceCopy(renderer, prev, cmd)) {
+            prev->data.draw.count += cmd->data.draw.count;
+            DiscardLastRenderCommand(renderer, prev);
+        }
+        if (renderer->capture) {
+            for (i = 0; i < count; i++) {
+                SDL_CaptureCopyEx(renderer, texture, &srcquads[i], &dstrects[i], angles[i], &centers[i], flips[i]);
+            }
         }
     }
     return retval;
@@ -1593,6 +2112,9 @@ SDL_UpdateTexture(SDL_Texture * texture, const SDL_Rect * rect,
         if (FlushRenderCommandsIfTextureNeeded(texture) < 0) {
             return -1;
         }
+        if (renderer->capture) {
+            SDL_CaptureTextureChanged(texture);
+        }
         return renderer->UpdateTexture(renderer, texture, rect, pixels, pitch);
     }
 }
@@ -1705,6 +2227,9 @@ int SDL_UpdateYUVTexture(SDL_Texture * texture, const SDL_Rect * rect,
             if (FlushRenderCommandsIfTextureNeeded(texture) < 0) {
                 return -1;
             }
+            if (renderer->capture) {
+                SDL_CaptureTextureChanged(texture);
+            }
             return renderer->UpdateTextureYUV(renderer, texture, rect, Yplane, Ypitch, Uplane, Upitch, Vplane, Vpitch);
         } else {
             return SDL_Unsupported();
@@ -1768,6 +2293,56 @@ SDL_LockTexture(SDL_Texture * texture, const SDL_Rect * rect,
     }
 }
 
+int
+SDL_LockTextureToSurface(SDL_Texture * texture, const SDL_Rect * rect,
+                         SDL_Surface ** surface)
+{
+    SDL_Rect real_rect;
+    SDL_Surface *locked;
+    void *pixels = NULL;
+    int pitch = 0;
+
+    CHECK_TEXTURE_MAGIC(texture, -1);
+
+    if (!surface) {
+        return SDL_InvalidParamError("surface");
+    }
+
+    real_rect.x = 0;
+    real_rect.y = 0;
+    real_rect.w = texture->w;
+    real_rect.h = texture->h;
+    if (rect) {
+        SDL_IntersectRect(rect, &real_rect, &real_rect);
+    }
+
+    if (SDL_LockTexture(texture, &real_rect, &pixels, &pitch) < 0) {
+        return -1;
+    }
+
+    /* Keep the surface from the last lock if it's the same shape, so surfaces
+       blitted to it keep their mapping and blitters */
+    locked = texture->locked_surface;
+    if (locked && (locked->w != real_rect.w || locked->h != real_rect.h ||
+                   locked->pitch != pitch)) {
+        SDL_FreeSurface(locked);
+        locked = texture->locked_surface = NULL;
+    }
+    if (!locked) {
+        locked = SDL_CreateRGBSurfaceWithFormatFrom(pixels, real_rect.w, real_rect.h, 0,
+                                                    pitch, texture->format);
+        if (!locked) {
+            SDL_UnlockTexture(texture);
+            return -1;
+        }
+        texture->locked_surface = locked;
+    }
+    locked->pixels = pixels;
+
+    *surface = locked;
+    return 0;
+}
+
 static void
 SDL_UnlockTextureYUV(SDL_Texture * texture)
 {
@@ -1818,12 +2393,19 @@ SDL_UnlockTexture(SDL_Texture * texture)
     if (texture->access != SDL_TEXTUREACCESS_STREAMING) {
         return;
     }
+    if (texture->locked_surface) {
+        /* the pixels aren't there to draw into any more */
+        texture->locked_surface->pixels = NULL;
+    }
     if (texture->yuv) {
         SDL_UnlockTextureYUV(texture);
     } else if (texture->native) {
         SDL_UnlockTextureNative(texture);
     } else {
         SDL_Renderer *renderer = texture->renderer;
+        if (renderer->capture) {
+            SDL_CaptureTextureChanged(texture);
+        }
         renderer->UnlockTexture(renderer, texture);
     }
 }
@@ -1848,7 +2430,7 @@ SDL_SetRenderTarget(SDL_Renderer *renderer, SDL_Texture *texture)
         return 0;
     }
 
-    FlushRenderCommands(renderer);  /* time to send everything to the GPU! */
+    FlushRenderCommands(renderer, SDL_RENDER_FLUSH_TARGET_SWITCH);  /* time to send everything to the GPU! */
 
     /* texture == NULL is valid and means reset the target to the window */
     if (texture) {
@@ -1905,6 +2487,10 @@ SDL_SetRenderTarget(SDL_Renderer *renderer, SDL_Texture *texture)
 
     SDL_UnlockMutex(renderer->target_mutex);
 
+    if (renderer->capture) {
+        SDL_CaptureRenderTarget(renderer);
+    }
+
     if (QueueCmdSetViewport(renderer) < 0) {
         return -1;
     }
@@ -3091,6 +3677,189 @@ SDL_RenderCopyExF(SDL_Renderer * renderer, SDL_Texture * texture,
     return retval < 0 ? retval : FlushRenderCommandsIfNotBatching(renderer);
 }
 
+/* Sprites are validated into stack buffers of this many and queued a chunk at a time;
+   the chunks merge back into one command, so the size only bounds stack use. */
+#define COPY_BATCH_CHUNK 64
+
+int
+SDL_RenderCopyBatch(SDL_Renderer * renderer, SDL_Texture * texture,
+                    const SDL_Rect * srcrects, const SDL_FRect * dstrects, int count)
+{
+    SDL_Rect real_srcrects[COPY_BATCH_CHUNK];
+    SDL_FRect real_dstrects[COPY_BATCH_CHUNK];
+    SDL_Rect texture_rect;
+    SDL_FRect viewport_rect;
+    SDL_Rect r;
+    int i, n = 0;
+    int retval = 0;
+
+    CHECK_RENDERER_MAGIC(renderer, -1);
+    CHECK_TEXTURE_MAGIC(texture, -1);
+
+    if (renderer != texture->renderer) {
+        return SDL_SetError("Texture was not created with this renderer");
+    }
+    if (!dstrects) {
+        return SDL_InvalidParamError("dstrects");
+    }
+    if (count < 0) {
+        return SDL_InvalidParamError("count");
+    }
+
+    /* Don't draw while we're hidden */
+    if (renderer->hidden || (count == 0)) {
+        return 0;
+    }
+
+    texture_rect.x = 0;
+    texture_rect.y = 0;
+    texture_rect.w = texture->w;
+    texture_rect.h = texture->h;
+
+    SDL_zero(r);
+    SDL_RenderGetViewport(renderer, &r);
+    viewport_rect.x = 0.0f;
+    viewport_rect.y = 0.0f;
+    viewport_rect.w = (float) r.w;
+    viewport_rect.h = (float) r.h;
+
+    if (texture->native) {
+        texture = texture->native;
+    }
+
+    texture->last_command_generation = renderer->render_command_generation;
+
+    /* Same rules as SDL_RenderCopyF(), paid once per batch instead of once per sprite. */
+    for (i = 0; i < count; i++) {
+        SDL_Rect *srcrect = &real_srcrects[n];
+        SDL_FRect *dstrect = &real_dstrects[n];
+
+        if (srcrects) {
+            if (!SDL_IntersectRect(&srcrects[i], &texture_rect, srcrect)) {
+                continue;
+            }
+        } else {
+            *srcrect = texture_rect;
+        }
+
+        if (!SDL_HasIntersectionF(&dstrects[i], &viewport_rect)) {
+            continue;
+        }
+
+        dstrect->x = dstrects[i].x * renderer->scale.x;
+        dstrect->y = dstrects[i].y * renderer->scale.y;
+        dstrect->w = dstrects[i].w * renderer->scale.x;
+        dstrect->h = dstrects[i].h * renderer->scale.y;
+
+        if (++n == COPY_BATCH_CHUNK) {
+            retval = QueueCmdCopyBatch(renderer, texture, real_srcrects, real_dstrects, n);
+            if (retval < 0) {
+                return retval;
+            }
+            n = 0;
+        }
+    }
+
+    if (n > 0) {
+        retval = QueueCmdCopyBatch(renderer, texture, real_srcrects, real_dstrects, n);
+    }
+    return retval < 0 ? retval : FlushRenderCommandsIfNotBatching(renderer);
+}
+
+int
+SDL_RenderCopyExBatch(SDL_Renderer * renderer, SDL_Texture * texture,
+                      const SDL_Rect * srcrects, const SDL_FRect * dstrects,
+                      const double * angles, const SDL_FPoint * centers,
+                      const SDL_RendererFlip * flips, int count)
+{
+    SDL_Rect real_srcrects[COPY_BATCH_CHUNK];
+    SDL_FRect real_dstrects[COPY_BATCH_CHUNK];
+    double real_angles[COPY_BATCH_CHUNK];
+    SDL_FPoint real_centers[COPY_BATCH_CHUNK];
+    SDL_RendererFlip real_flips[COPY_BATCH_CHUNK];
+    SDL_Rect texture_rect;
+    int i, n = 0;
+    int retval = 0;
+
+    CHECK_RENDERER_MAGIC(renderer, -1);
+    CHECK_TEXTURE_MAGIC(texture, -1);
+
+    if (renderer != texture->renderer) {
+        return SDL_SetError("Texture was not created with this renderer");
+    }
+    if (!renderer->QueueCopyEx) {
+        return SDL_SetError("Renderer does not support RenderCopyEx");
+    }
+    if (!dstrects) {
+        return SDL_InvalidParamError("dstrects");
+    }
+    if (count < 0) {
+        return SDL_InvalidParamError("count");
+    }
+
+    /* Don't draw while we're hidden */
+    if (renderer->hidden || (count == 0)) {
+        return 0;
+    }
+
+    texture_rect.x = 0;
+    texture_rect.y = 0;
+    texture_rect.w = texture->w;
+    texture_rect.h = texture->h;
+
+    if (texture->native) {
+        texture = texture->native;
+    }
+
+    texture->last_command_generation = renderer->render_command_generation;
+
+    /* Same rules as SDL_RenderCopyExF(), except sprites that don't need rotating or
+       flipping stay in the batch rather than taking the plain copy path. */
+    for (i = 0; i < count; i++) {
+        SDL_Rect *srcrect = &real_srcrects[n];
+        SDL_FRect *dstrect = &real_dstrects[n];
+        SDL_FPoint *center = &real_centers[n];
+
+        if (srcrects) {
+            if (!SDL_IntersectRect(&srcrects[i], &texture_rect, srcrect)) {
+                continue;
+            }
+        } else {
+            *srcrect = texture_rect;
+        }
+
+        if (centers) {
+            *center = centers[i];
+        } else {
+            center->x = dstrects[i].w / 2.0f;
+            center->y = dstrects[i].h / 2.0f;
+        }
+        center->x *= renderer->scale.x;
+        center->y *= renderer->scale.y;
+
+        dstrect->x = dstrects[i].x * renderer->scale.x;
+        dstrect->y = dstrects[i].y * renderer->scale.y;
+        dstrect->w = dstrects[i].w * renderer->scale.x;
+        dstrect->h = dstrects[i].h * renderer->scale.y;
+
+        real_angles[n] = angles ? angles[i] : 0.0;
+        real_flips[n] = flips ? flips[i] : SDL_FLIP_NONE;
+
+        if (++n == COPY_BATCH_CHUNK) {
+            retval = QueueCmdCopyExBatch(renderer, texture, real_srcrects, real_dstrects, real_angles, real_centers, real_flips, n);
+            if (retval < 0) {
+                return retval;
+            }
+            n = 0;
+        }
+    }
+
+    if (n > 0) {
+        retval = QueueCmdCopyExBatch(renderer, texture, real_srcrects, real_dstrects, real_angles, real_centers, real_flips, n);
+    }
+    return retval < 0 ? retval : FlushRenderCommandsIfNotBatching(renderer);
+}
+
 int
 SDL_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
                      Uint32 format, void * pixels, int pitch)
@@ -3103,7 +3872,7 @@ SDL_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
         return SDL_Unsupported();
     }
 
-    FlushRenderCommands(renderer);  /* we need to render before we read the results. */
+    FlushRenderCommands(renderer, SDL_RENDER_FLUSH_READ_PIXELS);  /* we need to render before we read the results. */
 
     if (!format) {
         format = SDL_GetWindowPixelFormat(renderer->window);
@@ -3135,7 +3904,16 @@ SDL_RenderPresent(SDL_Renderer * renderer)
 {
     CHECK_RENDERER_MAGIC(renderer, );
 
-    FlushRenderCommands(renderer);  /* time to send everything to the GPU! */
+    FlushRenderCommands(renderer, SDL_RENDER_FLUSH_PRESENT);  /* time to send everything to the GPU! */
+    if (renderer->capture) {
+        renderer->capture_status = SDL_CapturePresent(renderer);
+    }
+
+    /* this frame is done, start counting the next one. */
+    renderer->last_stats = renderer->stats;
+    SDL_zero(renderer->stats);
+    renderer->stats.frame = renderer->last_stats.frame + 1;
+    renderer->stats_drawn = SDL_FALSE;
 
     /* Don't present while we're hidden */
     if (renderer->hidden) {
@@ -3157,6 +3935,9 @@ SDL_DestroyTexture(SDL_Texture * texture)
     } else {
         FlushRenderCommandsIfTextureNeeded(texture);
     }
+    if (renderer->capture) {
+        SDL_CaptureTextureDestroyed(texture);
+    }
 
     texture->magic = NULL;
 
@@ -3176,6 +3957,7 @@ SDL_DestroyTexture(SDL_Texture * texture)
         SDL_SW_DestroyYUVTexture(texture->yuv);
     }
     SDL_free(texture->pixels);
+    SDL_FreeSurface(texture->locked_surface);
 
     renderer->DestroyTexture(renderer, texture);
     SDL_free(texture);
@@ -3184,42 +3966,20 @@ SDL_DestroyTexture(SDL_Texture * texture)
 void
 SDL_DestroyRenderer(SDL_Renderer * renderer)
 {
-    SDL_RenderCommand *cmd;
-    SDL_AllocVertGap *gap;
-    SDL_AllocVertGap *nextgap;
-
     CHECK_RENDERER_MAGIC(renderer, );
 
     SDL_DelEventWatch(SDL_RendererEventWatch, renderer);
 
-    if (renderer->render_commands_tail != NULL) {
-        renderer->render_commands_tail->next = renderer->render_commands_pool;
-        cmd = renderer->render_commands;
-    } else {
-        cmd = renderer->render_commands_pool;
+    if (renderer->capture) {
+        SDL_CaptureAbort(renderer);  /* the frame is never finished */
     }
 
-    renderer->render_commands_pool = NULL;
     renderer->render_commands_tail = NULL;
     renderer->render_commands = NULL;
-
-    while (cmd != NULL) {
-        SDL_RenderCommand *next = cmd->next;
-        SDL_free(cmd);
-        cmd = next;
-    }
+    FreeRenderCommandBlocks(renderer);
 
     SDL_free(renderer->vertex_data);
-
-    for (gap = renderer->vertex_data_gaps.next; gap; gap = nextgap) {
-        nextgap = gap->next;
-        SDL_free(gap);
-    }
-
-    for (gap = renderer->vertex_data_gaps_pool; gap; gap = nextgap) {
-        nextgap = gap->next;
-        SDL_free(gap);
-    }
+    renderer->vertex_data = NULL;
 
     /* Free existing textures for this renderer */
     while (renderer->textures) {
@@ -3281,7 +4041,7 @@ SDL_RenderGetMetalLayer(SDL_Renderer * renderer)
     CHECK_RENDERER_MAGIC(renderer, NULL);
 
     if (renderer->GetMetalLayer) {
-        FlushRenderCommands(renderer);  /* in case the app is going to mess with it. */
+        FlushRenderCommands(renderer, SDL_RENDER_FLUSH_OTHER);  /* in case the app is going to mess with it. */
         return renderer->GetMetalLayer(renderer);
     }
     return NULL;
@@ -3293,7 +4053,7 @@ SDL_RenderGetMetalCommandEncoder(SDL_Renderer * renderer)
     CHECK_RENDERER_MAGIC(renderer, NULL);
 
     if (renderer->GetMetalCommandEncoder) {
-        FlushRenderCommands(renderer);  /* in case the app is going to mess with it. */
+        FlushRenderCommands(renderer, SDL_RENDER_FLUSH_OTHER);  /* in case the app is going to mess with it. */
         return renderer->GetMetalCommandEncoder(renderer);
     }
     return NULL;
@@ -3308,6 +4068,9 @@ SDL_GetShortBlendMode(SDL_BlendMode blendMode)
     if (blendMode == SDL_BLENDMODE_BLEND_FULL) {
         return SDL_BLENDMODE_BLEND;
     }
+    if (blendMode == SDL_BLENDMODE_BLEND_PREMULTIPLIED_FULL) {
+        return SDL_BLENDMODE_BLEND_PREMULTIPLIED;
+    }
     if (blendMode == SDL_BLENDMODE_ADD_FULL) {
         return SDL_BLENDMODE_ADD;
     }
@@ -3326,6 +4089,9 @@ SDL_GetLongBlendMode(SDL_BlendMode blendMode)
     if (blendMode == SDL_BLENDMODE_BLEND) {
         return SDL_BLENDMODE_BLEND_FULL;
     }
+    if (blendMode == SDL_BLENDMODE_BLEND_PREMULTIPLIED) {
+        return SDL_BLENDMODE_BLEND_PREMULTIPLIED_FULL;
+    }
     if (blendMode == SDL_BLENDMODE_ADD) {
         return SDL_BLENDMODE_ADD_FULL;
     }
@@ -0,0 +1,925 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2019 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+/* Recording one frame of rendering to a stream, and playing it back */
+
+#include "SDL_render.h"
+#include "SDL_sysrender.h"
+#include "SDL_rendercapture_c.h"
+
+/* A capture starts with an 8 byte signature and the output size, followed by one record
+   per queued operation, each a type byte and its fields in little endian order. Texture
+   contents are written the first time a texture is used and again after it changes, so
+   the file holds everything needed to draw the frame on any renderer. */
+
+#define CAPTURE_MAGIC       "SDLRCAP"
+#define CAPTURE_VERSION     1
+#define CAPTURE_HEADER_SIZE 16
+
+typedef enum
+{
+    CAPTURE_END,
+    CAPTURE_TEXTURE,
+    CAPTURE_TARGET,
+    CAPTURE_VIEWPORT,
+    CAPTURE_CLIPRECT,
+    CAPTURE_CLEAR,
+    CAPTURE_DRAW_POINTS,
+    CAPTURE_DRAW_LINES,
+    CAPTURE_FILL_RECTS,
+    CAPTURE_COPY,
+    CAPTURE_COPY_EX,
+    CAPTURE_FLUSH
+} SDL_CaptureRecordType;
+
+typedef struct SDL_CaptureTexture
+{
+    SDL_Texture *texture;
+    Uint32 id;
+    SDL_bool stale;
+} SDL_CaptureTexture;
+
+typedef struct SDL_RenderCaptureState
+{
+    SDL_RWops *dst;
+    SDL_bool failed;
+    SDL_CaptureTexture *textures;
+    int num_textures;
+    int max_textures;
+    Uint32 next_id;
+} SDL_RenderCaptureState;
+
+struct SDL_RenderCapture
+{
+    Uint8 *data;
+    size_t size;
+    int w, h;
+    Uint32 num_ids;
+
+    /* Replay state, the textures are indexed by id and belong to renderer */
+    SDL_Renderer *renderer;
+    SDL_Texture **textures;
+    const Uint8 **uploaded;     /* the pixels each texture holds, NULL if drawn to */
+    void *scratch;
+    size_t scratch_size;
+};
+
+/* One decoded record; only the fields for its type are set */
+typedef struct SDL_CaptureRecord
+{
+    Uint8 type;
+    Uint32 id;
+    Uint32 format;
+    Uint32 access;
+    int w, h;
+    Uint32 scale_mode;
+    const Uint8 *pixels;
+    Uint8 r, g, b, a;
+    Uint32 blend;
+    SDL_bool enabled;
+    SDL_Rect rect;
+    SDL_FRect dstrect;
+    double angle;
+    SDL_FPoint center;
+    Uint32 flip;
+    Uint32 count;
+    const Uint8 *data;
+} SDL_CaptureRecord;
+
+typedef struct SDL_CaptureReader
+{
+    const Uint8 *p;
+    const Uint8 *end;
+    SDL_bool ok;
+} SDL_CaptureReader;
+
+
+static void
+WriteU8(SDL_RenderCaptureState *state, const Uint8 value)
+{
+    if (!state->failed && SDL_WriteU8(state->dst, value) != 1) {
+        state->failed = SDL_TRUE;
+    }
+}
+
+static void
+WriteU32(SDL_RenderCaptureState *state, const Uint32 value)
+{
+    if (!state->failed && SDL_WriteLE32(state->dst, value) != 1) {
+        state->failed = SDL_TRUE;
+    }
+}
+
+static void
+WriteFloat(SDL_RenderCaptureState *state, const float value)
+{
+    Uint32 bits;
+    SDL_memcpy(&bits, &value, sizeof (bits));
+    WriteU32(state, bits);
+}
+
+static void
+WriteDouble(SDL_RenderCaptureState *state, const double value)
+{
+    Uint64 bits;
+    SDL_memcpy(&bits, &value, sizeof (bits));
+    if (!state->failed && SDL_WriteLE64(state->dst, bits) != 1) {
+        state->failed = SDL_TRUE;
+    }
+}
+
+static void
+WriteRect(SDL_RenderCaptureState *state, const SDL_Rect *rect)
+{
+    WriteU32(state, (Uint32)rect->x);
+    WriteU32(state, (Uint32)rect->y);
+    WriteU32(state, (Uint32)rect->w);
+    WriteU32(state, (Uint32)rect->h);
+}
+
+static void
+WriteColor(SDL_RenderCaptureState *state, const Uint8 r, const Uint8 g, const Uint8 b, const Uint8 a)
+{
+    WriteU8(state, r);
+    WriteU8(state, g);
+    WriteU8(state, b);
+    WriteU8(state, a);
+}
+
+static void
+WriteFloats(SDL_RenderCaptureState *state, const float *values, const int count)
+{
+    int i;
+    for (i = 0; i < count; ++i) {
+        WriteFloat(state, values[i]);
+    }
+}
+
+static void
+WriteTextureRecord(SDL_Renderer *renderer, SDL_RenderCaptureState *state, SDL_Texture *texture, const Uint32 id)
+{
+    Uint32 format = texture->format;
+    size_t length;
+    int pitch;
+    void *pixels;
+
+    if (SDL_ISPIXELFORMAT_FOURCC(format)) {
+        /* planar contents aren't recorded, the texture is replayed blank */
+        format = SDL_PIXELFORMAT_ARGB8888;
+    }
+
+    pitch = texture->w * SDL_BYTESPERPIXEL(format);
+    length = (size_t)pitch * texture->h;
+    pixels = SDL_calloc(1, length);
+    if (!pixels) {
+        SDL_OutOfMemory();
+        state->failed = SDL_TRUE;
+        return;
+    }
+
+    if (format == texture->format && renderer->ReadTexture) {
+        if (renderer->ReadTexture(renderer, texture, pixels, pitch) < 0) {
+            SDL_memset(pixels, 0, length);
+        }
+    }
+
+    WriteU8(state, CAPTURE_TEXTURE);
+    WriteU32(state, id);
+    WriteU32(state, format);
+    WriteU32(state, (Uint32)texture->access);
+    WriteU32(state, (Uint32)texture->w);
+    WriteU32(state, (Uint32)texture->h);
+    WriteU32(state, (Uint32)texture->scaleMode);
+    if (!state->failed && SDL_RWwrite(state->dst, pixels, 1, length) != length) {
+        state->failed = SDL_TRUE;
+    }
+
+    SDL_free(pixels);
+}
+
+static SDL_CaptureTexture *
+FindCaptureTexture(SDL_RenderCaptureState *state, const SDL_Texture *texture)
+{
+    int i;
+    for (i = 0; i < state->num_textures; ++i) {
+        if (state->textures[i].texture == texture) {
+            return &state->textures[i];
+        }
+    }
+    return NULL;
+}
+
+/* Returns the id for texture, writing its contents first if they haven't been yet */
+static Uint32
+CaptureTexture(SDL_Renderer *renderer, SDL_Texture *texture)
+{
+    SDL_RenderCaptureState *state = renderer->capture;
+    SDL_CaptureTexture *entry = FindCaptureTexture(state, texture);
+
+    if (!entry) {
+        if (state->num_textures == state->max_textures) {
+            const int max_textures = state->max_textures ? (state->max_textures * 2) : 16;
+            SDL_CaptureTexture *textures = (SDL_CaptureTexture *)SDL_realloc(state->textures, max_textures * sizeof (*textures));
+            if (!textures) {
+                SDL_OutOfMemory();
+                state->failed = SDL_TRUE;
+                return 0;
+            }
+            state->textures = textures;
+            state->max_textures = max_textures;
+        }
+        entry = &state->textures[state->num_textures++];
+        entry->texture = texture;
+        entry->id = ++state->next_id;
+        entry->stale = SDL_TRUE;
+    }
+
+    if (entry->stale) {
+        WriteTextureRecord(renderer, state, texture, entry->id);
+        entry->stale = SDL_FALSE;
+    }
+    return entry->id;
+}
+
+int
+SDL_CaptureBegin(SDL_Renderer * renderer, SDL_RWops * dst, const int w, const int h)
+{
+    SDL_RenderCaptureState *state = (SDL_RenderCaptureState *)SDL_calloc(1, sizeof (*state));
+    if (!state) {
+        return SDL_OutOfMemory();
+    }
+    state->dst = dst;
+
+    if (SDL_RWwrite(dst, CAPTURE_MAGIC, 7, 1) != 1) {
+        state->failed = SDL_TRUE;
+    }
+    WriteU8(state, CAPTURE_VERSION);
+    WriteU32(state, (Uint32)w);
+    WriteU32(state, (Uint32)h);
+    if (state->failed) {
+        SDL_free(state);
+        return -1;
+    }
+
+    renderer->capture = state;
+    if (renderer->target) {
+        SDL_CaptureRenderTarget(renderer);
+    }
+    return 0;
+}
+
+void
+SDL_CaptureViewport(SDL_Renderer * renderer)
+{
+    SDL_RenderCaptureState *state = renderer->capture;
+    WriteU8(state, CAPTURE_VIEWPORT);
+    WriteRect(state, &renderer->viewport);
+}
+
+void
+SDL_CaptureClipRect(SDL_Renderer * renderer)
+{
+    SDL_RenderCaptureState *state = renderer->capture;
+    WriteU8(state, CAPTURE_CLIPRECT);
+    WriteU8(state, renderer->clipping_enabled ? 1 : 0);
+    WriteRect(state, &renderer->clip_rect);
+}
+
+void
+SDL_CaptureClear(SDL_Renderer * renderer)
+{
+    SDL_RenderCaptureState *state = renderer->capture;
+    WriteU8(state, CAPTURE_CLEAR);
+    WriteColor(state, renderer->r, renderer->g, renderer->b, renderer->a);
+}
+
+static void
+CaptureDraw(SDL_Renderer *renderer, const Uint8 type, const float *values, const int count, const int stride)
+{
+    SDL_RenderCaptureState *state = renderer->capture;
+    WriteU8(state, type);
+    WriteColor(state, renderer->r, renderer->g, renderer->b, renderer->a);
+    WriteU32(state, (Uint32)renderer->blendMode);
+    WriteU32(state, (Uint32)count);
+    WriteFloats(state, values, count * stride);
+}
+
+void
+SDL_CaptureDrawPoints(SDL_Renderer * renderer, const SDL_FPoint * points, const int count)
+{
+    CaptureDraw(renderer, CAPTURE_DRAW_POINTS, &points->x, count, 2);
+}
+
+void
+SDL_CaptureDrawLines(SDL_Renderer * renderer, const SDL_FPoint * points, const int count)
+{
+    CaptureDraw(renderer, CAPTURE_DRAW_LINES, &points->x, count, 2);
+}
+
+void
+SDL_CaptureFillRects(SDL_Renderer * renderer, const SDL_FRect * rects, const int count)
+{
+    CaptureDraw(renderer, CAPTURE_FILL_RECTS, &rects->x, count, 4);
+}
+
+static void
+CaptureCopy(SDL_Renderer *renderer, const Uint8 type, SDL_Texture *texture,
+            const SDL_Rect *srcrect, const SDL_FRect *dstrect)
+{
+    SDL_RenderCaptureState *state = renderer->capture;
+    const Uint32 id = CaptureTexture(renderer, texture);
+
+    WriteU8(state, type);
+    WriteU32(state, id);
+    WriteColor(state, texture->r, texture->g, texture->b, texture->a);
+    WriteU32(state, (Uint32)texture->blendMode);
+    WriteRect(state, srcrect);
+    WriteFloats(state, &dstrect->x, 4);
+}
+
+void
+SDL_CaptureCopy(SDL_Renderer * renderer, SDL_Texture * texture,
+                const SDL_Rect * srcrect, const SDL_FRect * dstrect)
+{
+    CaptureCopy(renderer, CAPTURE_COPY, texture, srcrect, dstrect);
+}
+
+void
+SDL_CaptureCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
+                  const SDL_Rect * srcrect, const SDL_FRect * dstrect,
+                  const double angle, const SDL_FPoint *center, const SDL_RendererFlip flip)
+{
+    SDL_RenderCaptureState *state = renderer->capture;
+
+    CaptureCopy(renderer, CAPTURE_COPY_EX, texture, srcrect, dstrect);
+    WriteDouble(state, angle);
+    WriteFloat(state, center->x);
+    WriteFloat(state, center->y);
+    WriteU32(state, (Uint32)flip);
+}
+
+void
+SDL_CaptureRenderTarget(SDL_Renderer * renderer)
+{
+    SDL_RenderCaptureState *state = renderer->capture;
+    const Uint32 id = renderer->target ? CaptureTexture(renderer, renderer->target) : 0;
+
+    WriteU8(state, CAPTURE_TARGET);
+    WriteU32(state, id);
+}
+
+void
+SDL_CaptureFlush(SDL_Renderer * renderer)
+{
+    WriteU8(renderer->capture, CAPTURE_FLUSH);
+}
+
+int
+SDL_CapturePresent(SDL_Renderer * renderer)
+{
+    SDL_RenderCaptureState *state = renderer->capture;
+    SDL_bool failed;
+
+    WriteU8(state, CAPTURE_END);
+    failed = state->failed;
+    SDL_CaptureAbort(renderer);
+    if (failed) {
+        return SDL_SetError("Couldn't write the whole render capture");
+    }
+    return 0;
+}
+
+void
+SDL_CaptureTextureChanged(SDL_Texture * texture)
+{
+    SDL_RenderCaptureState *state = texture->renderer->capture;
+    SDL_CaptureTexture *entry;
+
+    entry = FindCaptureTexture(state, texture);
+    if (entry) {
+        entry->stale = SDL_TRUE;
+    }
+    if (texture->native) {
+        entry = FindCaptureTexture(state, texture->native);
+        if (entry) {
+            entry->stale = SDL_TRUE;
+        }
+    }
+}
+
+void
+SDL_CaptureTextureDestroyed(SDL_Texture * texture)
+{
+    SDL_RenderCaptureState *state = texture->renderer->capture;
+    SDL_CaptureTexture *entry = FindCaptureTexture(state, texture);
+
+    /* a texture created later at the same address gets a new id */
+    if (entry) {
+        *entry = state->textures[--state->num_textures];
+    }
+}
+
+void
+SDL_CaptureAbort(SDL_Renderer * renderer)
+{
+    SDL_RenderCaptureState *state = renderer->capture;
+
+    renderer->capture = NULL;
+    SDL_free(state->textures);
+    SDL_free(state);
+}
+
+
+static SDL_bool
+ReadNeeded(SDL_CaptureReader *reader, const size_t count, const size_t size)
+{
+    if (!reader->ok || (count > (size_t)(reader->end - reader->p) / size)) {
+        reader->ok = SDL_FALSE;
+        return SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
+
+static Uint8
+ReadU8(SDL_CaptureReader *reader)
+{
+    if (!ReadNeeded(reader, 1, 1)) {
+        return 0;
+    }
+    return *reader->p++;
+}
+
+static Uint32
+ReadU32(SDL_CaptureReader *reader)
+{
+    Uint32 value;
+    if (!ReadNeeded(reader, 1, sizeof (value))) {
+        return 0;
+    }
+    SDL_memcpy(&value, reader->p, sizeof (value));
+    reader->p += sizeof (value);
+    return SDL_SwapLE32(value);
+}
+
+static float
+ReadFloat(SDL_CaptureReader *reader)
+{
+    const Uint32 bits = ReadU32(reader);
+    float value;
+    SDL_memcpy(&value, &bits, sizeof (value));
+    return value;
+}
+
+static double
+ReadDouble(SDL_CaptureReader *reader)
+{
+    Uint64 bits = 0;
+    double value;
+    if (ReadNeeded(reader, 1, sizeof (bits))) {
+        SDL_memcpy(&bits, reader->p, sizeof (bits));
+        reader->p += sizeof (bits);
+    }
+    bits = SDL_SwapLE64(bits);
+    SDL_memcpy(&value, &bits, sizeof (value));
+    return value;
+}
+
+static void
+ReadRect(SDL_CaptureReader *reader, SDL_Rect *rect)
+{
+    rect->x = (int)ReadU32(reader);
+    rect->y = (int)ReadU32(reader);
+    rect->w = (int)ReadU32(reader);
+    rect->h = (int)ReadU32(reader);
+}
+
+static void
+ReadColor(SDL_CaptureReader *reader, SDL_CaptureRecord *record)
+{
+    record->r = ReadU8(reader);
+    record->g = ReadU8(reader);
+    record->b = ReadU8(reader);
+    record->a = ReadU8(reader);
+}
+
+static const Uint8 *
+ReadArray(SDL_CaptureReader *reader, const size_t count, const size_t size)
+{
+    const Uint8 *data = reader->p;
+    if (!ReadNeeded(reader, count, size)) {
+        return NULL;
+    }
+    reader->p += count * size;
+    return data;
+}
+
+/* Decodes the next record, returns SDL_FALSE at the end of the data or if it's malformed */
+static SDL_bool
+ReadCaptureRecord(SDL_CaptureReader *reader, SDL_CaptureRecord *record)
+{
+    record->type = ReadU8(reader);
+    switch (record->type) {
+    case CAPTURE_END:
+    case CAPTURE_FLUSH:
+        break;
+
+    case CAPTURE_TEXTURE:
+        record->id = ReadU32(reader);
+        record->format = ReadU32(reader);
+        record->access = ReadU32(reader);
+        record->w = (int)ReadU32(reader);
+        record->h = (int)ReadU32(reader);
+        record->scale_mode = ReadU32(reader);
+        if (record->w <= 0 || record->h <= 0 || record->w > 16384 || record->h > 16384 ||
+            SDL_ISPIXELFORMAT_FOURCC(record->format) || SDL_BYTESPERPIXEL(record->format) == 0) {
+            reader->ok = SDL_FALSE;
+            break;
+        }
+        record->pixels = ReadArray(reader, record->h, (size_t)record->w * SDL_BYTESPERPIXEL(record->format));
+        break;
+
+    case CAPTURE_TARGET:
+        record->id = ReadU32(reader);
+        break;
+
+    case CAPTURE_VIEWPORT:
+        ReadRect(reader, &record->rect);
+        break;
+
+    case CAPTURE_CLIPRECT:
+        record->enabled = ReadU8(reader) ? SDL_TRUE : SDL_FALSE;
+        ReadRect(reader, &record->rect);
+        break;
+
+    case CAPTURE_CLEAR:
+        ReadColor(reader, record);
+        break;
+
+    case CAPTURE_DRAW_POINTS:
+    case CAPTURE_DRAW_LINES:
+    case CAPTURE_FILL_RECTS:
+        ReadColor(reader, record);
+        record->blend = ReadU32(reader);
+        record->count = ReadU32(reader);
+        record->data = ReadArray(reader, record->count, (record->type == CAPTURE_FILL_RECTS) ? 16 : 8);
+        break;
+
+    case CAPTURE_COPY:
+    case CAPTURE_COPY_EX:
+        record->id = ReadU32(reader);
+        ReadColor(reader, record);
+        record->blend = ReadU32(reader);
+        ReadRect(reader, &record->rect);
+        record->dstrect.x = ReadFloat(reader);
+        record->dstrect.y = ReadFloat(reader);
+        record->dstrect.w = ReadFloat(reader);
+        record->dstrect.h = ReadFloat(reader);
+        if (record->type == CAPTURE_COPY_EX) {
+            record->angle = ReadDouble(reader);
+            record->center.x = ReadFloat(reader);
+            record->center.y = ReadFloat(reader);
+            record->flip = ReadU32(reader);
+        }
+        break;
+
+    default:
+        reader->ok = SDL_FALSE;
+        break;
+    }
+    return reader->ok;
+}
+
+SDL_RenderCapture *
+SDL_LoadRenderCapture(SDL_RWops * src, int freesrc)
+{
+    SDL_RenderCapture *capture;
+    SDL_CaptureReader reader;
+    SDL_CaptureRecord record;
+    Uint32 num_ids = 0;
+    size_t size;
+    Uint8 *data;
+    int w, h;
+
+    if (!src) {
+        SDL_InvalidParamError("src");
+        return NULL;
+    }
+
+    data = (Uint8 *)SDL_LoadFile_RW(src, &size, freesrc);
+    if (!data) {
+        return NULL;
+    }
+    if (size < CAPTURE_HEADER_SIZE || SDL_memcmp(data, CAPTURE_MAGIC, 7) != 0) {
+        SDL_free(data);
+        SDL_SetError("Not a render capture");
+        return NULL;
+    }
+    if (data[7] != CAPTURE_VERSION) {
+        SDL_free(data);
+        SDL_SetError("Unsupported render capture version %d", (int)data[7]);
+        return NULL;
+    }
+
+    reader.p = data + 8;
+    reader.end = data + size;
+    reader.ok = SDL_TRUE;
+    w = (int)ReadU32(&reader);
+    h = (int)ReadU32(&reader);
+
+    /* Check everything now, so replaying never has to. Texture ids are handed out in
+       order, and every texture is written before the first record that uses it. */
+    while (ReadCaptureRecord(&reader, &record) && record.type != CAPTURE_END) {
+        if (record.type == CAPTURE_TEXTURE) {
+            if (record.id == 0 || record.id > num_ids + 1) {
+                reader.ok = SDL_FALSE;
+            } else if (record.id == num_ids + 1) {
+                ++num_ids;
+            }
+        } else if (record.type == CAPTURE_TARGET) {
+            if (record.id > num_ids) {
+                reader.ok = SDL_FALSE;
+            }
+        } else if (record.type == CAPTURE_COPY || record.type == CAPTURE_COPY_EX) {
+            if (record.id == 0 || record.id > num_ids) {
+                reader.ok = SDL_FALSE;
+            }
+        }
+    }
+    if (!reader.ok || w <= 0 || h <= 0) {
+        SDL_free(data);
+        SDL_SetError("Render capture is truncated or corrupt");
+        return NULL;
+    }
+
+    capture = (SDL_RenderCapture *)SDL_calloc(1, sizeof (*capture));
+    if (capture) {
+        capture->textures = (SDL_Texture **)SDL_calloc(num_ids + 1, sizeof (*capture->textures));
+        capture->uploaded = (const Uint8 **)SDL_calloc(num_ids + 1, sizeof (*capture->uploaded));
+    }
+    if (!capture || !capture->textures || !capture->uploaded) {
+        SDL_FreeRenderCapture(capture);
+        SDL_free(data);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    capture->data = data;
+    capture->size = size;
+    capture->w = w;
+    capture->h = h;
+    capture->num_ids = num_ids;
+    return capture;
+}
+
+int
+SDL_GetRenderCaptureSize(SDL_RenderCapture * capture, int *w, int *h)
+{
+    if (!capture) {
+        return SDL_InvalidParamError("capture");
+    }
+    if (w) {
+        *w = capture->w;
+    }
+    if (h) {
+        *h = capture->h;
+    }
+    return 0;
+}
+
+static void
+FreeReplayTextures(SDL_RenderCapture *capture)
+{
+    Uint32 id;
+    for (id = 1; id <= capture->num_ids; ++id) {
+        if (capture->textures[id]) {
+            SDL_DestroyTexture(capture->textures[id]);
+            capture->textures[id] = NULL;
+        }
+        capture->uploaded[id] = NULL;
+    }
+}
+
+static int
+ReplayTexture(SDL_Renderer *renderer, SDL_RenderCapture *capture, const SDL_CaptureRecord *record)
+{
+    SDL_Texture *texture = capture->textures[record->id];
+
+    if (texture && (texture->format != record->format || texture->access != (int)record->access ||
+                    texture->w != record->w || texture->h != record->h)) {
+        /* the id was reused for a different texture later in the frame */
+        SDL_DestroyTexture(texture);
+        texture = NULL;
+    }
+    if (!texture) {
+        texture = SDL_CreateTexture(renderer, record->format, (int)record->access, record->w, record->h);
+        capture->textures[record->id] = texture;
+        capture->uploaded[record->id] = NULL;
+        if (!texture) {
+            return -1;
+        }
+        texture->scaleMode = (SDL_ScaleMode)record->scale_mode;
+        if (texture->native) {
+            texture->native->scaleMode = texture->scaleMode;
+        }
+    }
+
+    /* upload only when the contents differ from what the last replay left there */
+    if (capture->uploaded[record->id] != record->pixels) {
+        if (SDL_UpdateTexture(texture, NULL, record->pixels, record->w * SDL_BYTESPERPIXEL(record->format)) < 0) {
+            return -1;
+        }
+        capture->uploaded[record->id] = record->pixels;
+    }
+    return 0;
+}
+
+/* Decodes the little endian floats of a draw record */
+static const void *
+ReplayFloats(SDL_RenderCapture *capture, const SDL_CaptureRecord *record, const int stride)
+{
+    SDL_CaptureReader reader;
+    const size_t num_values = (size_t)record->count * stride;
+    const size_t size = num_values * sizeof (float);
+    float *values;
+    size_t i;
+
+    if (size > capture->scratch_size) {
+        void *scratch = SDL_realloc(capture->scratch, size);
+        if (!scratch) {
+            SDL_OutOfMemory();
+            return NULL;
+        }
+        capture->scratch = scratch;
+        capture->scratch_size = size;
+    }
+
+    reader.p = record->data;
+    reader.end = record->data + size;
+    reader.ok = SDL_TRUE;
+    values = (float *)capture->scratch;
+    for (i = 0; i < num_values; ++i) {
+        values[i] = ReadFloat(&reader);
+    }
+    return values;
+}
+
+static int
+ReplayRecord(SDL_Renderer *renderer, SDL_RenderCapture *capture, const SDL_CaptureRecord *record)
+{
+    const void *values;
+    SDL_Texture *texture;
+
+    switch (record->type) {
+    case CAPTURE_TEXTURE:
+        return ReplayTexture(renderer, capture, record);
+
+    case CAPTURE_TARGET:
+        if (record->id) {
+            /* whatever gets drawn has to be replaced by the next replay */
+            capture->uploaded[record->id] = NULL;
+        }
+        return SDL_SetRenderTarget(renderer, capture->textures[record->id]);
+
+    case CAPTURE_VIEWPORT:
+        return SDL_RenderSetViewport(renderer, &record->rect);
+
+    case CAPTURE_CLIPRECT:
+        return SDL_RenderSetClipRect(renderer, record->enabled ? &record->rect : NULL);
+
+    case CAPTURE_CLEAR:
+        SDL_SetRenderDrawColor(renderer, record->r, record->g, record->b, record->a);
+        return SDL_RenderClear(renderer);
+
+    case CAPTURE_DRAW_POINTS:
+    case CAPTURE_DRAW_LINES:
+    case CAPTURE_FILL_RECTS:
+        values = ReplayFloats(capture, record, (record->type == CAPTURE_FILL_RECTS) ? 4 : 2);
+        if (!values) {
+            return -1;
+        }
+        SDL_SetRenderDrawColor(renderer, record->r, record->g, record->b, record->a);
+        SDL_SetRenderDrawBlendMode(renderer, (SDL_BlendMode)record->blend);
+        if (record->type == CAPTURE_DRAW_POINTS) {
+            return SDL_RenderDrawPointsF(renderer, (const SDL_FPoint *)values, (int)record->count);
+        } else if (record->type == CAPTURE_DRAW_LINES) {
+            return SDL_RenderDrawLinesF(renderer, (const SDL_FPoint *)values, (int)record->count);
+        }
+        return SDL_RenderFillRectsF(renderer, (const SDL_FRect *)values, (int)record->count);
+
+    case CAPTURE_COPY:
+    case CAPTURE_COPY_EX:
+        texture = capture->textures[record->id];
+        if (!texture) {
+            return -1;  /* creating it failed and set the error */
+        }
+        SDL_SetTextureColorMod(texture, record->r, record->g, record->b);
+        SDL_SetTextureAlphaMod(texture, record->a);
+        SDL_SetTextureBlendMode(texture, (SDL_BlendMode)record->blend);
+        if (record->type == CAPTURE_COPY) {
+            return SDL_RenderCopyF(renderer, texture, &record->rect, &record->dstrect);
+        }
+        return SDL_RenderCopyExF(renderer, texture, &record->rect, &record->dstrect,
+                                 record->angle, &record->center, (SDL_RendererFlip)record->flip);
+
+    case CAPTURE_FLUSH:
+        return SDL_RenderFlush(renderer);
+
+    default:
+        break;
+    }
+    return 0;
+}
+
+int
+SDL_RenderReplayCapture(SDL_Renderer * renderer, SDL_RenderCapture * capture)
+{
+    SDL_CaptureReader reader;
+    SDL_CaptureRecord record;
+    SDL_Texture *target;
+    SDL_Rect viewport, clip_rect;
+    SDL_bool clipping_enabled, batching;
+    float scale_x, scale_y;
+    Uint8 r, g, b, a;
+    SDL_BlendMode blendMode;
+    int w, h, retval = 0;
+
+    if (!capture) {
+        return SDL_InvalidParamError("capture");
+    }
+    if (SDL_GetRendererOutputSize(renderer, &w, &h) < 0) {
+        return -1;  /* invalid renderer */
+    }
+
+    if (capture->renderer != renderer) {
+        FreeReplayTextures(capture);
+        capture->renderer = renderer;
+    }
+
+    /* Coordinates were recorded after scaling, and the queue has to be flushed exactly
+       where it was, so replay unscaled and batched and put everything back after. */
+    target = SDL_GetRenderTarget(renderer);
+    SDL_RenderGetScale(renderer, &scale_x, &scale_y);
+    SDL_RenderSetScale(renderer, 1.0f, 1.0f);
+    SDL_RenderGetViewport(renderer, &viewport);
+    SDL_RenderGetClipRect(renderer, &clip_rect);
+    clipping_enabled = SDL_RenderIsClipEnabled(renderer);
+    SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+    SDL_GetRenderDrawBlendMode(renderer, &blendMode);
+    batching = renderer->batching;
+    renderer->batching = SDL_TRUE;
+
+    reader.p = capture->data + CAPTURE_HEADER_SIZE;
+    reader.end = capture->data + capture->size;
+    reader.ok = SDL_TRUE;
+    while (retval == 0 && ReadCaptureRecord(&reader, &record) && record.type != CAPTURE_END) {
+        retval = ReplayRecord(renderer, capture, &record);
+    }
+    if (retval == 0) {
+        retval = SDL_RenderFlush(renderer);
+    }
+
+    renderer->batching = batching;
+    SDL_SetRenderTarget(renderer, target);
+    SDL_RenderSetViewport(renderer, &viewport);
+    SDL_RenderSetClipRect(renderer, clipping_enabled ? &clip_rect : NULL);
+    SDL_RenderSetScale(renderer, scale_x, scale_y);
+    SDL_SetRenderDrawColor(renderer, r, g, b, a);
+    SDL_SetRenderDrawBlendMode(renderer, blendMode);
+    return retval;
+}
+
+void
+SDL_FreeRenderCapture(SDL_RenderCapture * capture)
+{
+    if (!capture) {
+        return;
+    }
+    if (capture->textures) {
+        FreeReplayTextures(capture);
+    }
+    SDL_free(capture->textures);
+    SDL_free(capture->uploaded);
+    SDL_free(capture->scratch);
+    SDL_free(capture->data);
+    SDL_free(capture);
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,53 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2019 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL_rendercapture_c_h_
+#define SDL_rendercapture_c_h_
+
+#include "../SDL_internal.h"
+
+#include "SDL_render.h"
+
+/* Frame capture hooks, called from SDL_render.c only while renderer->capture is set.
+   Everything is recorded as the renderer queues it, after scaling. */
+
+extern int SDL_CaptureBegin(SDL_Renderer * renderer, SDL_RWops * dst, const int w, const int h);
+extern void SDL_CaptureViewport(SDL_Renderer * renderer);
+extern void SDL_CaptureClipRect(SDL_Renderer * renderer);
+extern void SDL_CaptureClear(SDL_Renderer * renderer);
+extern void SDL_CaptureDrawPoints(SDL_Renderer * renderer, const SDL_FPoint * points, const int count);
+extern void SDL_CaptureDrawLines(SDL_Renderer * renderer, const SDL_FPoint * points, const int count);
+extern void SDL_CaptureFillRects(SDL_Renderer * renderer, const SDL_FRect * rects, const int count);
+extern void SDL_CaptureCopy(SDL_Renderer * renderer, SDL_Texture * texture,
+                            const SDL_Rect * srcrect, const SDL_FRect * dstrect);
+extern void SDL_CaptureCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
+                              const SDL_Rect * srcrect, const SDL_FRect * dstrect,
+                              const double angle, const SDL_FPoint *center, const SDL_RendererFlip flip);
+extern void SDL_CaptureRenderTarget(SDL_Renderer * renderer);
+extern void SDL_CaptureFlush(SDL_Renderer * renderer);
+extern int SDL_CapturePresent(SDL_Renderer * renderer);
+extern void SDL_CaptureTextureChanged(SDL_Texture * texture);
+extern void SDL_CaptureTextureDestroyed(SDL_Texture * texture);
+extern void SDL_CaptureAbort(SDL_Renderer * renderer);
+
+#endif /* SDL_rendercapture_c_h_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -60,6 +60,7 @@ struct SDL_Texture
     void *pixels;
     int pitch;
     SDL_Rect locked_rect;
+    SDL_Surface *locked_surface;    /**< SDL_LockTextureToSurface(), kept between locks */
 
     Uint32 last_command_generation; /* last command queue generation this texture was in. */
 
@@ -110,12 +111,15 @@ typedef struct SDL_RenderCommand
     struct SDL_RenderCommand *next;
 } SDL_RenderCommand;
 
-typedef struct SDL_AllocVertGap
+/* A contiguous run of commands in the renderer's frame arena. Blocks are kept
+   for the lifetime of the renderer and rewound every time the queue is flushed. */
+typedef struct SDL_RenderCommandBlock
 {
-    size_t offset;
-    size_t len;
-    struct SDL_AllocVertGap *next;
-} SDL_AllocVertGap;
+    SDL_RenderCommand *commands;
+    size_t capacity;
+    size_t used;
+    struct SDL_RenderCommandBlock *next;
+} SDL_RenderCommandBlock;
 
 
 /* Define the SDL renderer structure */
@@ -135,11 +139,20 @@ struct SDL_Renderer
                             int count);
     int (*QueueFillRects) (SDL_Renderer * renderer, SDL_RenderCommand *cmd, const SDL_FRect * rects,
                             int count);
+    /* Each copy must queue the same amount of vertex data and set count to 1; consecutive
+       compatible copies get merged, so RunCommandQueue must handle COPY and COPY_EX with
+       count > 1. */
     int (*QueueCopy) (SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
                        const SDL_Rect * srcrect, const SDL_FRect * dstrect);
     int (*QueueCopyEx) (SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
                         const SDL_Rect * srcquad, const SDL_FRect * dstrect,
                         const double angle, const SDL_FPoint *center, const SDL_RendererFlip flip);
+    /* Optional: queue count copies as a single command, with one vertex allocation. */
+    int (*QueueCopyBatch) (SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
+                           const SDL_Rect * srcrects, const SDL_FRect * dstrects, const int count);
+    int (*QueueCopyExBatch) (SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
+                             const SDL_Rect * srcrects, const SDL_FRect * dstrects, const double *angles,
+                             const SDL_FPoint *centers, const SDL_RendererFlip *flips, const int count);
     int (*RunCommandQueue) (SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize);
     int (*UpdateTexture) (SDL_Renderer * renderer, SDL_Texture * texture,
                           const SDL_Rect * rect, const void *pixels,
@@ -152,6 +165,8 @@ struct SDL_Renderer
     int (*LockTexture) (SDL_Renderer * renderer, SDL_Texture * texture,
                         const SDL_Rect * rect, void **pixels, int *pitch);
     void (*UnlockTexture) (SDL_Renderer * renderer, SDL_Texture * texture);
+    /* Optional: copy the whole texture out as texture->format, used by frame capture. */
+    int (*ReadTexture) (SDL_Renderer * renderer, SDL_Texture * texture, void *pixels, int pitch);
     int (*SetRenderTarget) (SDL_Renderer * renderer, SDL_Texture * texture);
     int (*RenderReadPixels) (SDL_Renderer * renderer, const SDL_Rect * rect,
                              Uint32 format, void * pixels, int pitch);
@@ -213,7 +228,10 @@ struct SDL_Renderer
     SDL_bool batching;
     SDL_RenderCommand *render_commands;
     SDL_RenderCommand *render_commands_tail;
-    SDL_RenderCommand *render_commands_pool;
+    SDL_RenderCommandBlock *render_command_blocks;
+    SDL_RenderCommandBlock *render_command_block;   /* block currently being allocated from */
+    size_t render_commands_queued;
+    size_t render_commands_high_water;
     Uint32 render_command_generation;
     Uint32 last_queued_color;
     SDL_Rect last_queued_viewport;
@@ -226,8 +244,18 @@ struct SDL_Renderer
     void *vertex_data;
     size_t vertex_data_used;
     size_t vertex_data_allocation;
-    SDL_AllocVertGap vertex_data_gaps;
-    SDL_AllocVertGap *vertex_data_gaps_pool;
+    size_t vertex_data_high_water;
+
+    /* counters for the frame being drawn, and the last one presented */
+    SDL_RenderStats stats;
+    SDL_RenderStats last_stats;
+    SDL_Texture *stats_texture;
+    SDL_BlendMode stats_blend;
+    SDL_bool stats_drawn;
+
+    /* frame capture in progress, see SDL_rendercapture.c */
+    struct SDL_RenderCaptureState *capture;
+    int capture_status;         /* -1 if the last captured frame wasn't all written */
 
     void *driverdata;
 };
@@ -262,7 +290,8 @@ extern SDL_BlendOperation SDL_GetBlendModeAlphaOperation(SDL_BlendMode blendMode
 
 /* drivers call this during their Queue*() methods to make space in a array that are used
    for a vertex buffer during RunCommandQueue(). Pointers returned here are only valid until
-   the next call, because it might be in an array that gets realloc()'d. */
+   the next call, because it might be in an array that gets realloc()'d. Space is handed out
+   linearly, so consecutive calls return adjacent ranges unless alignment padding is needed. */
 extern void *SDL_AllocateRenderVertices(SDL_Renderer *renderer, const size_t numbytes, const size_t alignment, size_t *offset);
 
 #endif /* SDL_sysrender_h_ */
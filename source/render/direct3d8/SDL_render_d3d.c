@@ -87,9 +87,15 @@ typedef struct
     D3D_DrawStateCache drawstate;
 } D3D_RenderData;
 
+/* Areas of the staging texture to copy to video memory before it is next used,
+   merged into one box when there are more than this */
+#define D3D_MAX_DIRTY_RECTS 8
+
 typedef struct
 {
     SDL_bool dirty;
+    SDL_Rect dirty_rects[D3D_MAX_DIRTY_RECTS];
+    int num_dirty_rects;
     int w, h;
     DWORD usage;
     Uint32 format;
@@ -401,12 +407,52 @@ D3D_SupportsBlendMode(SDL_Renderer * renderer, SDL_BlendMode blendMode)
     return SDL_TRUE;
 }
 
+static void
+D3D_AddDirtyRect(D3D_TextureRep *texture, int x, int y, int w, int h)
+{
+    SDL_Rect rect;
+    int i;
+
+    if (w <= 0 || h <= 0) {
+        return;
+    }
+    if (!texture->dirty) {
+        texture->num_dirty_rects = 0;
+        texture->dirty = SDL_TRUE;
+    }
+
+    rect.x = x;
+    rect.y = y;
+    rect.w = w;
+    rect.h = h;
+
+    for (i = 0; i < texture->num_dirty_rects; ++i) {
+        SDL_Rect *dirty = &texture->dirty_rects[i];
+        if (rect.x >= dirty->x && rect.y >= dirty->y &&
+            rect.x + rect.w <= dirty->x + dirty->w &&
+            rect.y + rect.h <= dirty->y + dirty->h) {
+            return;
+        }
+    }
+
+    if (texture->num_dirty_rects == D3D_MAX_DIRTY_RECTS) {
+        for (i = 1; i < texture->num_dirty_rects; ++i) {
+            SDL_UnionRect(&texture->dirty_rects[0], &texture->dirty_rects[i], &texture->dirty_rects[0]);
+        }
+        SDL_UnionRect(&texture->dirty_rects[0], &rect, &texture->dirty_rects[0]);
+        texture->num_dirty_rects = 1;
+    } else {
+        texture->dirty_rects[texture->num_dirty_rects++] = rect;
+    }
+}
+
 static int
 D3D_CreateTextureRep(IDirect3DDevice8 *device, D3D_TextureRep *texture, DWORD usage, Uint32 format, D3DFORMAT d3dfmt, int w, int h)
 {
     HRESULT result;
 
     texture->dirty = SDL_FALSE;
+    texture->num_dirty_rects = 0;
     texture->w = w;
     texture->h = h;
     texture->usage = usage;
@@ -452,7 +498,9 @@ D3D_RecreateTextureRep(IDirect3DDevice8 *device, D3D_TextureRep *texture)
         // We can't use this as we are uisng our own UpdateTexture()
         IDirect3DTexture8_AddDirtyRect(texture->staging, NULL);
 #endif
-        texture->dirty = SDL_TRUE;
+        /* The video memory copy is gone, so all of it has to be uploaded again */
+        texture->dirty = SDL_FALSE;
+        D3D_AddDirtyRect(texture, 0, 0, texture->w, texture->h);
     }
     return 0;
 }
@@ -503,7 +551,7 @@ D3D_UpdateTextureRep(IDirect3DDevice8 *device, D3D_TextureRep *texture, int x, i
     if (FAILED(result)) {
         return D3D_SetError("UnlockRect()", result);
     }
-    texture->dirty = SDL_TRUE;
+    D3D_AddDirtyRect(texture, x, y, w, h);
 
     return 0;
 }
@@ -716,74 +764,111 @@ D3D_UnlockTexture(SDL_Renderer * renderer, SDL_Texture * texture)
                       rect->x * SDL_BYTESPERPIXEL(texture->format));
         D3D_UpdateTexture(renderer, texture, rect, pixels, texturedata->pitch);
     } else {
+        const SDL_Rect *rect = &texturedata->locked_rect;
+
         IDirect3DTexture8_UnlockRect(texturedata->texture.staging, 0);
-        texturedata->texture.dirty = SDL_TRUE;
+        D3D_AddDirtyRect(&texturedata->texture, rect->x, rect->y, rect->w, rect->h);
         if (data->drawstate.texture == texture) {
             data->drawstate.texture = NULL;
         }
    }
 }
 
-int D3D8_UpdateTexture(IDirect3DTexture8* srcTexture, IDirect3DTexture8* dstTexture)
+static int
+D3D_ReadTexture(SDL_Renderer * renderer, SDL_Texture * texture, void *pixels, int pitch)
+{
+    D3D_TextureData *texturedata = (D3D_TextureData *)texture->driverdata;
+    D3DLOCKED_RECT locked;
+    HRESULT result;
+    const Uint8 *src;
+    Uint8 *dst;
+    int row, length;
+
+    if (!texturedata) {
+        return SDL_SetError("Texture is not currently available");
+    }
+
+    /* The staging copy holds whatever was last uploaded; render targets only live in video memory */
+    if (texturedata->yuv || !texturedata->texture.staging) {
+        return SDL_Unsupported();
+    }
+
+    result = IDirect3DTexture8_LockRect(texturedata->texture.staging, 0, &locked, NULL, D3DLOCK_READONLY);
+    if (FAILED(result)) {
+        return D3D_SetError("LockRect()", result);
+    }
+
+    src = (const Uint8 *)locked.pBits;
+    dst = (Uint8 *)pixels;
+    length = texture->w * SDL_BYTESPERPIXEL(texture->format);
+    for (row = 0; row < texture->h; ++row) {
+        SDL_memcpy(dst, src, length);
+        src += locked.Pitch;
+        dst += pitch;
+    }
+
+    IDirect3DTexture8_UnlockRect(texturedata->texture.staging, 0);
+    return 0;
+}
+
+/* Copies the dirty rects of the staging texture into the video memory one */
+static int
+D3D8_UpdateTexture(D3D_TextureRep *texture)
 {
 	LPDIRECT3DSURFACE8 srcSurface;
 	D3DLOCKED_RECT srcLockrect;
 	D3DLOCKED_RECT destLockrect;
-	D3DSURFACE_DESC desc;
-	char* srcData, *dstData;
-	int result;
+	const Uint8 *srcData;
+	Uint8 *dstData;
+	int bpp, i, row, length;
+	HRESULT result;
 
-	result = IDirect3DTexture8_GetSurfaceLevel(srcTexture, 0, &srcSurface); 
+	result = IDirect3DTexture8_GetSurfaceLevel(texture->staging, 0, &srcSurface);
 	if (FAILED(result))
 		return D3D_SetError("D3D8_UpdateTexture()", result);
 
-	result = IDirect3DSurface8_GetDesc(srcSurface, &desc);
-	if (FAILED(result))
-		return D3D_SetError("D3D8_UpdateTexture()", result);
-
-	result = IDirect3DSurface8_LockRect(srcSurface, &srcLockrect, NULL, 0);
-	if (FAILED(result))
+	result = IDirect3DSurface8_LockRect(srcSurface, &srcLockrect, NULL, D3DLOCK_READONLY);
+	if (FAILED(result)) {
+		IDirect3DSurface8_Release(srcSurface);
 		return D3D_SetError("D3D8_UpdateTexture()", result);
+	}
 
-	result = IDirect3DTexture8_LockRect(dstTexture, 0, &destLockrect, NULL, 0);
-	if (FAILED(result))
+	result = IDirect3DTexture8_LockRect(texture->texture, 0, &destLockrect, NULL, 0);
+	if (FAILED(result)) {
+		IDirect3DSurface8_UnlockRect(srcSurface);
+		IDirect3DSurface8_Release(srcSurface);
 		return D3D_SetError("D3D8_UpdateTexture()", result);
+	}
 
-	srcData = (char *) srcLockrect.pBits;
-	dstData = (char *) destLockrect.pBits;
-
-	// NOTE: DirectX 9 docs say that the UpdateTexture() function
-	//       can only take textures in the same format so I think
-	//       we are ok to hardcode 4 bytes for source and destination
-	//       without checking they match first
-
-#if 0 // Slow AF!!
-	for (y = 0; y < (int)desc.Height; y++)
-	{
-		for (x = 0; x < (int)desc.Width; x++)
-		{
-			dstData[0] = srcData[0];
-			dstData[1] = srcData[1];
-			dstData[2] = srcData[2];
-			dstData[3] = srcData[3];
-			
-			srcData += 4;
-			dstData += 4;
+	// NOTE: Both textures are created from the same format, so the
+	//       rows only differ in their pitch. Only the areas written
+	//       since the last upload are copied, as a whole texture is
+	//       a lot of memory to move for a few changed rows.
+
+	bpp = SDL_BYTESPERPIXEL(texture->format);
+	for (i = 0; i < texture->num_dirty_rects; ++i) {
+		const SDL_Rect *rect = &texture->dirty_rects[i];
+
+		srcData = (const Uint8 *) srcLockrect.pBits + rect->y * srcLockrect.Pitch + rect->x * bpp;
+		dstData = (Uint8 *) destLockrect.pBits + rect->y * destLockrect.Pitch + rect->x * bpp;
+		length = rect->w * bpp;
+
+		if (length == srcLockrect.Pitch && length == destLockrect.Pitch) {
+			SDL_memcpy(dstData, srcData, length * rect->h);
+		} else {
+			for (row = 0; row < rect->h; ++row) {
+				SDL_memcpy(dstData, srcData, length);
+				srcData += srcLockrect.Pitch;
+				dstData += destLockrect.Pitch;
+			}
 		}
 	}
-#else // Much faster!
-	memcpy(dstData, srcData, desc.Width*desc.Height*4);
-#endif
-
-	result = IDirect3DSurface8_UnlockRect(srcSurface);
-	if (FAILED(result))
-		return D3D_SetError("D3D8_UpdateTexture()", result);
+	texture->num_dirty_rects = 0;
 
-	result = IDirect3DSurface8_Release(srcSurface);
-	if (FAILED(result))
-		return D3D_SetError("D3D8_UpdateTexture()", result);
+	IDirect3DSurface8_UnlockRect(srcSurface);
+	IDirect3DSurface8_Release(srcSurface);
 
-	result = IDirect3DTexture8_UnlockRect(dstTexture, 0);
+	result = IDirect3DTexture8_UnlockRect(texture->texture, 0);
 	if (FAILED(result))
 		return D3D_SetError("D3D8_UpdateTexture()", result);
 
@@ -828,7 +913,7 @@ D3D_SetRenderTargetInternal(SDL_Renderer * renderer, SDL_Texture * texture)
         }
 
 #ifdef _XBOX
-		result = D3D8_UpdateTexture(texturerep->staging, texturerep->texture);
+		result = D3D8_UpdateTexture(texturerep);
 #else
         result = IDirect3DDevice9_UpdateTexture(device, (IDirect3DBaseTexture9 *)texturerep->staging, (IDirect3DBaseTexture9 *)texturerep->texture);
 #endif
@@ -939,21 +1024,11 @@ D3D_QueueFillRects(SDL_Renderer * renderer, SDL_RenderCommand *cmd, const SDL_FR
     return 0;
 }
 
-static int
-D3D_QueueCopy(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
-                          const SDL_Rect * srcrect, const SDL_FRect * dstrect)
+static void
+SetCopyVerts(Vertex *verts, const DWORD color, const SDL_Rect * srcrect, const SDL_FRect * dstrect)
 {
-    const DWORD color = D3DCOLOR_ARGB(cmd->data.draw.a, cmd->data.draw.r, cmd->data.draw.g, cmd->data.draw.b);
     float minx, miny, maxx, maxy;
     float minu, maxu, minv, maxv;
-    const size_t vertslen = sizeof (Vertex) * 4;
-    Vertex *verts = (Vertex *) SDL_AllocateRenderVertices(renderer, vertslen, 0, &cmd->data.draw.first);
-
-    if (!verts) {
-        return -1;
-    }
-
-    cmd->data.draw.count = 1;
 
     minx = dstrect->x - 0.5f;
     miny = dstrect->y - 0.5f;
@@ -1009,27 +1084,56 @@ D3D_QueueCopy(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * tex
     verts->color = color;
     verts->u = minu;//(float)0; //minu;
     verts->v = maxv;//(float)texture->h; //maxv;
-    verts++;
+}
+
+static int
+D3D_QueueCopy(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
+                          const SDL_Rect * srcrect, const SDL_FRect * dstrect)
+{
+    const DWORD color = D3DCOLOR_ARGB(cmd->data.draw.a, cmd->data.draw.r, cmd->data.draw.g, cmd->data.draw.b);
+    const size_t vertslen = sizeof (Vertex) * 4;
+    Vertex *verts = (Vertex *) SDL_AllocateRenderVertices(renderer, vertslen, 0, &cmd->data.draw.first);
+
+    if (!verts) {
+        return -1;
+    }
+
+    cmd->data.draw.count = 1;
+
+    SetCopyVerts(verts, color, srcrect, dstrect);
 
     return 0;
 }
 
 static int
-D3D_QueueCopyEx(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
-                        const SDL_Rect * srcquad, const SDL_FRect * dstrect,
-                        const double angle, const SDL_FPoint *center, const SDL_RendererFlip flip)
+D3D_QueueCopyBatch(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
+                   const SDL_Rect * srcrects, const SDL_FRect * dstrects, const int count)
 {
     const DWORD color = D3DCOLOR_ARGB(cmd->data.draw.a, cmd->data.draw.r, cmd->data.draw.g, cmd->data.draw.b);
-    float minx, miny, maxx, maxy;
-    float minu, maxu, minv, maxv;
-    const size_t vertslen = sizeof (Vertex) * 5;
+    const size_t vertslen = sizeof (Vertex) * 4 * count;
     Vertex *verts = (Vertex *) SDL_AllocateRenderVertices(renderer, vertslen, 0, &cmd->data.draw.first);
+    int i;
 
     if (!verts) {
         return -1;
     }
 
-    cmd->data.draw.count = 1;
+    cmd->data.draw.count = count;
+
+    for (i = 0; i < count; i++, verts += 4) {
+        SetCopyVerts(verts, color, &srcrects[i], &dstrects[i]);
+    }
+
+    return 0;
+}
+
+static void
+SetCopyExVerts(Vertex *verts, const DWORD color, SDL_Texture * texture,
+               const SDL_Rect * srcquad, const SDL_FRect * dstrect,
+               const double angle, const SDL_FPoint *center, const SDL_RendererFlip flip)
+{
+    float minx, miny, maxx, maxy;
+    float minu, maxu, minv, maxv;
 
     minx = -center->x;
     maxx = dstrect->w - center->x;
@@ -1095,7 +1199,47 @@ D3D_QueueCopyEx(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * t
     verts->color = 0;
     verts->u = verts->x; //0.0f;
     verts->v = verts->y; //0.0f;
-    verts++;
+}
+
+static int
+D3D_QueueCopyEx(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
+                        const SDL_Rect * srcquad, const SDL_FRect * dstrect,
+                        const double angle, const SDL_FPoint *center, const SDL_RendererFlip flip)
+{
+    const DWORD color = D3DCOLOR_ARGB(cmd->data.draw.a, cmd->data.draw.r, cmd->data.draw.g, cmd->data.draw.b);
+    const size_t vertslen = sizeof (Vertex) * 5;
+    Vertex *verts = (Vertex *) SDL_AllocateRenderVertices(renderer, vertslen, 0, &cmd->data.draw.first);
+
+    if (!verts) {
+        return -1;
+    }
+
+    cmd->data.draw.count = 1;
+
+    SetCopyExVerts(verts, color, texture, srcquad, dstrect, angle, center, flip);
+
+    return 0;
+}
+
+static int
+D3D_QueueCopyExBatch(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
+                     const SDL_Rect * srcquads, const SDL_FRect * dstrects, const double *angles,
+                     const SDL_FPoint *centers, const SDL_RendererFlip *flips, const int count)
+{
+    const DWORD color = D3DCOLOR_ARGB(cmd->data.draw.a, cmd->data.draw.r, cmd->data.draw.g, cmd->data.draw.b);
+    const size_t vertslen = sizeof (Vertex) * 5 * count;
+    Vertex *verts = (Vertex *) SDL_AllocateRenderVertices(renderer, vertslen, 0, &cmd->data.draw.first);
+    int i;
+
+    if (!verts) {
+        return -1;
+    }
+
+    cmd->data.draw.count = count;
+
+    for (i = 0; i < count; i++, verts += 5) {
+        SetCopyExVerts(verts, color, texture, &srcquads[i], &dstrects[i], angles[i], &centers[i], flips[i]);
+    }
 
     return 0;
 }
@@ -1114,7 +1258,7 @@ UpdateDirtyTexture(IDirect3DDevice8 *device, D3D_TextureRep *texture)
         }
 
 #ifdef _XBOX
-		result = D3D8_UpdateTexture(texture->staging, texture->texture);
+		result = D3D8_UpdateTexture(texture);
 #else//ifdef _DX9
         result = IDirect3DDevice9_UpdateTexture((IDirect3DBaseTexture9 *)texture->staging, (IDirect3DBaseTexture9 *)texture->texture);
 #endif
@@ -1319,6 +1463,33 @@ SetDrawState(D3D_RenderData *data, const SDL_RenderCommand *cmd)
     return 0;
 }
 
+/* Draws count quads of 4 vertices each, starting at byte offset first. */
+static void
+DrawQuads(D3D_RenderData *data, LPDIRECT3DVERTEXBUFFER8 vbo, const void *vertices, const size_t first, const size_t count)
+{
+#ifdef _XBOX
+    /* The Xbox can take a whole run of quads, like merged copies, in a single call. */
+    if (vbo) {
+        IDirect3DDevice8_DrawPrimitive(data->device, D3DPT_QUADLIST, (UINT) (first / sizeof (Vertex)), (UINT) count);
+    } else {
+        IDirect3DDevice8_DrawPrimitiveUP(data->device, D3DPT_QUADLIST, (UINT) count, ((const Uint8 *) vertices) + first, sizeof (Vertex));
+    }
+#else
+    size_t i;
+    if (vbo) {
+        size_t offset = 0;
+        for (i = 0; i < count; ++i, offset += 4) {
+            IDirect3DDevice8_DrawPrimitive(data->device, D3DPT_TRIANGLEFAN, (UINT) ((first / sizeof (Vertex)) + offset), 2);
+        }
+    } else {
+        const Vertex *verts = (const Vertex *) (((const Uint8 *) vertices) + first);
+        for (i = 0; i < count; ++i, verts += 4) {
+            IDirect3DDevice8_DrawPrimitiveUP(data->device, D3DPT_TRIANGLEFAN, 2, verts, sizeof (Vertex));
+        }
+    }
+#endif
+}
+
 static int
 D3D_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize)
 {
@@ -1326,7 +1497,6 @@ D3D_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *verti
     const int vboidx = data->currentVertexBuffer;
     LPDIRECT3DVERTEXBUFFER8 vbo = NULL;
     const SDL_bool istarget = renderer->target != NULL;
-    size_t i;
 
     if (D3D_ActivateRenderer(renderer) < 0) {
         return -1;
@@ -1478,17 +1648,7 @@ D3D_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *verti
                 const size_t count = cmd->data.draw.count;
                 const size_t first = cmd->data.draw.first;
                 SetDrawState(data, cmd);
-                if (vbo) {
-                    size_t offset = 0;
-                    for (i = 0; i < count; ++i, offset += 4) {
-                        IDirect3DDevice8_DrawPrimitive(data->device, D3DPT_TRIANGLEFAN, (UINT) ((first / sizeof (Vertex)) + offset), 2);
-                    }
-                } else {
-                    const Vertex *verts = (Vertex *) (((Uint8 *) vertices) + first);
-                    for (i = 0; i < count; ++i, verts += 4) {
-                        IDirect3DDevice8_DrawPrimitiveUP(data->device, D3DPT_TRIANGLEFAN, 2, verts, sizeof (Vertex));
-                    }
-                }
+                DrawQuads(data, vbo, vertices, first, count);
                 break;
             }
 
@@ -1496,36 +1656,32 @@ D3D_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *verti
                 const size_t count = cmd->data.draw.count;
                 const size_t first = cmd->data.draw.first;
                 SetDrawState(data, cmd);
-                if (vbo) {
-                    size_t offset = 0;
-                    for (i = 0; i < count; ++i, offset += 4) {
-                      IDirect3DDevice8_DrawPrimitive(data->device, D3DPT_TRIANGLEFAN, (UINT) ((first / sizeof (Vertex)) + offset), 2);
-                    }
-                } else {
-                    const Vertex *verts = (Vertex *) (((Uint8 *) vertices) + first);
-                    for (i = 0; i < count; ++i, verts += 4) {
-                        IDirect3DDevice8_DrawPrimitiveUP(data->device, D3DPT_TRIANGLEFAN, 2, verts, sizeof (Vertex));					
-                    }
-                }
+                DrawQuads(data, vbo, vertices, first, count);
                 break;
             }
 
             case SDL_RENDERCMD_COPY_EX: {
-                const size_t first = cmd->data.draw.first;
+                const size_t count = cmd->data.draw.count;
+                size_t first = cmd->data.draw.first;
                 const Vertex *verts = (Vertex *) (((Uint8 *) vertices) + first);
-                const Vertex *transvert = verts + 4;
-                const float translatex = transvert->x;
-                const float translatey = transvert->y;
-                const float rotation = transvert->z;
-                const Float4X4 d3dmatrix = MatrixMultiply(MatrixRotationZ(rotation), MatrixTranslation(translatex, translatey, 0));
+                size_t i;
                 SetDrawState(data, cmd);
 
-                IDirect3DDevice8_SetTransform(data->device, D3DTS_VIEW, (D3DMATRIX*)&d3dmatrix);
+                /* each sprite is a quad followed by its transform. */
+                for (i = 0; i < count; ++i, verts += 5, first += 5 * sizeof (Vertex)) {
+                    const Vertex *transvert = verts + 4;
+                    const float translatex = transvert->x;
+                    const float translatey = transvert->y;
+                    const float rotation = transvert->z;
+                    const Float4X4 d3dmatrix = MatrixMultiply(MatrixRotationZ(rotation), MatrixTranslation(translatex, translatey, 0));
 
-                if (vbo) {
-                    IDirect3DDevice8_DrawPrimitive(data->device, D3DPT_TRIANGLEFAN, (UINT) (first / sizeof (Vertex)), 2);
-                } else {
-                    IDirect3DDevice8_DrawPrimitiveUP(data->device, D3DPT_TRIANGLEFAN, 2, verts, sizeof (Vertex));
+                    IDirect3DDevice8_SetTransform(data->device, D3DTS_VIEW, (D3DMATRIX*)&d3dmatrix);
+
+                    if (vbo) {
+                        IDirect3DDevice8_DrawPrimitive(data->device, D3DPT_TRIANGLEFAN, (UINT) (first / sizeof (Vertex)), 2);
+                    } else {
+                        IDirect3DDevice8_DrawPrimitiveUP(data->device, D3DPT_TRIANGLEFAN, 2, verts, sizeof (Vertex));
+                    }
                 }
                 break;
             }
@@ -1823,6 +1979,7 @@ D3D_CreateRenderer(SDL_Window * window, Uint32 flags)
     renderer->UpdateTextureYUV = D3D_UpdateTextureYUV;
     renderer->LockTexture = D3D_LockTexture;
     renderer->UnlockTexture = D3D_UnlockTexture;
+    renderer->ReadTexture = D3D_ReadTexture;
     renderer->SetRenderTarget = D3D_SetRenderTarget;
     renderer->QueueSetViewport = D3D_QueueSetViewport;
     renderer->QueueSetDrawColor = D3D_QueueSetViewport;  /* SetViewport and SetDrawColor are (currently) no-ops. */
@@ -1831,6 +1988,8 @@ D3D_CreateRenderer(SDL_Window * window, Uint32 flags)
     renderer->QueueFillRects = D3D_QueueFillRects;
     renderer->QueueCopy = D3D_QueueCopy;
     renderer->QueueCopyEx = D3D_QueueCopyEx;
+    renderer->QueueCopyBatch = D3D_QueueCopyBatch;
+    renderer->QueueCopyExBatch = D3D_QueueCopyExBatch;
     renderer->RunCommandQueue = D3D_RunCommandQueue;
     renderer->RenderReadPixels = D3D_RenderReadPixels;
     renderer->RenderPresent = D3D_RenderPresent;
@@ -26,6 +26,9 @@
 #include "SDL_render_sw_c.h"
 #include "SDL_hints.h"
 #include "SDL_assert.h"
+#include "SDL_cpuinfo.h"
+#include "../../thread/SDL_threadpool_c.h"
+#include "../../video/SDL_pixels_c.h"
 
 #include "SDL_draw.h"
 #include "SDL_blendfillrect.h"
@@ -33,7 +36,6 @@
 #include "SDL_blendpoint.h"
 #include "SDL_drawline.h"
 #include "SDL_drawpoint.h"
-#include "SDL_rotate.h"
 
 /* SDL surface based renderer implementation */
 
@@ -44,10 +46,41 @@ typedef struct
     SDL_bool surface_cliprect_dirty;
 } SW_DrawStateCache;
 
+/* Past this many separate areas, the closest two get merged */
+#define SW_MAX_DIRTY_RECTS  16
+
+/* Bands shorter than this aren't worth handing to another thread */
+#define SW_MIN_BAND_HEIGHT  32
+
+/* How many commands are collected before the bands are drawn */
+#define SW_MAX_BAND_JOBS    256
+
+typedef struct
+{
+    const SDL_RenderCommand *cmd;
+    SDL_Rect clip;              /* the viewport and clip rect in effect, on the surface */
+} SW_BandJob;
+
 typedef struct
 {
     SDL_Surface *surface;
     SDL_Surface *window;
+
+    /* The parts of the window surface drawn since the last present */
+    SDL_Rect dirty[SW_MAX_DIRTY_RECTS];
+    int num_dirty;
+    SDL_bool dirty_all;
+
+    /* Commands waiting to be drawn a band at a time on the pool */
+    SDL_ThreadPool *pool;
+    SDL_Surface *band_surface;
+    void *band_vertices;
+    int num_bands;
+    SW_BandJob jobs[SW_MAX_BAND_JOBS];
+    int num_jobs;
+
+    /* Rows of rotated copies are gathered here, kept between copies */
+    SDL_Surface *copyex_row;
 } SW_RenderData;
 
 
@@ -76,9 +109,17 @@ SW_WindowEvent(SDL_Renderer * renderer, const SDL_WindowEvent *event)
     if (event->event == SDL_WINDOWEVENT_SIZE_CHANGED) {
         data->surface = NULL;
         data->window = NULL;
+        data->dirty_all = SDL_TRUE;
     }
 }
 
+static SDL_bool
+SW_SupportsBlendMode(SDL_Renderer * renderer, SDL_BlendMode blendMode)
+{
+    /* Surfaces can blend premultiplied alpha as well as the standard modes */
+    return (blendMode == SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+}
+
 static int
 SW_GetOutputSize(SDL_Renderer * renderer, int *w, int *h)
 {
@@ -179,6 +220,23 @@ SW_UnlockTexture(SDL_Renderer * renderer, SDL_Texture * texture)
 {
 }
 
+static int
+SW_ReadTexture(SDL_Renderer * renderer, SDL_Texture * texture, void *pixels, int pitch)
+{
+    SDL_Surface *surface = (SDL_Surface *) texture->driverdata;
+    int retval;
+
+    /* RLE encoded textures may have let go of their pixels */
+    if(SDL_MUSTLOCK(surface))
+        SDL_LockSurface(surface);
+    retval = SDL_ConvertPixels(surface->w, surface->h, surface->format->format,
+                               surface->pixels, surface->pitch,
+                               texture->format, pixels, pitch);
+    if(SDL_MUSTLOCK(surface))
+        SDL_UnlockSurface(surface);
+    return retval;
+}
+
 static int
 SW_SetRenderTarget(SDL_Renderer * renderer, SDL_Texture * texture)
 {
@@ -261,6 +319,23 @@ SW_QueueFillRects(SDL_Renderer * renderer, SDL_RenderCommand *cmd, const SDL_FRe
     return 0;
 }
 
+static void
+SetCopyVerts(SDL_Renderer * renderer, SDL_Rect *verts, const SDL_Rect * srcrect, const SDL_FRect * dstrect)
+{
+    SDL_memcpy(verts, srcrect, sizeof (SDL_Rect));
+    verts++;
+
+    if (renderer->viewport.x || renderer->viewport.y) {
+        verts->x = (int)(renderer->viewport.x + dstrect->x);
+        verts->y = (int)(renderer->viewport.y + dstrect->y);
+    } else {
+        verts->x = (int)dstrect->x;
+        verts->y = (int)dstrect->y;
+    }
+    verts->w = (int)dstrect->w;
+    verts->h = (int)dstrect->h;
+}
+
 static int
 SW_QueueCopy(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
              const SDL_Rect * srcrect, const SDL_FRect * dstrect)
@@ -273,18 +348,27 @@ SW_QueueCopy(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * text
 
     cmd->data.draw.count = 1;
 
-    SDL_memcpy(verts, srcrect, sizeof (SDL_Rect));
-    verts++;
+    SetCopyVerts(renderer, verts, srcrect, dstrect);
 
-    if (renderer->viewport.x || renderer->viewport.y) {
-        verts->x = (int)(renderer->viewport.x + dstrect->x);
-        verts->y = (int)(renderer->viewport.y + dstrect->y);
-    } else {
-        verts->x = (int)dstrect->x;
-        verts->y = (int)dstrect->y;
+    return 0;
+}
+
+static int
+SW_QueueCopyBatch(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
+                  const SDL_Rect * srcrects, const SDL_FRect * dstrects, const int count)
+{
+    SDL_Rect *verts = (SDL_Rect *) SDL_AllocateRenderVertices(renderer, count * 2 * sizeof (SDL_Rect), 0, &cmd->data.draw.first);
+    int i;
+
+    if (!verts) {
+        return -1;
+    }
+
+    cmd->data.draw.count = count;
+
+    for (i = 0; i < count; i++, verts += 2) {
+        SetCopyVerts(renderer, verts, &srcrects[i], &dstrects[i]);
     }
-    verts->w = (int)dstrect->w;
-    verts->h = (int)dstrect->h;
 
     return 0;
 }
@@ -298,19 +382,10 @@ typedef struct CopyExData
     SDL_RendererFlip flip;
 } CopyExData;
 
-static int
-SW_QueueCopyEx(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
-               const SDL_Rect * srcrect, const SDL_FRect * dstrect,
-               const double angle, const SDL_FPoint *center, const SDL_RendererFlip flip)
+static void
+SetCopyExData(SDL_Renderer * renderer, CopyExData *verts, const SDL_Rect * srcrect, const SDL_FRect * dstrect,
+              const double angle, const SDL_FPoint *center, const SDL_RendererFlip flip)
 {
-    CopyExData *verts = (CopyExData *) SDL_AllocateRenderVertices(renderer, sizeof (CopyExData), 0, &cmd->data.draw.first);
-
-    if (!verts) {
-        return -1;
-    }
-
-    cmd->data.draw.count = 1;
-
     SDL_memcpy(&verts->srcrect, srcrect, sizeof (SDL_Rect));
 
     if (renderer->viewport.x || renderer->viewport.y) {
@@ -325,235 +400,351 @@ SW_QueueCopyEx(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * te
     verts->angle = angle;
     SDL_memcpy(&verts->center, center, sizeof (SDL_FPoint));
     verts->flip = flip;
-
-    return 0;
 }
 
 static int
-SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Surface *surface, SDL_Texture * texture,
-                const SDL_Rect * srcrect, const SDL_Rect * final_rect,
-                const double angle, const SDL_FPoint * center, const SDL_RendererFlip flip)
+SW_QueueCopyEx(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
+               const SDL_Rect * srcrect, const SDL_FRect * dstrect,
+               const double angle, const SDL_FPoint *center, const SDL_RendererFlip flip)
 {
-    SDL_Surface *src = (SDL_Surface *) texture->driverdata;
-    SDL_Rect tmp_rect;
-    SDL_Surface *src_clone, *src_rotated, *src_scaled;
-    SDL_Surface *mask = NULL, *mask_rotated = NULL;
-    int retval = 0, dstwidth, dstheight, abscenterx, abscentery;
-    double cangle, sangle, px, py, p1x, p1y, p2x, p2y, p3x, p3y, p4x, p4y;
-    SDL_BlendMode blendmode;
-    Uint8 alphaMod, rMod, gMod, bMod;
-    int applyModulation = SDL_FALSE;
-    int blitRequired = SDL_FALSE;
-    int isOpaque = SDL_FALSE;
+    CopyExData *verts = (CopyExData *) SDL_AllocateRenderVertices(renderer, sizeof (CopyExData), 0, &cmd->data.draw.first);
 
-    if (!surface) {
+    if (!verts) {
         return -1;
     }
 
-    tmp_rect.x = 0;
-    tmp_rect.y = 0;
-    tmp_rect.w = final_rect->w;
-    tmp_rect.h = final_rect->h;
+    cmd->data.draw.count = 1;
 
-    /* It is possible to encounter an RLE encoded surface here and locking it is
-     * necessary because this code is going to access the pixel buffer directly.
-     */
-    if (SDL_MUSTLOCK(src)) {
-        SDL_LockSurface(src);
-    }
+    SetCopyExData(renderer, verts, srcrect, dstrect, angle, center, flip);
 
-    /* Clone the source surface but use its pixel buffer directly.
-     * The original source surface must be treated as read-only.
-     */
-    src_clone = SDL_CreateRGBSurfaceFrom(src->pixels, src->w, src->h, src->format->BitsPerPixel, src->pitch,
-                                         src->format->Rmask, src->format->Gmask,
-                                         src->format->Bmask, src->format->Amask);
-    if (src_clone == NULL) {
-        if (SDL_MUSTLOCK(src)) {
-            SDL_UnlockSurface(src);
-        }
+    return 0;
+}
+
+static int
+SW_QueueCopyExBatch(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
+                    const SDL_Rect * srcrects, const SDL_FRect * dstrects, const double *angles,
+                    const SDL_FPoint *centers, const SDL_RendererFlip *flips, const int count)
+{
+    CopyExData *verts = (CopyExData *) SDL_AllocateRenderVertices(renderer, count * sizeof (CopyExData), 0, &cmd->data.draw.first);
+    int i;
+
+    if (!verts) {
         return -1;
     }
 
-    SDL_GetSurfaceBlendMode(src, &blendmode);
-    SDL_GetSurfaceAlphaMod(src, &alphaMod);
-    SDL_GetSurfaceColorMod(src, &rMod, &gMod, &bMod);
+    cmd->data.draw.count = count;
 
-    /* SDLgfx_rotateSurface only accepts 32-bit surfaces with a 8888 layout. Everything else has to be converted. */
-    if (src->format->BitsPerPixel != 32 || SDL_PIXELLAYOUT(src->format->format) != SDL_PACKEDLAYOUT_8888 || !src->format->Amask) {
-        blitRequired = SDL_TRUE;
+    for (i = 0; i < count; i++, verts++) {
+        SetCopyExData(renderer, verts, &srcrects[i], &dstrects[i], angles[i], &centers[i], flips[i]);
     }
 
-    /* If scaling and cropping is necessary, it has to be taken care of before the rotation. */
-    if (!(srcrect->w == final_rect->w && srcrect->h == final_rect->h && srcrect->x == 0 && srcrect->y == 0)) {
-        blitRequired = SDL_TRUE;
+    return 0;
+}
+
+/* Blends a source pixel in between the four nearest ones, a byte at a time, which
+   works the same for every 32-bit layout */
+static Uint32
+SampleLinear32(const SDL_Surface *src, const SDL_Rect *srcrect, int u, int v)
+{
+    const Uint8 *row0, *row1;
+    const Uint8 *p00, *p01, *p10, *p11;
+    Uint32 pixel = 0;
+    int x0, y0, x1, y1, fx, fy, i, t0, t1;
+
+    /* sample in between the pixel centers */
+    u -= 0x8000;
+    v -= 0x8000;
+    x0 = u >> 16;
+    y0 = v >> 16;
+    fx = (u >> 8) & 0xFF;
+    fy = (v >> 8) & 0xFF;
+    if (x0 < 0) {
+        x0 = 0;
+        fx = 0;
     }
+    if (y0 < 0) {
+        y0 = 0;
+        fy = 0;
+    }
+    x1 = SDL_min(x0 + 1, srcrect->w - 1);
+    y1 = SDL_min(y0 + 1, srcrect->h - 1);
+
+    row0 = (const Uint8 *) src->pixels + (srcrect->y + y0) * src->pitch + srcrect->x * 4;
+    row1 = (const Uint8 *) src->pixels + (srcrect->y + y1) * src->pitch + srcrect->x * 4;
+    p00 = row0 + x0 * 4;
+    p01 = row0 + x1 * 4;
+    p10 = row1 + x0 * 4;
+    p11 = row1 + x1 * 4;
+    for (i = 0; i < 4; ++i) {
+        t0 = (p00[i] << 8) + (p01[i] - p00[i]) * fx;
+        t1 = (p10[i] << 8) + (p11[i] - p10[i]) * fx;
+        ((Uint8 *) &pixel)[i] = (Uint8) (((t0 << 8) + (t1 - t0) * fy) >> 16);
+    }
+    return pixel;
+}
 
-    /* srcrect is not selecting the whole src surface, so cropping is needed */
-    if (!(srcrect->w == src->w && srcrect->h == src->h && srcrect->x == 0 && srcrect->y == 0)) {
-        blitRequired = SDL_TRUE;
+/* The pixels covered by rect rotated by angle degrees about center, which is
+   relative to rect */
+static void
+GetRotatedBounds(const SDL_Rect * rect, const double angle, const SDL_FPoint * center,
+                 SDL_Rect * bounds)
+{
+    const double radians = angle * (M_PI / 180.0);
+    const double cangle = SDL_cos(radians);
+    const double sangle = SDL_sin(radians);
+    const double cx = rect->x + center->x;
+    const double cy = rect->y + center->y;
+    double minx = 0.0, miny = 0.0, maxx = 0.0, maxy = 0.0;
+    int i;
+
+    for (i = 0; i < 4; ++i) {
+        const double px = ((i & 1) ? (rect->x + rect->w) : rect->x) - cx;
+        const double py = ((i & 2) ? (rect->y + rect->h) : rect->y) - cy;
+        const double x = cx + (px * cangle) - (py * sangle);
+        const double y = cy + (px * sangle) + (py * cangle);
+        if (i == 0 || x < minx) minx = x;
+        if (i == 0 || x > maxx) maxx = x;
+        if (i == 0 || y < miny) miny = y;
+        if (i == 0 || y > maxy) maxy = y;
     }
+    bounds->x = (int)SDL_floor(minx);
+    bounds->y = (int)SDL_floor(miny);
+    bounds->w = (int)SDL_ceil(maxx) - bounds->x;
+    bounds->h = (int)SDL_ceil(maxy) - bounds->y;
+}
 
-    /* The color and alpha modulation has to be applied before the rotation when using the NONE and MOD blend modes. */
-    if ((blendmode == SDL_BLENDMODE_NONE || blendmode == SDL_BLENDMODE_MOD) && (alphaMod & rMod & gMod & bMod) != 255) {
-        applyModulation = SDL_TRUE;
-        SDL_SetSurfaceAlphaMod(src_clone, alphaMod);
-        SDL_SetSurfaceColorMod(src_clone, rMod, gMod, bMod);
+/* Draws the texture rotated, flipped and scaled by mapping each pixel of the
+   destination back onto the source. Every row that's covered is gathered into a
+   row surface in the texture's format, which the blitters then draw with the
+   texture's modulation and blend mode. */
+static int
+SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Surface *surface, SDL_Texture * texture,
+                const SDL_Rect * srcrect, const SDL_Rect * final_rect,
+                const double angle, const SDL_FPoint * center, const SDL_RendererFlip flip)
+{
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
+    SDL_Surface *src = (SDL_Surface *) texture->driverdata;
+    SDL_Surface *row;
+    SDL_Rect bounds, span_src, span_dst;
+    SDL_BlendMode blendmode;
+    Uint8 alphaMod, rMod, gMod, bMod;
+    const double radians = angle * (M_PI / 180.0);
+    const double cangle = SDL_cos(radians);
+    const double sangle = SDL_sin(radians);
+    const double cx = final_rect->x + center->x;
+    const double cy = final_rect->y + center->y;
+    double scalex, scaley;
+    double px, py, lx, ly;
+    int x, y, n, u, v, dudx, dvdx, bpp;
+    SDL_bool linear;
+    const Uint8 *srcpixels;
+    Uint8 *dst;
+    int retval = 0;
+
+    if (!surface) {
+        return -1;
+    }
+    if (srcrect->w <= 0 || srcrect->h <= 0 || final_rect->w <= 0 || final_rect->h <= 0) {
+        return 0;
     }
 
-    /* Opaque surfaces are much easier to handle with the NONE blend mode. */
-    if (blendmode == SDL_BLENDMODE_NONE && !src->format->Amask && alphaMod == 255) {
-        isOpaque = SDL_TRUE;
+    /* The pixels covered, clipped to the surface */
+    GetRotatedBounds(final_rect, angle, center, &bounds);
+    if (!SDL_IntersectRect(&bounds, &surface->clip_rect, &bounds)) {
+        return 0;
     }
 
-    /* The NONE blend mode requires a mask for non-opaque surfaces. This mask will be used
-     * to clear the pixels in the destination surface. The other steps are explained below.
-     */
-    if (blendmode == SDL_BLENDMODE_NONE && !isOpaque) {
-        mask = SDL_CreateRGBSurface(0, final_rect->w, final_rect->h, 32,
-                                    0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000);
-        if (mask == NULL) {
-            retval = -1;
-        } else {
-            SDL_SetSurfaceBlendMode(mask, SDL_BLENDMODE_MOD);
+    /* The row surface is kept for the next copy, so it's only made again for a
+       wider area or a texture of another format */
+    row = data->copyex_row;
+    if (row && (row->w < bounds.w || row->format->format != src->format->format)) {
+        SDL_FreeSurface(row);
+        row = data->copyex_row = NULL;
+    }
+    if (!row) {
+        row = SDL_CreateRGBSurfaceWithFormat(0, bounds.w, 1, 0, src->format->format);
+        if (!row) {
+            return -1;
         }
+        data->copyex_row = row;
     }
+    if (src->format->palette && row->format->palette != src->format->palette) {
+        SDL_SetSurfacePalette(row, src->format->palette);
+    }
+
+    SDL_GetSurfaceBlendMode(src, &blendmode);
+    SDL_GetSurfaceAlphaMod(src, &alphaMod);
+    SDL_GetSurfaceColorMod(src, &rMod, &gMod, &bMod);
+    SDL_SetSurfaceBlendMode(row, blendmode);
+    SDL_SetSurfaceAlphaMod(row, alphaMod);
+    SDL_SetSurfaceColorMod(row, rMod, gMod, bMod);
 
-    /* Create a new surface should there be a format mismatch or if scaling, cropping,
-     * or modulation is required. It's possible to use the source surface directly otherwise.
+    /* It is possible to encounter an RLE encoded surface here and locking it is
+     * necessary because this code is going to access the pixel buffer directly.
      */
-    if (!retval && (blitRequired || applyModulation)) {
-        SDL_Rect scale_rect = tmp_rect;
-        src_scaled = SDL_CreateRGBSurface(0, final_rect->w, final_rect->h, 32,
-                                          0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000);
-        if (src_scaled == NULL) {
-            retval = -1;
-        } else {
-            SDL_SetSurfaceBlendMode(src_clone, SDL_BLENDMODE_NONE);
-            retval = SDL_BlitScaled(src_clone, srcrect, src_scaled, &scale_rect);
-            SDL_FreeSurface(src_clone);
-            src_clone = src_scaled;
-            src_scaled = NULL;
-        }
+    if (SDL_MUSTLOCK(src)) {
+        SDL_LockSurface(src);
+    }
+    srcpixels = (const Uint8 *) src->pixels;
+    bpp = src->format->BytesPerPixel;
+    linear = (texture->scaleMode != SDL_ScaleModeNearest && bpp == 4) ? SDL_TRUE : SDL_FALSE;
+
+    /* Source pixels, in 16.16 fixed point, stepped along a destination row */
+    scalex = (double) srcrect->w / final_rect->w;
+    scaley = (double) srcrect->h / final_rect->h;
+    dudx = (int) (cangle * scalex * 65536.0);
+    dvdx = (int) (-sangle * scaley * 65536.0);
+    if (flip & SDL_FLIP_HORIZONTAL) {
+        dudx = -dudx;
+    }
+    if (flip & SDL_FLIP_VERTICAL) {
+        dvdx = -dvdx;
     }
 
-    /* SDLgfx_rotateSurface is going to make decisions depending on the blend mode. */
-    SDL_SetSurfaceBlendMode(src_clone, blendmode);
-
-    if (!retval) {
-        SDLgfx_rotozoomSurfaceSizeTrig(tmp_rect.w, tmp_rect.h, angle, &dstwidth, &dstheight, &cangle, &sangle);
-        src_rotated = SDLgfx_rotateSurface(src_clone, angle, dstwidth/2, dstheight/2, (texture->scaleMode == SDL_ScaleModeNearest) ? 0 : 1, flip & SDL_FLIP_HORIZONTAL, flip & SDL_FLIP_VERTICAL, dstwidth, dstheight, cangle, sangle);
-        if (src_rotated == NULL) {
-            retval = -1;
+    span_src.x = 0;
+    span_src.y = 0;
+    span_src.h = 1;
+    for (y = bounds.y; y < bounds.y + bounds.h && !retval; ++y) {
+        /* the center of the first pixel, turned back about the center of rotation */
+        px = bounds.x + 0.5 - cx;
+        py = y + 0.5 - cy;
+        lx = ((px * cangle) + (py * sangle) + center->x) * scalex;
+        ly = ((py * cangle) - (px * sangle) + center->y) * scaley;
+        if (flip & SDL_FLIP_HORIZONTAL) {
+            lx = srcrect->w - lx;
         }
-        if (!retval && mask != NULL) {
-            /* The mask needed for the NONE blend mode gets rotated with the same parameters. */
-            mask_rotated = SDLgfx_rotateSurface(mask, angle, dstwidth/2, dstheight/2, SDL_FALSE, 0, 0, dstwidth, dstheight, cangle, sangle);
-            if (mask_rotated == NULL) {
-                retval = -1;
-            }
+        if (flip & SDL_FLIP_VERTICAL) {
+            ly = srcrect->h - ly;
         }
-        if (!retval) {
-            /* Find out where the new origin is by rotating the four final_rect points around the center and then taking the extremes */
-            abscenterx = final_rect->x + (int)center->x;
-            abscentery = final_rect->y + (int)center->y;
-            /* Compensate the angle inversion to match the behaviour of the other backends */
-            sangle = -sangle;
-
-            /* Top Left */
-            px = final_rect->x - abscenterx;
-            py = final_rect->y - abscentery;
-            p1x = px * cangle - py * sangle + abscenterx;
-            p1y = px * sangle + py * cangle + abscentery;
-
-            /* Top Right */
-            px = final_rect->x + final_rect->w - abscenterx;
-            py = final_rect->y - abscentery;
-            p2x = px * cangle - py * sangle + abscenterx;
-            p2y = px * sangle + py * cangle + abscentery;
-
-            /* Bottom Left */
-            px = final_rect->x - abscenterx;
-            py = final_rect->y + final_rect->h - abscentery;
-            p3x = px * cangle - py * sangle + abscenterx;
-            p3y = px * sangle + py * cangle + abscentery;
-
-            /* Bottom Right */
-            px = final_rect->x + final_rect->w - abscenterx;
-            py = final_rect->y + final_rect->h - abscentery;
-            p4x = px * cangle - py * sangle + abscenterx;
-            p4y = px * sangle + py * cangle + abscentery;
-
-            tmp_rect.x = (int)MIN(MIN(p1x, p2x), MIN(p3x, p4x));
-            tmp_rect.y = (int)MIN(MIN(p1y, p2y), MIN(p3y, p4y));
-            tmp_rect.w = dstwidth;
-            tmp_rect.h = dstheight;
-
-            /* The NONE blend mode needs some special care with non-opaque surfaces.
-             * Other blend modes or opaque surfaces can be blitted directly.
-             */
-            if (blendmode != SDL_BLENDMODE_NONE || isOpaque) {
-                if (applyModulation == SDL_FALSE) {
-                    /* If the modulation wasn't already applied, make it happen now. */
-                    SDL_SetSurfaceAlphaMod(src_rotated, alphaMod);
-                    SDL_SetSurfaceColorMod(src_rotated, rMod, gMod, bMod);
+        u = (int) SDL_floor(lx * 65536.0);
+        v = (int) SDL_floor(ly * 65536.0);
+
+        /* A row crosses the source in one piece, so skip up to it and gather until it leaves */
+        dst = (Uint8 *) row->pixels;
+        n = 0;
+        for (x = 0; x < bounds.w; ++x, u += dudx, v += dvdx) {
+            const int sx = u >> 16;
+            const int sy = v >> 16;
+            if ((unsigned) sx >= (unsigned) srcrect->w || (unsigned) sy >= (unsigned) srcrect->h) {
+                if (n) {
+                    break;
                 }
-                retval = SDL_BlitSurface(src_rotated, NULL, surface, &tmp_rect);
+                continue;
+            }
+            if (linear) {
+                *(Uint32 *) dst = SampleLinear32(src, srcrect, u, v);
             } else {
-                /* The NONE blend mode requires three steps to get the pixels onto the destination surface.
-                 * First, the area where the rotated pixels will be blitted to get set to zero.
-                 * This is accomplished by simply blitting a mask with the NONE blend mode.
-                 * The colorkey set by the rotate function will discard the correct pixels.
-                 */
-                SDL_Rect mask_rect = tmp_rect;
-                SDL_SetSurfaceBlendMode(mask_rotated, SDL_BLENDMODE_NONE);
-                retval = SDL_BlitSurface(mask_rotated, NULL, surface, &mask_rect);
-                if (!retval) {
-                    /* The next step copies the alpha value. This is done with the BLEND blend mode and
-                     * by modulating the source colors with 0. Since the destination is all zeros, this
-                     * will effectively set the destination alpha to the source alpha.
-                     */
-                    SDL_SetSurfaceColorMod(src_rotated, 0, 0, 0);
-                    mask_rect = tmp_rect;
-                    retval = SDL_BlitSurface(src_rotated, NULL, surface, &mask_rect);
-                    if (!retval) {
-                        /* The last step gets the color values in place. The ADD blend mode simply adds them to
-                         * the destination (where the color values are all zero). However, because the ADD blend
-                         * mode modulates the colors with the alpha channel, a surface without an alpha mask needs
-                         * to be created. This makes all source pixels opaque and the colors get copied correctly.
-                         */
-                        SDL_Surface *src_rotated_rgb;
-                        src_rotated_rgb = SDL_CreateRGBSurfaceFrom(src_rotated->pixels, src_rotated->w, src_rotated->h,
-                                                                   src_rotated->format->BitsPerPixel, src_rotated->pitch,
-                                                                   src_rotated->format->Rmask, src_rotated->format->Gmask,
-                                                                   src_rotated->format->Bmask, 0);
-                        if (src_rotated_rgb == NULL) {
-                            retval = -1;
-                        } else {
-                            SDL_SetSurfaceBlendMode(src_rotated_rgb, SDL_BLENDMODE_ADD);
-                            retval = SDL_BlitSurface(src_rotated_rgb, NULL, surface, &tmp_rect);
-                            SDL_FreeSurface(src_rotated_rgb);
-                        }
-                    }
+                const Uint8 *p = srcpixels + (srcrect->y + sy) * src->pitch + (srcrect->x + sx) * bpp;
+                switch (bpp) {
+                case 1:
+                    *dst = *p;
+                    break;
+                case 2:
+                    *(Uint16 *) dst = *(const Uint16 *) p;
+                    break;
+                case 3:
+                    dst[0] = p[0];
+                    dst[1] = p[1];
+                    dst[2] = p[2];
+                    break;
+                default:
+                    *(Uint32 *) dst = *(const Uint32 *) p;
+                    break;
                 }
-                SDL_FreeSurface(mask_rotated);
-            }
-            if (src_rotated != NULL) {
-                SDL_FreeSurface(src_rotated);
             }
+            dst += bpp;
+            ++n;
+        }
+        if (n == 0) {
+            continue;
         }
+
+        span_src.w = n;
+        span_dst.x = bounds.x + x - n;
+        span_dst.y = y;
+        span_dst.w = n;
+        span_dst.h = 1;
+        retval = SDL_LowerBlit(row, &span_src, surface, &span_dst);
     }
 
     if (SDL_MUSTLOCK(src)) {
         SDL_UnlockSurface(src);
     }
-    if (mask != NULL) {
-        SDL_FreeSurface(mask);
+    return retval;
+}
+
+static void
+AddDirtyRect(SW_RenderData *data, const SDL_Surface *surface, const SDL_Rect *rect)
+{
+    SDL_Rect clipped, merged;
+    int i, growth, best = 0, best_growth = 0;
+
+    if (data->dirty_all || !SDL_IntersectRect(rect, &surface->clip_rect, &clipped)) {
+        return;
+    }
+
+    /* Fold it into an area it overlaps enough that the union costs nothing extra,
+       otherwise keep it separate, or grow whichever area it enlarges the least. */
+    for (i = 0; i < data->num_dirty; ++i) {
+        SDL_UnionRect(&data->dirty[i], &clipped, &merged);
+        growth = (merged.w * merged.h) - (data->dirty[i].w * data->dirty[i].h) - (clipped.w * clipped.h);
+        if (growth <= 0) {
+            data->dirty[i] = merged;
+            return;
+        }
+        if (i == 0 || growth < best_growth) {
+            best = i;
+            best_growth = growth;
+        }
     }
-    if (src_clone != NULL) {
-        SDL_FreeSurface(src_clone);
+
+    if (data->num_dirty < SW_MAX_DIRTY_RECTS) {
+        data->dirty[data->num_dirty++] = clipped;
+    } else {
+        SDL_UnionRect(&data->dirty[best], &clipped, &data->dirty[best]);
     }
-    return retval;
+}
+
+static void
+AddDirtyPoints(SW_RenderData *data, const SDL_Surface *surface, const SDL_Point *points, const int count)
+{
+    SDL_Rect bounds;
+    int i, minx, miny, maxx, maxy;
+
+    if (count <= 0) {
+        return;
+    }
+
+    minx = maxx = points[0].x;
+    miny = maxy = points[0].y;
+    for (i = 1; i < count; ++i) {
+        minx = SDL_min(minx, points[i].x);
+        maxx = SDL_max(maxx, points[i].x);
+        miny = SDL_min(miny, points[i].y);
+        maxy = SDL_max(maxy, points[i].y);
+    }
+    bounds.x = minx;
+    bounds.y = miny;
+    bounds.w = (maxx - minx) + 1;
+    bounds.h = (maxy - miny) + 1;
+    AddDirtyRect(data, surface, &bounds);
+}
+
+/* The bounds of dstrect rotated about center, as SW_RenderCopyEx() draws it */
+static void
+AddDirtyRotatedRect(SW_RenderData *data, const SDL_Surface *surface, const SDL_Rect *dstrect,
+                    const double angle, const SDL_FPoint *center)
+{
+    SDL_Rect bounds;
+
+    GetRotatedBounds(dstrect, angle, center, &bounds);
+
+    /* a pixel of slack on each side for rounding */
+    bounds.x -= 1;
+    bounds.y -= 1;
+    bounds.w += 2;
+    bounds.h += 2;
+    AddDirtyRect(data, surface, &bounds);
 }
 
 static void
@@ -566,15 +757,9 @@ PrepTextureForCopy(const SDL_RenderCommand *cmd)
     const SDL_BlendMode blend = cmd->data.draw.blend;
     SDL_Texture *texture = cmd->data.draw.texture;
     SDL_Surface *surface = (SDL_Surface *) texture->driverdata;
-    const SDL_bool colormod = ((r & g & b) != 0xFF);
-    const SDL_bool alphamod = (a != 0xFF);
-    const SDL_bool blending = ((blend == SDL_BLENDMODE_ADD) || (blend == SDL_BLENDMODE_MOD));
-
-    if (colormod || alphamod || blending) {
-        SDL_SetSurfaceRLE(surface, 0);
-    }
 
-    /* !!! FIXME: we can probably avoid some of these calls. */
+    /* These only record the state; the surface keeps its RLE data and the
+       blitters it has already picked, see SDL_UpdateBlit(). */
     SDL_SetSurfaceColorMod(surface, r, g, b);
     SDL_SetSurfaceAlphaMod(surface, a);
     SDL_SetSurfaceBlendMode(surface, blend);
@@ -603,16 +788,223 @@ SetDrawState(SDL_Surface *surface, SW_DrawStateCache *drawstate)
     }
 }
 
+/* Clips like SDL_UpperBlit() does, but against clip instead of the surface's clip rect,
+   which the other bands are sharing */
+static void
+BlitClipped(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect,
+            const SDL_Rect *clip)
+{
+    SDL_Rect sr, dr;
+    int dx, dy;
+
+    sr = *srcrect;
+    dr.x = dstrect->x;
+    dr.y = dstrect->y;
+
+    if (sr.x < 0) {
+        sr.w += sr.x;
+        dr.x -= sr.x;
+        sr.x = 0;
+    }
+    if (sr.w > src->w - sr.x) {
+        sr.w = src->w - sr.x;
+    }
+    if (sr.y < 0) {
+        sr.h += sr.y;
+        dr.y -= sr.y;
+        sr.y = 0;
+    }
+    if (sr.h > src->h - sr.y) {
+        sr.h = src->h - sr.y;
+    }
+
+    dx = clip->x - dr.x;
+    if (dx > 0) {
+        sr.w -= dx;
+        sr.x += dx;
+        dr.x += dx;
+    }
+    dx = dr.x + sr.w - clip->x - clip->w;
+    if (dx > 0) {
+        sr.w -= dx;
+    }
+    dy = clip->y - dr.y;
+    if (dy > 0) {
+        sr.h -= dy;
+        sr.y += dy;
+        dr.y += dy;
+    }
+    dy = dr.y + sr.h - clip->y - clip->h;
+    if (dy > 0) {
+        sr.h -= dy;
+    }
+
+    if (sr.w > 0 && sr.h > 0) {
+        dr.w = sr.w;
+        dr.h = sr.h;
+        SDL_LowerBlit(src, &sr, dst, &dr);
+    }
+}
+
+static void SDLCALL
+DrawBand(void *userdata, int index)
+{
+    SW_RenderData *data = (SW_RenderData *) userdata;
+    SDL_Surface *surface = data->band_surface;
+    SDL_Rect band, clip, rect;
+    size_t j;
+    int i;
+
+    band.x = 0;
+    band.y = (surface->h * index) / data->num_bands;
+    band.w = surface->w;
+    band.h = ((surface->h * (index + 1)) / data->num_bands) - band.y;
+
+    for (i = 0; i < data->num_jobs; ++i) {
+        const SDL_RenderCommand *cmd = data->jobs[i].cmd;
+
+        if (!SDL_IntersectRect(&data->jobs[i].clip, &band, &clip)) {
+            continue;
+        }
+
+        switch (cmd->command) {
+            case SDL_RENDERCMD_CLEAR: {
+                const Uint8 r = cmd->data.color.r;
+                const Uint8 g = cmd->data.color.g;
+                const Uint8 b = cmd->data.color.b;
+                const Uint8 a = cmd->data.color.a;
+                SDL_FillRect(surface, &clip, SDL_MapRGBA(surface->format, r, g, b, a));
+                break;
+            }
+
+            case SDL_RENDERCMD_FILL_RECTS: {
+                const Uint8 r = cmd->data.draw.r;
+                const Uint8 g = cmd->data.draw.g;
+                const Uint8 b = cmd->data.draw.b;
+                const Uint8 a = cmd->data.draw.a;
+                const size_t count = cmd->data.draw.count;
+                const SDL_Rect *verts = (SDL_Rect *) (((Uint8 *) data->band_vertices) + cmd->data.draw.first);
+                const SDL_BlendMode blend = cmd->data.draw.blend;
+                const Uint32 color = SDL_MapRGBA(surface->format, r, g, b, a);
+                for (j = 0; j < count; j++) {
+                    if (!SDL_IntersectRect(&verts[j], &clip, &rect)) {
+                        continue;
+                    }
+                    if (blend == SDL_BLENDMODE_NONE) {
+                        SDL_FillRect(surface, &rect, color);
+                    } else {
+                        SDL_BlendFillRect(surface, &rect, blend, r, g, b, a);
+                    }
+                }
+                break;
+            }
+
+            case SDL_RENDERCMD_COPY: {
+                const SDL_Rect *verts = (SDL_Rect *) (((Uint8 *) data->band_vertices) + cmd->data.draw.first);
+                const size_t count = cmd->data.draw.count;
+                SDL_Surface *src = (SDL_Surface *) cmd->data.draw.texture->driverdata;
+                for (j = 0; j < count; j++, verts += 2) {
+                    BlitClipped(src, &verts[0], surface, &verts[1], &clip);
+                }
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+}
+
+/* Draws the collected commands, each band on its own thread */
+static void
+DrawBands(SW_RenderData *data)
+{
+    SDL_Rect clip_rect;
+
+    if (data->num_jobs == 0) {
+        return;
+    }
+
+    /* the jobs carry their own clipping, and the fills also clip to the surface's */
+    clip_rect = data->band_surface->clip_rect;
+    SDL_SetClipRect(data->band_surface, NULL);
+
+    SDL_RunThreadPool(data->pool, DrawBand, data, data->num_bands);
+    data->num_jobs = 0;
+
+    SDL_SetClipRect(data->band_surface, &clip_rect);
+}
+
+static void
+AddBandJob(SW_RenderData *data, const SDL_RenderCommand *cmd, const SDL_Rect *clip)
+{
+    if (data->num_jobs == SW_MAX_BAND_JOBS) {
+        DrawBands(data);
+    }
+    data->jobs[data->num_jobs].cmd = cmd;
+    data->jobs[data->num_jobs].clip = *clip;
+    data->num_jobs++;
+}
+
+/* Copies can be split into bands if nothing is scaled and the texture's blit state
+   stays put until they're drawn. Sets that state up if so. */
+static SDL_bool
+PrepBandCopy(SW_RenderData *data, const SDL_RenderCommand *cmd,
+             SDL_Surface *surface, const SDL_Rect *verts)
+{
+    const size_t count = cmd->data.draw.count;
+    SDL_Surface *src = (SDL_Surface *) cmd->data.draw.texture->driverdata;
+    size_t j;
+    int i;
+
+    for (j = 0; j < count; j++, verts += 2) {
+        if (verts[0].w != verts[1].w || verts[0].h != verts[1].h) {
+            return SDL_FALSE;
+        }
+    }
+
+    for (i = 0; i < data->num_jobs; ++i) {
+        const SDL_RenderCommand *other = data->jobs[i].cmd;
+        if (other->command == SDL_RENDERCMD_COPY && other->data.draw.texture == cmd->data.draw.texture &&
+            (other->data.draw.r != cmd->data.draw.r || other->data.draw.g != cmd->data.draw.g ||
+             other->data.draw.b != cmd->data.draw.b || other->data.draw.a != cmd->data.draw.a ||
+             other->data.draw.blend != cmd->data.draw.blend)) {
+            DrawBands(data);
+            break;
+        }
+    }
+
+    PrepTextureForCopy(cmd);
+
+    /* the bands can't touch the map while it's shared, so do what SDL_UpperBlit() would first */
+    src->map->info.flags &= ~SDL_COPY_NEAREST;
+    return (SDL_ValidateMap(src, surface) == 0) ? SDL_TRUE : SDL_FALSE;
+}
+
 static int
 SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize)
 {
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
     SDL_Surface *surface = SW_ActivateRenderer(renderer);
     SW_DrawStateCache drawstate;
+    SDL_bool tracking;
 
     if (!surface) {
         return -1;
     }
 
+    /* only drawing to the window needs remembering for the present */
+    tracking = (renderer->window && surface == data->window && !data->dirty_all) ? SDL_TRUE : SDL_FALSE;
+
+    /* Tall enough surfaces are drawn in bands, one per thread. Commands that can't be
+       split are drawn here, after the bands queued before them are finished. */
+    data->num_bands = 0;
+    if (data->pool && surface->h >= (SW_MIN_BAND_HEIGHT * 2) && !SDL_MUSTLOCK(surface)) {
+        data->num_bands = SDL_min(SDL_GetThreadPoolSize(data->pool) * 2, surface->h / SW_MIN_BAND_HEIGHT);
+        data->band_surface = surface;
+        data->band_vertices = vertices;
+    }
+
     drawstate.viewport = NULL;
     drawstate.cliprect = NULL;
     drawstate.surface_cliprect_dirty = SDL_TRUE;
@@ -641,9 +1033,22 @@ SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
                 const Uint8 b = cmd->data.color.b;
                 const Uint8 a = cmd->data.color.a;
                 /* By definition the clear ignores the clip rect */
-                SDL_SetClipRect(surface, NULL);
-                SDL_FillRect(surface, NULL, SDL_MapRGBA(surface->format, r, g, b, a));
-                drawstate.surface_cliprect_dirty = SDL_TRUE;
+                if (data->num_bands) {
+                    SDL_Rect full;
+                    full.x = 0;
+                    full.y = 0;
+                    full.w = surface->w;
+                    full.h = surface->h;
+                    AddBandJob(data, cmd, &full);
+                } else {
+                    SDL_SetClipRect(surface, NULL);
+                    SDL_FillRect(surface, NULL, SDL_MapRGBA(surface->format, r, g, b, a));
+                    drawstate.surface_cliprect_dirty = SDL_TRUE;
+                }
+                if (tracking) {
+                    data->dirty_all = SDL_TRUE;
+                    tracking = SDL_FALSE;
+                }
                 break;
             }
 
@@ -655,7 +1060,11 @@ SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
                 const int count = (int) cmd->data.draw.count;
                 const SDL_Point *verts = (SDL_Point *) (((Uint8 *) vertices) + cmd->data.draw.first);
                 const SDL_BlendMode blend = cmd->data.draw.blend;
+                DrawBands(data);
                 SetDrawState(surface, &drawstate);
+                if (tracking) {
+                    AddDirtyPoints(data, surface, verts, count);
+                }
                 if (blend == SDL_BLENDMODE_NONE) {
                     SDL_DrawPoints(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
                 } else {
@@ -672,7 +1081,11 @@ SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
                 const int count = (int) cmd->data.draw.count;
                 const SDL_Point *verts = (SDL_Point *) (((Uint8 *) vertices) + cmd->data.draw.first);
                 const SDL_BlendMode blend = cmd->data.draw.blend;
+                DrawBands(data);
                 SetDrawState(surface, &drawstate);
+                if (tracking) {
+                    AddDirtyPoints(data, surface, verts, count);
+                }
                 if (blend == SDL_BLENDMODE_NONE) {
                     SDL_DrawLines(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
                 } else {
@@ -690,7 +1103,15 @@ SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
                 const SDL_Rect *verts = (SDL_Rect *) (((Uint8 *) vertices) + cmd->data.draw.first);
                 const SDL_BlendMode blend = cmd->data.draw.blend;
                 SetDrawState(surface, &drawstate);
-                if (blend == SDL_BLENDMODE_NONE) {
+                if (tracking) {
+                    int i;
+                    for (i = 0; i < count; i++) {
+                        AddDirtyRect(data, surface, &verts[i]);
+                    }
+                }
+                if (data->num_bands) {
+                    AddBandJob(data, cmd, &surface->clip_rect);
+                } else if (blend == SDL_BLENDMODE_NONE) {
                     SDL_FillRects(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
                 } else {
                     SDL_BlendFillRects(surface, verts, count, blend, r, g, b, a);
@@ -700,33 +1121,61 @@ SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
 
             case SDL_RENDERCMD_COPY: {
                 SDL_Rect *verts = (SDL_Rect *) (((Uint8 *) vertices) + cmd->data.draw.first);
-                const SDL_Rect *srcrect = verts;
-                SDL_Rect *dstrect = verts + 1;
+                const size_t count = cmd->data.draw.count;
                 SDL_Texture *texture = cmd->data.draw.texture;
                 SDL_Surface *src = (SDL_Surface *) texture->driverdata;
+                size_t i;
 
                 SetDrawState(surface, &drawstate);
 
+                if (data->num_bands && PrepBandCopy(data, cmd, surface, verts)) {
+                    if (tracking) {
+                        for (i = 0; i < count; i++) {
+                            AddDirtyRect(data, surface, &verts[i * 2 + 1]);
+                        }
+                    }
+                    AddBandJob(data, cmd, &surface->clip_rect);
+                    break;
+                }
+                DrawBands(data);
+
+                /* merged copies share their texture state, so it only needs setting up once. */
                 PrepTextureForCopy(cmd);
 
-                if ( srcrect->w == dstrect->w && srcrect->h == dstrect->h ) {
-                    SDL_BlitSurface(src, srcrect, surface, dstrect);
-                } else {
-                    /* If scaling is ever done, permanently disable RLE (which doesn't support scaling)
-                     * to avoid potentially frequent RLE encoding/decoding.
-                     */
-                    SDL_SetSurfaceRLE(surface, 0);
-                    SDL_BlitScaled(src, srcrect, surface, dstrect);
+                for (i = 0; i < count; i++, verts += 2) {
+                    const SDL_Rect *srcrect = verts;
+                    SDL_Rect *dstrect = verts + 1;
+
+                    if (tracking) {
+                        AddDirtyRect(data, surface, dstrect);
+                    }
+                    if ( srcrect->w == dstrect->w && srcrect->h == dstrect->h ) {
+                        SDL_BlitSurface(src, srcrect, surface, dstrect);
+                    } else {
+                        /* If scaling is ever done, permanently disable RLE (which doesn't support scaling)
+                         * to avoid potentially frequent RLE encoding/decoding.
+                         */
+                        SDL_SetSurfaceRLE(surface, 0);
+                        SDL_BlitScaled(src, srcrect, surface, dstrect);
+                    }
                 }
                 break;
             }
 
             case SDL_RENDERCMD_COPY_EX: {
                 const CopyExData *copydata = (CopyExData *) (((Uint8 *) vertices) + cmd->data.draw.first);
+                const size_t count = cmd->data.draw.count;
+                size_t i;
+                DrawBands(data);
                 SetDrawState(surface, &drawstate);
                 PrepTextureForCopy(cmd);
-                SW_RenderCopyEx(renderer, surface, cmd->data.draw.texture, &copydata->srcrect,
-                                &copydata->dstrect, copydata->angle, &copydata->center, copydata->flip);
+                for (i = 0; i < count; i++, copydata++) {
+                    if (tracking) {
+                        AddDirtyRotatedRect(data, surface, &copydata->dstrect, copydata->angle, &copydata->center);
+                    }
+                    SW_RenderCopyEx(renderer, surface, cmd->data.draw.texture, &copydata->srcrect,
+                                    &copydata->dstrect, copydata->angle, &copydata->center, copydata->flip);
+                }
                 break;
             }
 
@@ -737,6 +1186,8 @@ SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
         cmd = cmd->next;
     }
 
+    DrawBands(data);
+
     return 0;
 }
 
@@ -774,11 +1225,33 @@ SW_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
 static void
 SW_RenderPresent(SDL_Renderer * renderer)
 {
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
     SDL_Window *window = renderer->window;
+    SDL_Surface *surface = data->window;
+    int i, area = 0;
+
+    if (!window) {
+        return;
+    }
 
-    if (window) {
+    if (!data->dirty_all && surface) {
+        for (i = 0; i < data->num_dirty; ++i) {
+            area += data->dirty[i].w * data->dirty[i].h;
+        }
+        /* past about three quarters of the screen one big copy is cheaper */
+        if (area > ((surface->w * surface->h) / 4) * 3) {
+            data->dirty_all = SDL_TRUE;
+        }
+    }
+
+    if (data->dirty_all || !surface) {
         SDL_UpdateWindowSurface(window);
+    } else if (data->num_dirty > 0) {
+        SDL_UpdateWindowSurfaceRects(window, data->dirty, data->num_dirty);
     }
+
+    data->num_dirty = 0;
+    data->dirty_all = SDL_FALSE;
 }
 
 static void
@@ -794,6 +1267,10 @@ SW_DestroyRenderer(SDL_Renderer * renderer)
 {
     SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
 
+    if (data) {
+        SDL_DestroyThreadPool(data->pool);
+        SDL_FreeSurface(data->copyex_row);
+    }
     SDL_free(data);
     SDL_free(renderer);
 }
@@ -803,6 +1280,8 @@ SW_CreateRendererForSurface(SDL_Surface * surface)
 {
     SDL_Renderer *renderer;
     SW_RenderData *data;
+    const char *hint;
+    int threads;
 
     if (!surface) {
         SDL_SetError("Can't create renderer for NULL surface");
@@ -823,13 +1302,26 @@ SW_CreateRendererForSurface(SDL_Surface * surface)
     }
     data->surface = surface;
     data->window = surface;
+    data->dirty_all = SDL_TRUE;  /* nothing has been shown yet */
+
+    /* Threads to draw with; there's no point with only one core */
+    hint = SDL_GetHint(SDL_HINT_RENDER_THREADS);
+    threads = hint ? SDL_atoi(hint) : 0;
+    if (threads <= 0) {
+        threads = SDL_GetCPUCount();
+    }
+    if (threads > 1) {
+        data->pool = SDL_CreateThreadPool("SDLRender", threads);
+    }
 
     renderer->WindowEvent = SW_WindowEvent;
     renderer->GetOutputSize = SW_GetOutputSize;
+    renderer->SupportsBlendMode = SW_SupportsBlendMode;
     renderer->CreateTexture = SW_CreateTexture;
     renderer->UpdateTexture = SW_UpdateTexture;
     renderer->LockTexture = SW_LockTexture;
     renderer->UnlockTexture = SW_UnlockTexture;
+    renderer->ReadTexture = SW_ReadTexture;
     renderer->SetRenderTarget = SW_SetRenderTarget;
     renderer->QueueSetViewport = SW_QueueSetViewport;
     renderer->QueueSetDrawColor = SW_QueueSetViewport;  /* SetViewport and SetDrawColor are (currently) no-ops. */
@@ -838,6 +1330,8 @@ SW_CreateRendererForSurface(SDL_Surface * surface)
     renderer->QueueFillRects = SW_QueueFillRects;
     renderer->QueueCopy = SW_QueueCopy;
     renderer->QueueCopyEx = SW_QueueCopyEx;
+    renderer->QueueCopyBatch = SW_QueueCopyBatch;
+    renderer->QueueCopyExBatch = SW_QueueCopyExBatch;
     renderer->RunCommandQueue = SW_RunCommandQueue;
     renderer->RenderReadPixels = SW_RenderReadPixels;
     renderer->RenderPresent = SW_RenderPresent;
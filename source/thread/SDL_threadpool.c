@@ -0,0 +1,178 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2019 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+#include "SDL_thread.h"
+#include "SDL_atomic.h"
+#include "SDL_threadpool_c.h"
+#include "SDL_systhread.h"
+
+/* The workers sleep on a semaphore between runs. A run posts it once per worker, then
+   everyone, the caller included, takes indices from a shared counter until they run
+   out, and each worker posts a second semaphore when it's done. */
+
+struct SDL_ThreadPool
+{
+    SDL_Thread **threads;
+    int num_workers;
+    SDL_sem *work_sem;
+    SDL_sem *done_sem;
+    SDL_mutex *lock;            /* one run at a time */
+    SDL_atomic_t quit;
+
+    /* the current run */
+    SDL_ThreadPoolFunction func;
+    void *data;
+    int count;
+    SDL_atomic_t next;
+};
+
+static void
+RunThreadPoolTasks(SDL_ThreadPool *pool)
+{
+    int index;
+
+    while ((index = SDL_AtomicAdd(&pool->next, 1)) < pool->count) {
+        pool->func(pool->data, index);
+    }
+}
+
+static int SDLCALL
+ThreadPoolWorker(void *data)
+{
+    SDL_ThreadPool *pool = (SDL_ThreadPool *) data;
+
+    for ( ; ; ) {
+        SDL_SemWait(pool->work_sem);
+        if (SDL_AtomicGet(&pool->quit)) {
+            break;
+        }
+        RunThreadPoolTasks(pool);
+        SDL_SemPost(pool->done_sem);
+    }
+    return 0;
+}
+
+SDL_ThreadPool *
+SDL_CreateThreadPool(const char *name, int num_threads)
+{
+    SDL_ThreadPool *pool;
+    char threadname[64];
+    int i;
+
+    pool = (SDL_ThreadPool *) SDL_calloc(1, sizeof (*pool));
+    if (!pool) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    if (num_threads > 1) {
+        pool->threads = (SDL_Thread **) SDL_calloc(num_threads - 1, sizeof (*pool->threads));
+        pool->work_sem = SDL_CreateSemaphore(0);
+        pool->done_sem = SDL_CreateSemaphore(0);
+        pool->lock = SDL_CreateMutex();
+        if (!pool->threads || !pool->work_sem || !pool->done_sem || !pool->lock) {
+            SDL_DestroyThreadPool(pool);
+            return NULL;
+        }
+
+        /* if some threads can't be started, make do with the ones that were */
+        for (i = 0; i < num_threads - 1; ++i) {
+            SDL_snprintf(threadname, sizeof (threadname), "%s%d", name, i);
+            pool->threads[i] = SDL_CreateThreadInternal(ThreadPoolWorker, threadname, 0, pool);
+            if (!pool->threads[i]) {
+                break;
+            }
+            ++pool->num_workers;
+        }
+    }
+    return pool;
+}
+
+int
+SDL_GetThreadPoolSize(SDL_ThreadPool *pool)
+{
+    return pool ? (pool->num_workers + 1) : 1;
+}
+
+void
+SDL_RunThreadPool(SDL_ThreadPool *pool, SDL_ThreadPoolFunction func, void *data, int count)
+{
+    int i, workers;
+
+    if (!pool || pool->num_workers == 0 || count <= 1) {
+        for (i = 0; i < count; ++i) {
+            func(data, i);
+        }
+        return;
+    }
+
+    SDL_LockMutex(pool->lock);
+
+    pool->func = func;
+    pool->data = data;
+    pool->count = count;
+    SDL_AtomicSet(&pool->next, 0);
+
+    /* no point waking more workers than there are pieces for them */
+    workers = SDL_min(pool->num_workers, count - 1);
+    for (i = 0; i < workers; ++i) {
+        SDL_SemPost(pool->work_sem);
+    }
+    RunThreadPoolTasks(pool);
+    for (i = 0; i < workers; ++i) {
+        SDL_SemWait(pool->done_sem);
+    }
+
+    SDL_UnlockMutex(pool->lock);
+}
+
+void
+SDL_DestroyThreadPool(SDL_ThreadPool *pool)
+{
+    int i;
+
+    if (!pool) {
+        return;
+    }
+
+    SDL_AtomicSet(&pool->quit, 1);
+    for (i = 0; i < pool->num_workers; ++i) {
+        SDL_SemPost(pool->work_sem);
+    }
+    for (i = 0; i < pool->num_workers; ++i) {
+        SDL_WaitThread(pool->threads[i], NULL);
+    }
+
+    if (pool->lock) {
+        SDL_DestroyMutex(pool->lock);
+    }
+    if (pool->done_sem) {
+        SDL_DestroySemaphore(pool->done_sem);
+    }
+    if (pool->work_sem) {
+        SDL_DestroySemaphore(pool->work_sem);
+    }
+    SDL_free(pool->threads);
+    SDL_free(pool);
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,48 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2019 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+#ifndef SDL_threadpool_c_h_
+#define SDL_threadpool_c_h_
+
+/* A fixed set of worker threads for splitting one job into independent pieces */
+
+typedef void (SDLCALL * SDL_ThreadPoolFunction) (void *data, int index);
+
+typedef struct SDL_ThreadPool SDL_ThreadPool;
+
+/* num_threads counts the thread that calls SDL_RunThreadPool(), which does its share
+   of the work, so a pool of 1 has no workers and runs everything on the caller. */
+extern SDL_ThreadPool *SDL_CreateThreadPool(const char *name, int num_threads);
+
+/* How many threads share the work, including the caller */
+extern int SDL_GetThreadPoolSize(SDL_ThreadPool *pool);
+
+/* Calls func(data, index) for every index from 0 to count-1, spread over the pool, and
+   returns once all of them have finished. The calls may run in any order and at the
+   same time as each other. A NULL pool runs them all on the calling thread. */
+extern void SDL_RunThreadPool(SDL_ThreadPool *pool, SDL_ThreadPoolFunction func, void *data, int count);
+
+extern void SDL_DestroyThreadPool(SDL_ThreadPool *pool);
+
+#endif /* SDL_threadpool_c_h_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -83,9 +83,17 @@
  *
  *   The end of the sequence is marked by a zero <skip>,<run> pair at the
  *   beginning of an opaque line.
+ *
+ * Both encodings are preceded by a table with the offset of each scan line
+ * from the start of its first segment (after the RLEDestFormat, if any), so
+ * blits clipped at the top can start at their first visible line instead of
+ * walking over all the ones above it. Lines at the bottom that were left out
+ * because they're blank point at the end of the sequence, and one more entry
+ * after the last line holds the offset of the end marker.
  */
 
 #include "SDL_video.h"
+#include "SDL_endian.h"
 #include "SDL_sysvideo.h"
 #include "SDL_blit.h"
 #include "SDL_RLEaccel_c.h"
@@ -97,6 +105,11 @@
 #define PIXEL_COPY(to, from, len, bpp)          \
     SDL_memcpy(to, from, (size_t)(len) * (bpp))
 
+/* the table of line offsets in front of the encoding, and the encoding itself */
+#define RLE_LINE_OFFSETS(surface)   ((Uint32 *) (surface)->map->data)
+#define RLE_DATA(surface)           \
+    ((Uint8 *) (surface)->map->data + ((surface)->h + 1) * sizeof(Uint32))
+
 /*
  * Various colorkey blit methods, for opaque and per-surface alpha
  */
@@ -467,51 +480,8 @@ SDL_RLEBlit(SDL_Surface * surf_src, SDL_Rect * srcrect,
     y = dstrect->y;
     dstbuf = (Uint8 *) surf_dst->pixels
         + y * surf_dst->pitch + x * surf_src->format->BytesPerPixel;
-    srcbuf = (Uint8 *) surf_src->map->data;
-
-    {
-        /* skip lines at the top if necessary */
-        int vskip = srcrect->y;
-        int ofs = 0;
-        if (vskip) {
-
-#define RLESKIP(bpp, Type)          \
-        for(;;) {           \
-            int run;            \
-            ofs += *(Type *)srcbuf; \
-            run = ((Type *)srcbuf)[1];  \
-            srcbuf += sizeof(Type) * 2; \
-            if(run) {           \
-            srcbuf += run * bpp;    \
-            ofs += run;     \
-            } else if(!ofs)     \
-            goto done;      \
-            if(ofs == w) {      \
-            ofs = 0;        \
-            if(!--vskip)        \
-                break;      \
-            }               \
-        }
-
-            switch (surf_src->format->BytesPerPixel) {
-            case 1:
-                RLESKIP(1, Uint8);
-                break;
-            case 2:
-                RLESKIP(2, Uint8);
-                break;
-            case 3:
-                RLESKIP(3, Uint8);
-                break;
-            case 4:
-                RLESKIP(4, Uint16);
-                break;
-            }
-
-#undef RLESKIP
-
-        }
-    }
+    /* start at the first line that isn't clipped away */
+    srcbuf = RLE_DATA(surf_src) + RLE_LINE_OFFSETS(surf_src)[srcrect->y];
 
     alpha = surf_src->map->info.a;
     /* if left or right edge clipping needed, call clip blit */
@@ -549,7 +519,6 @@ SDL_RLEBlit(SDL_Surface * surf_src, SDL_Rect * srcrect,
 #undef RLEBLIT
     }
 
-  done:
     /* Unlock the destination if necessary */
     if (SDL_MUSTLOCK(surf_dst)) {
         SDL_UnlockSurface(surf_dst);
@@ -742,63 +711,9 @@ SDL_RLEAlphaBlit(SDL_Surface * surf_src, SDL_Rect * srcrect,
     x = dstrect->x;
     y = dstrect->y;
     dstbuf = (Uint8 *) surf_dst->pixels + y * surf_dst->pitch + x * df->BytesPerPixel;
-    srcbuf = (Uint8 *) surf_src->map->data + sizeof(RLEDestFormat);
-
-    {
-        /* skip lines at the top if necessary */
-        int vskip = srcrect->y;
-        if (vskip) {
-            int ofs;
-            if (df->BytesPerPixel == 2) {
-                /* the 16/32 interleaved format */
-                do {
-                    /* skip opaque line */
-                    ofs = 0;
-                    do {
-                        int run;
-                        ofs += srcbuf[0];
-                        run = srcbuf[1];
-                        srcbuf += 2;
-                        if (run) {
-                            srcbuf += 2 * run;
-                            ofs += run;
-                        } else if (!ofs)
-                            goto done;
-                    } while (ofs < w);
-
-                    /* skip padding */
-                    srcbuf += (uintptr_t) srcbuf & 2;
-
-                    /* skip translucent line */
-                    ofs = 0;
-                    do {
-                        int run;
-                        ofs += ((Uint16 *) srcbuf)[0];
-                        run = ((Uint16 *) srcbuf)[1];
-                        srcbuf += 4 * (run + 1);
-                        ofs += run;
-                    } while (ofs < w);
-                } while (--vskip);
-            } else {
-                /* the 32/32 interleaved format */
-                vskip <<= 1;    /* opaque and translucent have same format */
-                do {
-                    ofs = 0;
-                    do {
-                        int run;
-                        ofs += ((Uint16 *) srcbuf)[0];
-                        run = ((Uint16 *) srcbuf)[1];
-                        srcbuf += 4;
-                        if (run) {
-                            srcbuf += 4 * run;
-                            ofs += run;
-                        } else if (!ofs)
-                            goto done;
-                    } while (ofs < w);
-                } while (--vskip);
-            }
-        }
-    }
+    /* start at the first line that isn't clipped away */
+    srcbuf = RLE_DATA(surf_src) + sizeof(RLEDestFormat)
+        + RLE_LINE_OFFSETS(surf_src)[srcrect->y];
 
     /* if left or right edge clipping needed, call clip blit */
     if (srcrect->x || srcrect->w != surf_src->w) {
@@ -1032,6 +947,7 @@ RLEAlphaSurface(SDL_Surface * surface)
     int max_transl_run = 65535;
     unsigned masksum;
     Uint8 *rlebuf, *dst;
+    Uint32 *lineofs;
     int (*copy_opaque) (void *, Uint32 *, int,
                         SDL_PixelFormat *, SDL_PixelFormat *);
     int (*copy_transl) (void *, Uint32 *, int,
@@ -1090,14 +1006,15 @@ RLEAlphaSurface(SDL_Surface * surface)
         return -1;              /* anything else unsupported right now */
     }
 
-    maxsize += sizeof(RLEDestFormat);
+    maxsize += (surface->h + 1) * sizeof(Uint32) + sizeof(RLEDestFormat);
     rlebuf = (Uint8 *) SDL_malloc(maxsize);
     if (!rlebuf) {
         return SDL_OutOfMemory();
     }
+    lineofs = (Uint32 *) rlebuf;
     {
         /* save the destination format so we can undo the encoding later */
-        RLEDestFormat *r = (RLEDestFormat *) rlebuf;
+        RLEDestFormat *r = (RLEDestFormat *) (lineofs + surface->h + 1);
         r->BytesPerPixel = df->BytesPerPixel;
         r->Rmask = df->Rmask;
         r->Gmask = df->Gmask;
@@ -1112,7 +1029,7 @@ RLEAlphaSurface(SDL_Surface * surface)
         r->Bshift = df->Bshift;
         r->Ashift = df->Ashift;
     }
-    dst = rlebuf + sizeof(RLEDestFormat);
+    dst = (Uint8 *) (lineofs + surface->h + 1) + sizeof(RLEDestFormat);
 
     /* Do the actual encoding */
     {
@@ -1120,6 +1037,7 @@ RLEAlphaSurface(SDL_Surface * surface)
         int h = surface->h, w = surface->w;
         SDL_PixelFormat *sf = surface->format;
         Uint32 *src = (Uint32 *) surface->pixels;
+        Uint8 *start = dst;     /* where the line offsets count from */
         Uint8 *lastline = dst;  /* end of last non-blank line */
 
         /* opaque counts are 8 or 16 bits, depending on target depth */
@@ -1141,6 +1059,7 @@ RLEAlphaSurface(SDL_Surface * surface)
         for (y = 0; y < h; y++) {
             int runstart, skipstart;
             int blankline = 0;
+            lineofs[y] = (Uint32) (dst - start);
             /* First encode all opaque pixels of a scan line */
             x = 0;
             do {
@@ -1212,6 +1131,12 @@ RLEAlphaSurface(SDL_Surface * surface)
             src += surface->pitch >> 2;
         }
         dst = lastline;         /* back up past trailing blank lines */
+        for (y = 0; y < h; y++) {
+            if (lineofs[y] > (Uint32) (lastline - start)) {
+                lineofs[y] = (Uint32) (lastline - start);
+            }
+        }
+        lineofs[h] = (Uint32) (lastline - start);
         ADD_OPAQUE_COUNTS(0, 0);
     }
 
@@ -1219,7 +1144,7 @@ RLEAlphaSurface(SDL_Surface * surface)
 #undef ADD_TRANSL_COUNTS
 
     /* Now that we have it encoded, release the original pixels */
-    if (!(surface->flags & SDL_PREALLOC)) {
+    if (!(surface->flags & SDL_PREALLOC) && !surface->map->keep_pixels) {
         SDL_SIMDFree(surface->pixels);
         surface->pixels = NULL;
         surface->flags &= ~SDL_SIMD_ALIGNED;
@@ -1274,9 +1199,10 @@ static int
 RLEColorkeySurface(SDL_Surface * surface)
 {
     Uint8 *rlebuf, *dst;
+    Uint32 *lineofs;
     int maxn;
     int y;
-    Uint8 *srcbuf, *lastline;
+    Uint8 *srcbuf, *start, *lastline;
     int maxsize = 0;
     const int bpp = surface->format->BytesPerPixel;
     getpix_func getpix;
@@ -1306,6 +1232,7 @@ RLEColorkeySurface(SDL_Surface * surface)
         return -1;
     }
 
+    maxsize += (surface->h + 1) * sizeof(Uint32);
     rlebuf = (Uint8 *) SDL_malloc(maxsize);
     if (rlebuf == NULL) {
         return SDL_OutOfMemory();
@@ -1314,7 +1241,8 @@ RLEColorkeySurface(SDL_Surface * surface)
     /* Set up the conversion */
     srcbuf = (Uint8 *) surface->pixels;
     maxn = bpp == 4 ? 65535 : 255;
-    dst = rlebuf;
+    lineofs = (Uint32 *) rlebuf;
+    dst = start = (Uint8 *) (lineofs + surface->h + 1);
     rgbmask = ~surface->format->Amask;
     ckey = surface->map->info.colorkey & rgbmask;
     lastline = dst;
@@ -1336,6 +1264,7 @@ RLEColorkeySurface(SDL_Surface * surface)
     for (y = 0; y < h; y++) {
         int x = 0;
         int blankline = 0;
+        lineofs[y] = (Uint32) (dst - start);
         do {
             int run, skip, len;
             int runstart;
@@ -1378,12 +1307,18 @@ RLEColorkeySurface(SDL_Surface * surface)
         srcbuf += surface->pitch;
     }
     dst = lastline;             /* back up bast trailing blank lines */
+    for (y = 0; y < h; y++) {
+        if (lineofs[y] > (Uint32) (lastline - start)) {
+            lineofs[y] = (Uint32) (lastline - start);
+        }
+    }
+    lineofs[h] = (Uint32) (lastline - start);
     ADD_COUNTS(0, 0);
 
 #undef ADD_COUNTS
 
     /* Now that we have it encoded, release the original pixels */
-    if (!(surface->flags & SDL_PREALLOC)) {
+    if (!(surface->flags & SDL_PREALLOC) && !surface->map->keep_pixels) {
         SDL_SIMDFree(surface->pixels);
         surface->pixels = NULL;
         surface->flags &= ~SDL_SIMD_ALIGNED;
@@ -1406,21 +1341,11 @@ SDL_RLESurface(SDL_Surface * surface)
 {
     int flags;
 
-    /* Clear any previous RLE conversion */
-    if ((surface->flags & SDL_RLEACCEL) == SDL_RLEACCEL) {
-        SDL_UnRLESurface(surface, 1);
-    }
-
     /* We don't support RLE encoding of bitmaps */
     if (surface->format->BitsPerPixel < 8) {
         return -1;
     }
 
-    /* Make sure the pixels are available */
-    if (!surface->pixels) {
-        return -1;
-    }
-
     /* If we don't have colorkey or blending, nothing to do... */
     flags = surface->map->info.flags;
     if (!(flags & (SDL_COPY_COLORKEY | SDL_COPY_BLEND))) {
@@ -1431,10 +1356,22 @@ SDL_RLESurface(SDL_Surface * surface)
     if ((flags & SDL_COPY_MODULATE_COLOR) ||
         ((flags & SDL_COPY_MODULATE_ALPHA) && surface->format->Amask) ||
         (flags & (SDL_COPY_ADD | SDL_COPY_MOD)) ||
+        ((flags & SDL_COPY_BLEND_PREMULTIPLIED) && surface->format->Amask) ||
         (flags & SDL_COPY_NEAREST)) {
         return -1;
     }
 
+    /* Clear any previous RLE conversion. Checking the flags first leaves data
+       that was set aside alone when these flags can't use RLE anyway. */
+    if ((surface->flags & SDL_RLEACCEL) == SDL_RLEACCEL) {
+        SDL_UnRLESurface(surface, 1);
+    }
+
+    /* Make sure the pixels are available */
+    if (!surface->pixels) {
+        return -1;
+    }
+
     /* Encode and set up the blit */
     if (!surface->format->Amask || !(flags & SDL_COPY_BLEND)) {
         if (!surface->map->identity) {
@@ -1455,6 +1392,7 @@ SDL_RLESurface(SDL_Surface * surface)
 
     /* The surface is now accelerated */
     surface->flags |= SDL_RLEACCEL;
+    surface->map->blit_key = SDL_COPY_BLIT_KEY(surface->map->info.flags);
 
     return (0);
 }
@@ -1471,7 +1409,7 @@ UnRLEAlpha(SDL_Surface * surface)
     Uint8 *srcbuf;
     Uint32 *dst;
     SDL_PixelFormat *sf = surface->format;
-    RLEDestFormat *df = surface->map->data;
+    RLEDestFormat *df = (RLEDestFormat *) RLE_DATA(surface);
     int (*uncopy_opaque) (Uint32 *, void *, int,
                           RLEDestFormat *, SDL_PixelFormat *);
     int (*uncopy_transl) (Uint32 *, void *, int,
@@ -1541,47 +1479,484 @@ end_function:
     return (SDL_TRUE);
 }
 
+/* Gets the pixels back from the RLE data if they were released when it was made */
+static SDL_bool
+RestorePixels(SDL_Surface * surface)
+{
+    if (surface->pixels) {
+        return SDL_TRUE;
+    }
+
+    if (surface->map->info.flags & SDL_COPY_RLE_COLORKEY) {
+        SDL_Rect full;
+        Uint8 alpha = surface->map->info.a;
+
+        /* re-create the original surface */
+        surface->pixels = SDL_SIMDAlloc(surface->h * surface->pitch);
+        if (!surface->pixels) {
+            return SDL_FALSE;
+        }
+        surface->flags |= SDL_SIMD_ALIGNED;
+
+        /* fill it with the background color */
+        SDL_FillRect(surface, NULL, surface->map->info.colorkey);
+
+        /* now render the encoded surface, without any alpha modulation */
+        full.x = full.y = 0;
+        full.w = surface->w;
+        full.h = surface->h;
+        surface->map->info.a = 0xFF;
+        SDL_RLEBlit(surface, &full, surface, &full);
+        surface->map->info.a = alpha;
+        return SDL_TRUE;
+    }
+    return UnRLEAlpha(surface);
+}
+
 void
 SDL_UnRLESurface(SDL_Surface * surface, int recode)
 {
     if (surface->flags & SDL_RLEACCEL) {
+        SDL_BlitMap *map = surface->map;
+
         surface->flags &= ~SDL_RLEACCEL;
 
-        if (recode && !(surface->flags & SDL_PREALLOC)) {
-            if (surface->map->info.flags & SDL_COPY_RLE_COLORKEY) {
-                SDL_Rect full;
+        if (map->info.flags & (SDL_COPY_RLE_COLORKEY | SDL_COPY_RLE_ALPHAKEY)) {
+            if (recode && !RestorePixels(surface)) {
+                /* Oh crap... */
+                surface->flags |= SDL_RLEACCEL;
+                return;
+            }
+            map->info.flags &=
+                ~(SDL_COPY_RLE_COLORKEY | SDL_COPY_RLE_ALPHAKEY);
 
-                /* re-create the original surface */
-                surface->pixels = SDL_SIMDAlloc(surface->h * surface->pitch);
-                if (!surface->pixels) {
-                    /* Oh crap... */
-                    surface->flags |= SDL_RLEACCEL;
-                    return;
-                }
-                surface->flags |= SDL_SIMD_ALIGNED;
+            SDL_free(map->data);
+            map->data = NULL;
+            map->blit = NULL;   /* SDL_ValidateMap() picks another one */
+            map->rle_loaded = SDL_FALSE;
+        }
+
+        /* any RLE data set aside is out of date now too */
+        SDL_free(map->rle_data);
+        map->rle_data = NULL;
+    }
+}
+
+int
+SDL_RLEPutAside(SDL_Surface * surface)
+{
+    SDL_BlitMap *map = surface->map;
+
+    /* Other blitters need the pixels, so they're kept alongside the RLE data from
+       now on, rather than decoded again every time the flags change. The
+       surface stays marked as RLE, so writing to the pixels has to lock it,
+       as SDL_FillRect() does, and that throws the RLE data away. */
+    surface->flags &= ~SDL_RLEACCEL;
+    if (!RestorePixels(surface)) {
+        surface->flags |= SDL_RLEACCEL;
+        return SDL_OutOfMemory();
+    }
+    surface->flags |= SDL_RLEACCEL;
+    map->keep_pixels = SDL_TRUE;
+
+    map->rle_data = map->data;
+    map->rle_flags = map->info.flags & (SDL_COPY_RLE_COLORKEY | SDL_COPY_RLE_ALPHAKEY);
+    map->rle_key = map->blit_key;
+    map->info.flags &= ~(SDL_COPY_RLE_COLORKEY | SDL_COPY_RLE_ALPHAKEY);
+    map->data = NULL;
+    map->blit = NULL;
+    return 0;
+}
 
-                /* fill it with the background color */
-                SDL_FillRect(surface, NULL, surface->map->info.colorkey);
+SDL_bool
+SDL_RLETakeBack(SDL_Surface * surface)
+{
+    SDL_BlitMap *map = surface->map;
+
+    if (!map->rle_data || (map->rle_key != SDL_COPY_BLIT_KEY(map->info.flags))) {
+        return SDL_FALSE;
+    }
 
-                /* now render the encoded surface */
-                full.x = full.y = 0;
-                full.w = surface->w;
-                full.h = surface->h;
-                SDL_RLEBlit(surface, &full, surface, &full);
+    map->data = map->rle_data;
+    map->rle_data = NULL;
+    map->info.flags |= map->rle_flags;
+    map->blit = (map->rle_flags & SDL_COPY_RLE_COLORKEY) ? SDL_RLEBlit : SDL_RLEAlphaBlit;
+    map->blit_key = map->rle_key;
+    return SDL_TRUE;
+}
+
+SDL_bool
+SDL_RLEUseLoaded(SDL_Surface * surface)
+{
+    SDL_BlitMap *map = surface->map;
+    SDL_PixelFormat *df = map->dst->format;
+
+    /* The flags have to be the ones the data was saved with */
+    if (!(map->info.flags & SDL_COPY_RLE_DESIRED) ||
+        (map->blit_key != SDL_COPY_BLIT_KEY(map->info.flags))) {
+        return SDL_FALSE;
+    }
+
+    if (map->info.flags & SDL_COPY_RLE_COLORKEY) {
+        /* colorkeyed data is in the source format, which has to be kept */
+        if (!map->identity) {
+            return SDL_FALSE;
+        }
+        map->blit = SDL_RLEBlit;
+    } else if (map->info.flags & SDL_COPY_RLE_ALPHAKEY) {
+        /* pixel-alpha data is encoded for one destination format */
+        RLEDestFormat *r = (RLEDestFormat *) RLE_DATA(surface);
+        if (r->BytesPerPixel != df->BytesPerPixel ||
+            r->Rmask != df->Rmask || r->Gmask != df->Gmask ||
+            r->Bmask != df->Bmask || r->Amask != df->Amask) {
+            return SDL_FALSE;
+        }
+        map->blit = SDL_RLEAlphaBlit;
+    } else {
+        return SDL_FALSE;
+    }
+
+    map->info.src_fmt = surface->format;
+    map->info.src_pitch = surface->pitch;
+    map->info.dst_fmt = df;
+    map->info.dst_pitch = map->dst->pitch;
+    return SDL_TRUE;
+}
+
+/*
+ * Serialized RLE surfaces
+ *
+ * The file holds the surface's format, size and blit state, its palette if
+ * it has one, and then the RLE data exactly as it is kept in memory, line
+ * offsets and all. The header is little endian, but the RLE data is in the
+ * byte order of the machine that encoded it.
+ */
+#define RLE_FILE_MAGIC      0x454C5253  /* "SRLE" */
+#define RLE_FILE_VERSION    1
+
+/* The flags that are saved along with the data */
+#define RLE_FILE_FLAGS      \
+    (SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_COLORKEY | SDL_COPY_RLE_MASK)
+
+/* Size of the RLE data in the map, from the offset of its end marker */
+static size_t
+RLEDataSize(SDL_Surface * surface)
+{
+    Uint32 *lineofs = RLE_LINE_OFFSETS(surface);
+    size_t size = (surface->h + 1) * sizeof(Uint32) + lineofs[surface->h];
+    int countsize;
+
+    if (surface->map->info.flags & SDL_COPY_RLE_ALPHAKEY) {
+        RLEDestFormat *r = (RLEDestFormat *) RLE_DATA(surface);
+        size += sizeof(RLEDestFormat);
+        countsize = (r->BytesPerPixel == 4) ? 2 : 1;
+    } else {
+        countsize = (surface->format->BytesPerPixel == 4) ? 2 : 1;
+    }
+    return size + 2 * countsize;
+}
+
+/* The shifts and losses decoding uses have to be the ones for the masks */
+static SDL_bool
+RLEDestFormatIsValid(RLEDestFormat * r)
+{
+    SDL_PixelFormat *fmt;
+    SDL_bool valid;
+
+    fmt = SDL_AllocFormat(SDL_MasksToPixelFormatEnum(r->BytesPerPixel * 8,
+                                                     r->Rmask, r->Gmask, r->Bmask, r->Amask));
+    if (!fmt) {
+        return SDL_FALSE;
+    }
+    valid = (fmt->BytesPerPixel == r->BytesPerPixel &&
+             fmt->Rmask == r->Rmask && fmt->Gmask == r->Gmask &&
+             fmt->Bmask == r->Bmask && fmt->Amask == r->Amask &&
+             fmt->Rloss == r->Rloss && fmt->Gloss == r->Gloss &&
+             fmt->Bloss == r->Bloss && fmt->Aloss == r->Aloss &&
+             fmt->Rshift == r->Rshift && fmt->Gshift == r->Gshift &&
+             fmt->Bshift == r->Bshift && fmt->Ashift == r->Ashift);
+    SDL_FreeFormat(fmt);
+    return valid;
+}
+
+/* Reads one segment's counts, returning SDL_FALSE if they're past the end */
+#define READ_COUNTS(Ctype, skip, run)               \
+    if ((size_t) (end - p) < 2 * sizeof(Ctype)) {   \
+        return SDL_FALSE;                           \
+    }                                               \
+    skip = ((Ctype *) p)[0];                        \
+    run = ((Ctype *) p)[1];                         \
+    p += 2 * sizeof(Ctype);
+
+/* Walks RLE data that was read in, to be sure blitting it stays inside the
+   data and the surface. Every line has to add up to the width, and start
+   where the line offsets say. */
+static SDL_bool
+RLEDataIsValid(SDL_Surface * surface, Uint8 * data, size_t size, SDL_bool alpha)
+{
+    const int w = surface->w;
+    const int h = surface->h;
+    Uint32 *lineofs = (Uint32 *) data;
+    Uint8 *start, *p, *end;
+    unsigned skip, run;
+    int bpp;
+    int y;
+
+    if (size < (h + 1) * sizeof(Uint32)) {
+        return SDL_FALSE;
+    }
+    start = data + (h + 1) * sizeof(Uint32);
+    if (alpha) {
+        RLEDestFormat *r = (RLEDestFormat *) start;
+        if (size < (h + 1) * sizeof(Uint32) + sizeof(RLEDestFormat)) {
+            return SDL_FALSE;
+        }
+        bpp = r->BytesPerPixel;
+        if (surface->format->BytesPerPixel != 4 || (bpp != 2 && bpp != 4) ||
+            !RLEDestFormatIsValid(r)) {
+            return SDL_FALSE;
+        }
+        start += sizeof(RLEDestFormat);
+    } else {
+        bpp = surface->format->BytesPerPixel;
+    }
+    end = data + size;
+
+    p = start;
+    for (y = 0; y <= h; ++y) {
+        int ofs = 0;
+
+        if (lineofs[y] != (Uint32) (p - start)) {
+            return SDL_FALSE;
+        }
+        if (y == h) {
+            break;
+        }
+
+        /* opaque pixels, or all of them for colorkeyed data */
+        do {
+            if (bpp == 4) {
+                READ_COUNTS(Uint16, skip, run);
             } else {
-                if (!UnRLEAlpha(surface)) {
-                    /* Oh crap... */
-                    surface->flags |= SDL_RLEACCEL;
-                    return;
+                READ_COUNTS(Uint8, skip, run);
+            }
+            if (!skip && !run && !ofs) {
+                /* the end marker; the rest of the lines are blank */
+                p -= (bpp == 4) ? 4 : 2;
+                for (; y < h; ++y) {
+                    if (lineofs[y + 1] != (Uint32) (p - start)) {
+                        return SDL_FALSE;
+                    }
                 }
+                return (end - p == ((bpp == 4) ? 4 : 2));
             }
+            ofs += skip + run;
+            if (ofs > w || (size_t) (end - p) < run * bpp) {
+                return SDL_FALSE;
+            }
+            p += run * bpp;
+        } while (ofs < w);
+
+        if (alpha) {
+            /* translucent pixels, after padding to keep them aligned */
+            if (bpp == 2) {
+                p += (p - data) & 2;
+                if (p > end) {
+                    return SDL_FALSE;
+                }
+            }
+            ofs = 0;
+            do {
+                READ_COUNTS(Uint16, skip, run);
+                ofs += skip + run;
+                if (ofs > w || (size_t) (end - p) < run * 4) {
+                    return SDL_FALSE;
+                }
+                p += run * 4;
+            } while (ofs < w);
+        }
+    }
+
+    /* lines that aren't blank all the way down end with the end marker */
+    if (bpp == 4) {
+        READ_COUNTS(Uint16, skip, run);
+    } else {
+        READ_COUNTS(Uint8, skip, run);
+    }
+    return (!skip && !run && p == end);
+}
+
+#undef READ_COUNTS
+
+int
+SDL_SaveRLESurface_RW(SDL_Surface * surface, SDL_RWops * dst, int freedst)
+{
+    SDL_BlitMap *map;
+    size_t size;
+    int i, ncolors = 0;
+
+    if (!surface) {
+        SDL_InvalidParamError("surface");
+        goto done;
+    }
+    if (!dst) {
+        SDL_InvalidParamError("dst");
+        goto done;
+    }
+
+    map = surface->map;
+    if (!(map->info.flags & (SDL_COPY_RLE_COLORKEY | SDL_COPY_RLE_ALPHAKEY))) {
+        SDL_SetError("Surface isn't RLE encoded, blit it with SDL_RLEACCEL first");
+        goto done;
+    }
+    size = RLEDataSize(surface);
+    if (surface->format->palette) {
+        ncolors = surface->format->palette->ncolors;
+    }
+
+    SDL_ClearError();
+    SDL_WriteLE32(dst, RLE_FILE_MAGIC);
+    SDL_WriteLE32(dst, RLE_FILE_VERSION);
+    SDL_WriteLE32(dst, surface->format->format);
+    SDL_WriteLE32(dst, surface->w);
+    SDL_WriteLE32(dst, surface->h);
+    SDL_WriteLE32(dst, surface->pitch);
+    SDL_WriteLE32(dst, map->info.flags & RLE_FILE_FLAGS);
+    SDL_WriteLE32(dst, map->info.colorkey);
+    SDL_WriteU8(dst, map->info.r);
+    SDL_WriteU8(dst, map->info.g);
+    SDL_WriteU8(dst, map->info.b);
+    SDL_WriteU8(dst, map->info.a);
+    SDL_WriteLE32(dst, ncolors);
+    for (i = 0; i < ncolors; ++i) {
+        SDL_Color *color = &surface->format->palette->colors[i];
+        SDL_WriteU8(dst, color->r);
+        SDL_WriteU8(dst, color->g);
+        SDL_WriteU8(dst, color->b);
+        SDL_WriteU8(dst, color->a);
+    }
+    SDL_WriteLE32(dst, (Uint32) size);
+    if (SDL_RWwrite(dst, map->data, size, 1) != 1) {
+        SDL_Error(SDL_EFWRITE);
+    }
+
+  done:
+    if (freedst && dst) {
+        SDL_RWclose(dst);
+    }
+    return ((SDL_strcmp(SDL_GetError(), "") == 0) ? 0 : -1);
+}
+
+SDL_Surface *
+SDL_LoadRLESurface_RW(SDL_RWops * src, int freesrc)
+{
+    SDL_Surface *surface = NULL;
+    SDL_BlitMap *map;
+    Uint32 format, flags, colorkey, size;
+    Sint32 w, h, pitch;
+    Uint8 r, g, b, a;
+    Uint32 ncolors, i;
+    Uint8 *data = NULL;
+
+    if (!src) {
+        SDL_InvalidParamError("src");
+        goto error;
+    }
+
+    if (SDL_ReadLE32(src) != RLE_FILE_MAGIC) {
+        SDL_SetError("File is not an RLE surface");
+        goto error;
+    }
+    if (SDL_ReadLE32(src) != RLE_FILE_VERSION) {
+        SDL_SetError("Unsupported RLE surface version");
+        goto error;
+    }
+    format = SDL_ReadLE32(src);
+    w = (Sint32) SDL_ReadLE32(src);
+    h = (Sint32) SDL_ReadLE32(src);
+    pitch = (Sint32) SDL_ReadLE32(src);
+    flags = SDL_ReadLE32(src);
+    colorkey = SDL_ReadLE32(src);
+    r = SDL_ReadU8(src);
+    g = SDL_ReadU8(src);
+    b = SDL_ReadU8(src);
+    a = SDL_ReadU8(src);
+    ncolors = SDL_ReadLE32(src);
+
+    if (SDL_BITSPERPIXEL(format) < 8 || SDL_ISPIXELFORMAT_FOURCC(format) ||
+        w <= 0 || h <= 0 || w > 65535 || h > 65535 ||
+        pitch < w * SDL_BYTESPERPIXEL(format) || pitch > SDL_MAX_SINT32 / h || (pitch & 3) ||
+        (flags & ~RLE_FILE_FLAGS) ||
+        ((flags & SDL_COPY_RLE_COLORKEY) != 0) == ((flags & SDL_COPY_RLE_ALPHAKEY) != 0)) {
+        SDL_SetError("Corrupt RLE surface header");
+        goto error;
+    }
+
+    surface = SDL_CreateRGBSurfaceWithFormatFrom(NULL, w, h, 0, pitch, format);
+    if (!surface) {
+        goto error;
+    }
+    /* the pixels are allocated by the surface if they're ever decoded */
+    surface->flags &= ~SDL_PREALLOC;
+
+    if (ncolors) {
+        SDL_Palette *palette = surface->format->palette;
+        SDL_Color colors[256];
+
+        if (!palette || ncolors > (Uint32) palette->ncolors || ncolors > SDL_arraysize(colors)) {
+            SDL_SetError("Corrupt RLE surface palette");
+            goto error;
         }
-        surface->map->info.flags &=
-            ~(SDL_COPY_RLE_COLORKEY | SDL_COPY_RLE_ALPHAKEY);
+        for (i = 0; i < ncolors; ++i) {
+            colors[i].r = SDL_ReadU8(src);
+            colors[i].g = SDL_ReadU8(src);
+            colors[i].b = SDL_ReadU8(src);
+            colors[i].a = SDL_ReadU8(src);
+        }
+        SDL_SetPaletteColors(palette, colors, 0, ncolors);
+    }
+
+    /* The RLE data goes straight to where the surface keeps it */
+    size = SDL_ReadLE32(src);
+    data = (Uint8 *) SDL_malloc(size ? size : 1);
+    if (!data) {
+        SDL_OutOfMemory();
+        goto error;
+    }
+    if (SDL_RWread(src, data, size, 1) != 1) {
+        SDL_Error(SDL_EFREAD);
+        goto error;
+    }
+    if (!RLEDataIsValid(surface, data, size, (flags & SDL_COPY_RLE_ALPHAKEY) != 0)) {
+        SDL_SetError("Corrupt RLE surface data");
+        goto error;
+    }
+
+    map = surface->map;
+    map->info.flags = flags;
+    map->info.colorkey = colorkey;
+    map->info.r = r;
+    map->info.g = g;
+    map->info.b = b;
+    map->info.a = a;
+    map->data = data;
+    map->blit = (flags & SDL_COPY_RLE_COLORKEY) ? SDL_RLEBlit : SDL_RLEAlphaBlit;
+    map->blit_key = SDL_COPY_BLIT_KEY(flags);
+    map->rle_loaded = SDL_TRUE;
+    surface->flags |= SDL_RLEACCEL;
+
+    if (freesrc) {
+        SDL_RWclose(src);
+    }
+    return surface;
 
-        SDL_free(surface->map->data);
-        surface->map->data = NULL;
+  error:
+    SDL_free(data);
+    SDL_FreeSurface(surface);
+    if (freesrc && src) {
+        SDL_RWclose(src);
     }
+    return NULL;
 }
 
 /* vi: set ts=4 sw=4 expandtab: */
@@ -32,6 +32,12 @@ extern int SDLCALL SDL_RLEBlit     (SDL_Surface * src, SDL_Rect * srcrect,
 extern int SDLCALL SDL_RLEAlphaBlit(SDL_Surface * src, SDL_Rect * srcrect,
                                     SDL_Surface * dst, SDL_Rect * dstrect);
 extern void SDL_UnRLESurface(SDL_Surface * surface, int recode);
+/* Sets the RLE data aside while the surface is blitted some other way */
+extern int SDL_RLEPutAside(SDL_Surface * surface);
+/* Picks the RLE data back up if the surface's flags are the ones it was made for */
+extern SDL_bool SDL_RLETakeBack(SDL_Surface * surface);
+/* Uses RLE data loaded with SDL_LoadRLESurface_RW() if it suits the new mapping */
+extern SDL_bool SDL_RLEUseLoaded(SDL_Surface * surface);
 
 #endif /* SDL_RLEaccel_c_h_ */
 
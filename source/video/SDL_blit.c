@@ -25,6 +25,7 @@
 #include "SDL_blit.h"
 #include "SDL_blit_auto.h"
 #include "SDL_blit_copy.h"
+#include "SDL_blit_simd.h"
 #include "SDL_blit_slow.h"
 #include "SDL_RLEaccel_c.h"
 #include "SDL_pixels_c.h"
@@ -50,9 +51,10 @@ SDL_SoftBlit(SDL_Surface * src, SDL_Rect * srcrect,
             dst_locked = 1;
         }
     }
-    /* Lock the source if it's in hardware */
+    /* Lock the source if it's in hardware. RLE surfaces that kept their pixels
+       can be read as they are. */
     src_locked = 0;
-    if (SDL_MUSTLOCK(src)) {
+    if (SDL_MUSTLOCK(src) && !src->pixels) {
         if (SDL_LockSurface(src) < 0) {
             okay = 0;
         } else {
@@ -63,7 +65,9 @@ SDL_SoftBlit(SDL_Surface * src, SDL_Rect * srcrect,
     /* Set up source and destination buffer pointers, and BLIT! */
     if (okay && !SDL_RectEmpty(srcrect)) {
         SDL_BlitFunc RunBlit;
-        SDL_BlitInfo *info = &src->map->info;
+        /* A copy, so threads can blit from the same surface to different places at once */
+        SDL_BlitInfo blitinfo = src->map->info;
+        SDL_BlitInfo *info = &blitinfo;
 
         /* Set up the blit information */
         info->src = (Uint8 *) src->pixels +
@@ -124,11 +128,9 @@ SDL_UseAltivecPrefetch()
 }
 #endif /* __MACOSX__ */
 
-static SDL_BlitFunc
-SDL_ChooseBlitFunc(Uint32 src_format, Uint32 dst_format, int flags,
-                   SDL_BlitFuncEntry * entries)
+Uint32
+SDL_GetBlitCPUFeatures(void)
 {
-    int i, flagcheck;
     static Uint32 features = 0xffffffff;
 
     /* Get the available CPU features */
@@ -162,6 +164,15 @@ SDL_ChooseBlitFunc(Uint32 src_format, Uint32 dst_format, int flags,
             }
         }
     }
+    return features;
+}
+
+static SDL_BlitFunc
+SDL_ChooseBlitFunc(Uint32 src_format, Uint32 dst_format, int flags,
+                   SDL_BlitFuncEntry * entries)
+{
+    int i, flagcheck;
+    const Uint32 features = SDL_GetBlitCPUFeatures();
 
     for (i = 0; entries[i].func; ++i) {
         /* Check for matching pixel formats */
@@ -182,7 +193,7 @@ SDL_ChooseBlitFunc(Uint32 src_format, Uint32 dst_format, int flags,
         /* Check blend flags */
         flagcheck =
             (flags &
-             (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD));
+             (SDL_COPY_BLEND | SDL_COPY_BLEND_PREMULTIPLIED | SDL_COPY_ADD | SDL_COPY_MOD));
         if ((flagcheck & entries[i].flags) != flagcheck) {
             continue;
         }
@@ -225,8 +236,18 @@ SDL_CalculateBlit(SDL_Surface * surface)
         return SDL_SetError("Blit combination not supported");
     }
 
-    /* Clean everything out to start */
-    if ((surface->flags & SDL_RLEACCEL) == SDL_RLEACCEL) {
+    /* RLE data loaded ready-made is used as it is if it suits this mapping */
+    if (map->rle_loaded) {
+        map->rle_loaded = SDL_FALSE;
+        if (SDL_RLEUseLoaded(surface)) {
+            return 0;
+        }
+    }
+
+    /* Clean everything out to start, but leave any RLE data that was set aside
+       while RLE is still wanted */
+    if ((map->info.flags & (SDL_COPY_RLE_COLORKEY | SDL_COPY_RLE_ALPHAKEY)) ||
+        ((surface->flags & SDL_RLEACCEL) && !(map->info.flags & SDL_COPY_RLE_DESIRED))) {
         SDL_UnRLESurface(surface, 1);
     }
     map->blit = SDL_SoftBlit;
@@ -242,8 +263,16 @@ SDL_CalculateBlit(SDL_Surface * surface)
         }
     }
 
+    /* Colour-keyed copies between the common formats have SIMD versions */
+    if ((map->info.flags & ~SDL_COPY_RLE_MASK) == SDL_COPY_COLORKEY) {
+        blit = SDL_ChooseBlitFunc(surface->format->format, dst->format->format,
+                                  map->info.flags, SDL_SIMDKeyBlitFuncTable);
+    }
+
     /* Choose a standard blit function */
-    if (map->identity && !(map->info.flags & ~SDL_COPY_RLE_DESIRED)) {
+    if (blit) {
+        /* already chosen */
+    } else if (map->identity && !(map->info.flags & ~SDL_COPY_RLE_DESIRED)) {
         blit = SDL_BlitCopy;
     } else if (surface->format->Rloss > 8 || dst->format->Rloss > 8) {
         /* Greater than 8 bits per channel not supported yet */
@@ -255,7 +284,7 @@ SDL_CalculateBlit(SDL_Surface * surface)
     } else if (surface->format->BytesPerPixel == 1 &&
                SDL_ISPIXELFORMAT_INDEXED(surface->format->format)) {
         blit = SDL_CalculateBlit1(surface);
-    } else if (map->info.flags & SDL_COPY_BLEND) {
+    } else if (map->info.flags & (SDL_COPY_BLEND | SDL_COPY_BLEND_PREMULTIPLIED)) {
         blit = SDL_CalculateBlitA(surface);
     } else {
         blit = SDL_CalculateBlitN(surface);
@@ -266,7 +295,12 @@ SDL_CalculateBlit(SDL_Surface * surface)
 
         blit =
             SDL_ChooseBlitFunc(src_format, dst_format, map->info.flags,
-                               SDL_GeneratedBlitFuncTable);
+                               SDL_SIMDBlitFuncTable);
+        if (blit == NULL) {
+            blit =
+                SDL_ChooseBlitFunc(src_format, dst_format, map->info.flags,
+                                   SDL_GeneratedBlitFuncTable);
+        }
     }
 #ifndef TEST_SLOW_BLIT
     if (blit == NULL)
@@ -290,7 +324,52 @@ SDL_CalculateBlit(SDL_Surface * surface)
         return SDL_SetError("Blit combination not supported");
     }
 
+    /* Remember it in case the flags come back to these */
+    map->blit_key = SDL_COPY_BLIT_KEY(map->info.flags);
+    map->cache[map->next_cached].flags = map->blit_key;
+    map->cache[map->next_cached].func = blit;
+    map->next_cached = (map->next_cached + 1) % SDL_BLIT_CACHE_SIZE;
+    if (map->num_cached < SDL_BLIT_CACHE_SIZE) {
+        ++map->num_cached;
+    }
+
     return 0;
 }
 
+/* Catches the blitter up with flags that changed since it was chosen. Color and
+   alpha modulation are read at blit time, so going back to earlier flags only
+   needs the blitter that was chosen for them then. */
+int
+SDL_UpdateBlit(SDL_Surface * surface)
+{
+    SDL_BlitMap *map = surface->map;
+    const int key = SDL_COPY_BLIT_KEY(map->info.flags);
+    int i;
+
+    /* palette tables have the modulation built in, so those start over */
+    if (map->info.table || SDL_ISPIXELFORMAT_INDEXED(surface->format->format) ||
+        SDL_ISPIXELFORMAT_INDEXED(map->dst->format->format)) {
+        return SDL_MapSurface(surface, map->dst);
+    }
+
+    /* RLE data is kept for when the flags suit it again */
+    if (map->info.flags & (SDL_COPY_RLE_COLORKEY | SDL_COPY_RLE_ALPHAKEY)) {
+        if (SDL_RLEPutAside(surface) < 0) {
+            return SDL_MapSurface(surface, map->dst);
+        }
+    } else if (SDL_RLETakeBack(surface)) {
+        return 0;
+    }
+
+    for (i = 0; i < map->num_cached; ++i) {
+        if (map->cache[i].flags == key) {
+            map->blit = SDL_SoftBlit;
+            map->data = map->cache[i].func;
+            map->blit_key = key;
+            return 0;
+        }
+    }
+    return SDL_CalculateBlit(surface);
+}
+
 /* vi: set ts=4 sw=4 expandtab: */
@@ -27,6 +27,13 @@
 #include "SDL_endian.h"
 #include "SDL_surface.h"
 
+/* MSVC doesn't define __SSE__, but /arch:SSE, which the Xbox builds use, sets _M_IX86_FP */
+#if defined(__SSE__) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 1))
+#define HAVE_SSE_INTRINSICS 1
+#include <mmintrin.h>
+#include <xmmintrin.h>
+#endif
+
 /* Table to do pixel byte expansion */
 extern Uint8* SDL_expand_byte[9];
 
@@ -36,6 +43,7 @@ extern Uint8* SDL_expand_byte[9];
 #define SDL_COPY_BLEND              0x00000010
 #define SDL_COPY_ADD                0x00000020
 #define SDL_COPY_MOD                0x00000040
+#define SDL_COPY_BLEND_PREMULTIPLIED 0x00000080
 #define SDL_COPY_COLORKEY           0x00000100
 #define SDL_COPY_NEAREST            0x00000200
 #define SDL_COPY_RLE_DESIRED        0x00001000
@@ -43,6 +51,19 @@ extern Uint8* SDL_expand_byte[9];
 #define SDL_COPY_RLE_ALPHAKEY       0x00004000
 #define SDL_COPY_RLE_MASK           (SDL_COPY_RLE_DESIRED|SDL_COPY_RLE_COLORKEY|SDL_COPY_RLE_ALPHAKEY)
 
+/* The flags that decide which blitter is used, leaving out whether RLE data is in use */
+#define SDL_COPY_BLIT_KEY(flags)    ((flags) & ~(SDL_COPY_RLE_COLORKEY|SDL_COPY_RLE_ALPHAKEY))
+
+/* How many blitters a surface remembers for flags it was blitted with before */
+#define SDL_BLIT_CACHE_SIZE         4
+
+/* How many mappings to other destination formats a surface keeps for when it's
+   blitted to one of them again */
+#define SDL_BLIT_MAP_CACHE_SIZE     4
+
+/* Fills and copies bigger than the Xbox's 128K L2 cache write around it */
+#define SDL_STREAMING_THRESHOLD     (128 * 1024)
+
 /* SDL blit CPU flags */
 #define SDL_CPU_ANY                 0x00000000
 #define SDL_CPU_MMX                 0x00000001
@@ -82,6 +103,29 @@ typedef struct
     SDL_BlitFunc func;
 } SDL_BlitFuncEntry;
 
+typedef struct
+{
+    int flags;
+    SDL_BlitFunc func;
+} SDL_BlitCacheEntry;
+
+/* A mapping to an RGB destination format the surface was blitted to before */
+typedef struct
+{
+    Uint32 dst_format;          /* 0 for an unused entry */
+    Uint32 last_used;
+    int identity;
+    Uint8 *table;
+    Uint32 src_palette_version;
+    Uint8 r, g, b, a;           /* the modulation the table was made with */
+    SDL_blit blit;
+    SDL_BlitFunc func;
+    int blit_key;
+    SDL_BlitCacheEntry cache[SDL_BLIT_CACHE_SIZE];
+    int num_cached;
+    int next_cached;
+} SDL_BlitMapCacheEntry;
+
 /* Blit mapping definition */
 typedef struct SDL_BlitMap
 {
@@ -95,10 +139,41 @@ typedef struct SDL_BlitMap
        an invalid mapping */
     Uint32 dst_palette_version;
     Uint32 src_palette_version;
+
+    /* The flags blit was chosen for. When the surface's flags change, the
+       blitters chosen for earlier flags are tried before working out a new one. */
+    int blit_key;
+    SDL_BlitCacheEntry cache[SDL_BLIT_CACHE_SIZE];
+    int num_cached;
+    int next_cached;
+
+    /* RLE data set aside while the surface is blitted some way RLE can't do,
+       and whether the pixels are kept alongside RLE data from then on */
+    void *rle_data;
+    int rle_flags;
+    int rle_key;
+    SDL_bool keep_pixels;
+
+    /* RLE data read in by SDL_LoadRLESurface_RW() and not yet checked against
+       the destination the surface is mapped to */
+    SDL_bool rle_loaded;
+
+    /* Mappings to the other formats the surface was blitted to, so going back
+       to one of them doesn't work everything out again */
+    SDL_BlitMapCacheEntry map_cache[SDL_BLIT_MAP_CACHE_SIZE];
+    Uint32 map_clock;
 } SDL_BlitMap;
 
 /* Functions found in SDL_blit.c */
 extern int SDL_CalculateBlit(SDL_Surface * surface);
+extern int SDL_UpdateBlit(SDL_Surface * surface);
+extern Uint32 SDL_GetBlitCPUFeatures(void);
+
+/* Functions found in SDL_surface.c */
+extern void SDL_QuitConvert(void);
+
+/* Functions found in SDL_stretch.c */
+extern void SDL_QuitStretch(void);
 
 /* Functions found in SDL_blit_*.c */
 extern SDL_BlitFunc SDL_CalculateBlit0(SDL_Surface * surface);
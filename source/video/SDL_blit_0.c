@@ -472,9 +472,11 @@ SDL_CalculateBlit0(SDL_Surface * surface)
         return colorkey_blit[which];
 
     case SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND:
+    case SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND_PREMULTIPLIED:
         return which >= 2 ? BlitBtoNAlpha : (SDL_BlitFunc) NULL;
 
     case SDL_COPY_COLORKEY | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND:
+    case SDL_COPY_COLORKEY | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND_PREMULTIPLIED:
         return which >= 2 ? BlitBtoNAlphaKey : (SDL_BlitFunc) NULL;
     }
     return (SDL_BlitFunc) NULL;
@@ -238,12 +238,11 @@ Blit1to3(SDL_BlitInfo * info)
 static void
 Blit1to4(SDL_BlitInfo * info)
 {
-#ifndef USE_DUFFS_LOOP
     int c;
-#endif
     int width, height;
     Uint8 *src;
     Uint32 *map, *dst;
+    Uint32 indices;
     int srcskip, dstskip;
 
     /* Set up some basic variables */
@@ -255,29 +254,31 @@ Blit1to4(SDL_BlitInfo * info)
     dstskip = info->dst_skip / 4;
     map = (Uint32 *) info->table;
 
+    /* There's no gather to look up several pixels at once, so this reads
+       four indices with each load from an aligned source instead */
     while (height--) {
-#ifdef USE_DUFFS_LOOP
-        /* *INDENT-OFF* */
-        DUFFS_LOOP(
+        for (c = width; c && ((uintptr_t) src & 3); --c) {
             *dst++ = map[*src++];
-        , width);
-        /* *INDENT-ON* */
+        }
+        for (; c >= 4; c -= 4) {
+            indices = *(Uint32 *) src;
+            src += 4;
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+            dst[0] = map[indices & 0xFF];
+            dst[1] = map[(indices >> 8) & 0xFF];
+            dst[2] = map[(indices >> 16) & 0xFF];
+            dst[3] = map[indices >> 24];
 #else
-        for (c = width / 4; c; --c) {
-            *dst++ = map[*src++];
-            *dst++ = map[*src++];
-            *dst++ = map[*src++];
-            *dst++ = map[*src++];
+            dst[0] = map[indices >> 24];
+            dst[1] = map[(indices >> 16) & 0xFF];
+            dst[2] = map[(indices >> 8) & 0xFF];
+            dst[3] = map[indices & 0xFF];
+#endif
+            dst += 4;
         }
-        switch (width & 3) {
-        case 3:
-            *dst++ = map[*src++];
-        case 2:
-            *dst++ = map[*src++];
-        case 1:
+        for (; c; --c) {
             *dst++ = map[*src++];
         }
-#endif /* USE_DUFFS_LOOP */
         src += srcskip;
         dst += dstskip;
     }
@@ -538,12 +539,14 @@ SDL_CalculateBlit1(SDL_Surface * surface)
         return one_blitkey[which];
 
     case SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND:
+    case SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND_PREMULTIPLIED:
         /* Supporting 8bpp->8bpp alpha is doable but requires lots of
            tables which consume space and takes time to precompute,
            so is better left to the user */
         return which >= 2 ? Blit1toNAlpha : (SDL_BlitFunc) NULL;
 
     case SDL_COPY_COLORKEY | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND:
+    case SDL_COPY_COLORKEY | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND_PREMULTIPLIED:
         return which >= 2 ? Blit1toNAlphaKey : (SDL_BlitFunc) NULL;
     }
     return (SDL_BlitFunc) NULL;
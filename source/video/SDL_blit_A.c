@@ -387,6 +387,59 @@ BlitRGBtoRGBPixelAlphaMMX(SDL_BlitInfo * info)
     _mm_empty();
 }
 
+/* fast premultiplied ARGB888->(A)RGB888 blending with pixel alpha */
+static void
+BlitRGBtoRGBPremulPixelAlphaMMX(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *srcp = (Uint32 *) info->src;
+    int srcskip = info->src_skip >> 2;
+    Uint32 *dstp = (Uint32 *) info->dst;
+    int dstskip = info->dst_skip >> 2;
+
+    __m64 src1, dst1, mm_alpha, mm_zero;
+
+    mm_zero = _mm_setzero_si64();       /* 0 -> mm_zero */
+
+    while (height--) {
+        /* *INDENT-OFF* */
+        DUFFS_LOOP4({
+        Uint32 s = *srcp;
+        Uint32 alpha = s >> 24;
+        if (s == 0) {
+            /* do nothing */
+        } else if (alpha == SDL_ALPHA_OPAQUE) {
+            *dstp = s;
+        } else {
+            src1 = _mm_cvtsi32_si64(s); /* src(ARGB) -> src1 (0000ARGB) */
+            src1 = _mm_unpacklo_pi8(src1, mm_zero); /* 0A0R0G0B -> src1 */
+
+            dst1 = _mm_cvtsi32_si64(*dstp); /* dst(ARGB) -> dst1 (0000ARGB) */
+            dst1 = _mm_unpacklo_pi8(dst1, mm_zero); /* 0A0R0G0B -> dst1 */
+
+            mm_alpha = _mm_cvtsi32_si64(256 - alpha); /* 256 - alpha -> mm_alpha (0000000A) */
+            mm_alpha = _mm_unpacklo_pi16(mm_alpha, mm_alpha); /* 00000A0A -> mm_alpha */
+            mm_alpha = _mm_unpacklo_pi32(mm_alpha, mm_alpha); /* 0A0A0A0A -> mm_alpha */
+
+            /* blend, the source is already multiplied by its alpha */
+            dst1 = _mm_mullo_pi16(dst1, mm_alpha);
+            dst1 = _mm_srli_pi16(dst1, 8);
+            dst1 = _mm_add_pi16(src1, dst1);
+            dst1 = _mm_packs_pu16(dst1, mm_zero);
+
+            *dstp = _mm_cvtsi64_si32(dst1); /* dst1 -> pixel */
+        }
+        ++srcp;
+        ++dstp;
+        }, width);
+        /* *INDENT-ON* */
+        srcp += srcskip;
+        dstp += dstskip;
+    }
+    _mm_empty();
+}
+
 #endif /* __MMX__ */
 
 /* fast RGB888->(A)RGB888 blending with surface alpha=128 special case */
@@ -509,6 +562,52 @@ BlitRGBtoRGBPixelAlpha(SDL_BlitInfo * info)
     }
 }
 
+/* fast premultiplied ARGB888->(A)RGB888 blending with pixel alpha */
+static void
+BlitRGBtoRGBPremulPixelAlpha(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *srcp = (Uint32 *) info->src;
+    int srcskip = info->src_skip >> 2;
+    Uint32 *dstp = (Uint32 *) info->dst;
+    int dstskip = info->dst_skip >> 2;
+
+    while (height--) {
+        /* *INDENT-OFF* */
+        DUFFS_LOOP4({
+        Uint32 d;
+        Uint32 d1;
+        Uint32 s = *srcp;
+        Uint32 alpha = s >> 24;
+        /* Transparent pixels are all zero and leave the destination alone */
+        if (s) {
+          if (alpha == SDL_ALPHA_OPAQUE) {
+              *dstp = s;
+          } else {
+            /*
+             * The source already has its alpha applied, so only the
+             * destination is scaled, two components at a time, and
+             * the sums saturate in case the colors go past the alpha.
+             */
+            d = *dstp;
+            alpha = 256 - alpha;
+            d1 = (((d & 0xff00ff) * alpha >> 8) & 0xff00ff) + (s & 0xff00ff);
+            d = ((((d >> 8) & 0xff00ff) * alpha >> 8) & 0xff00ff) + ((s >> 8) & 0xff00ff);
+            d1 |= 0x1000100 - ((d1 >> 8) & 0x10001);
+            d |= 0x1000100 - ((d >> 8) & 0x10001);
+            *dstp = (d1 & 0xff00ff) | ((d & 0xff00ff) << 8);
+          }
+        }
+        ++srcp;
+        ++dstp;
+        }, width);
+        /* *INDENT-ON* */
+        srcp += srcskip;
+        dstp += dstskip;
+    }
+}
+
 #ifdef __3dNOW__
 /* fast (as in MMX with prefetch) ARGB888->(A)RGB888 blending with pixel alpha */
 static void
@@ -1270,8 +1369,27 @@ SDL_CalculateBlitA(SDL_Surface * surface)
 {
     SDL_PixelFormat *sf = surface->format;
     SDL_PixelFormat *df = surface->map->dst->format;
+    Uint32 flags = surface->map->info.flags & ~SDL_COPY_RLE_MASK;
+
+    if ((flags & SDL_COPY_BLEND_PREMULTIPLIED) && !sf->Amask) {
+        /* Opaque pixels come out the same with either kind of alpha */
+        flags = (flags & ~SDL_COPY_BLEND_PREMULTIPLIED) | SDL_COPY_BLEND;
+    }
+
+    switch (flags) {
+    case SDL_COPY_BLEND_PREMULTIPLIED:
+        if (df->BytesPerPixel == 4 && sf->BytesPerPixel == 4
+            && sf->Rmask == df->Rmask
+            && sf->Gmask == df->Gmask
+            && sf->Bmask == df->Bmask && sf->Amask == 0xff000000) {
+#ifdef __MMX__
+            if (SDL_HasMMX())
+                return BlitRGBtoRGBPremulPixelAlphaMMX;
+#endif
+            return BlitRGBtoRGBPremulPixelAlpha;
+        }
+        break;
 
-    switch (surface->map->info.flags & ~SDL_COPY_RLE_MASK) {
     case SDL_COPY_BLEND:
         /* Per-pixel alpha blits */
         switch (df->BytesPerPixel) {
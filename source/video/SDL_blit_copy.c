@@ -25,32 +25,61 @@
 #include "SDL_blit_copy.h"
 
 
-#ifdef __SSE__
-/* This assumes 16-byte aligned src and dst */
+#if HAVE_SSE_INTRINSICS
+/* Copies a row with stores that write around the cache, reading a few lines
+   ahead. The destination is lined up on 16 bytes first; the source may not be. */
 static SDL_INLINE void
 SDL_memcpySSE(Uint8 * dst, const Uint8 * src, int len)
 {
-    int i;
+    int i, adjust;
 
     __m128 values[4];
-    for (i = len / 64; i--;) {
-        _mm_prefetch(src, _MM_HINT_NTA);
-        values[0] = *(__m128 *) (src + 0);
-        values[1] = *(__m128 *) (src + 16);
-        values[2] = *(__m128 *) (src + 32);
-        values[3] = *(__m128 *) (src + 48);
-        _mm_stream_ps((float *) (dst + 0), values[0]);
-        _mm_stream_ps((float *) (dst + 16), values[1]);
-        _mm_stream_ps((float *) (dst + 32), values[2]);
-        _mm_stream_ps((float *) (dst + 48), values[3]);
-        src += 64;
-        dst += 64;
+
+    adjust = (int) ((16 - ((uintptr_t) dst & 15)) & 15);
+    if (adjust > len) {
+        adjust = len;
+    }
+    if (adjust) {
+        SDL_memcpy(dst, src, adjust);
+        dst += adjust;
+        src += adjust;
+        len -= adjust;
+    }
+
+    if ((uintptr_t) src & 15) {
+        for (i = len / 64; i--;) {
+            _mm_prefetch((const char *) src + 256, _MM_HINT_NTA);
+            values[0] = _mm_loadu_ps((const float *) (src + 0));
+            values[1] = _mm_loadu_ps((const float *) (src + 16));
+            values[2] = _mm_loadu_ps((const float *) (src + 32));
+            values[3] = _mm_loadu_ps((const float *) (src + 48));
+            _mm_stream_ps((float *) (dst + 0), values[0]);
+            _mm_stream_ps((float *) (dst + 16), values[1]);
+            _mm_stream_ps((float *) (dst + 32), values[2]);
+            _mm_stream_ps((float *) (dst + 48), values[3]);
+            src += 64;
+            dst += 64;
+        }
+    } else {
+        for (i = len / 64; i--;) {
+            _mm_prefetch((const char *) src + 256, _MM_HINT_NTA);
+            values[0] = *(__m128 *) (src + 0);
+            values[1] = *(__m128 *) (src + 16);
+            values[2] = *(__m128 *) (src + 32);
+            values[3] = *(__m128 *) (src + 48);
+            _mm_stream_ps((float *) (dst + 0), values[0]);
+            _mm_stream_ps((float *) (dst + 16), values[1]);
+            _mm_stream_ps((float *) (dst + 32), values[2]);
+            _mm_stream_ps((float *) (dst + 48), values[3]);
+            src += 64;
+            dst += 64;
+        }
     }
 
     if (len & 63)
         SDL_memcpy(dst, src, len & 63);
 }
-#endif /* __SSE__ */
+#endif /* HAVE_SSE_INTRINSICS */
 
 #ifdef __MMX__
 #ifdef _MSC_VER
@@ -127,15 +156,16 @@ SDL_BlitCopy(SDL_BlitInfo * info)
         return;
     }
 
-#ifdef __SSE__
-    if (SDL_HasSSE() &&
-        !((uintptr_t) src & 15) && !(srcskip & 15) &&
-        !((uintptr_t) dst & 15) && !(dstskip & 15)) {
+#if HAVE_SSE_INTRINSICS
+    /* Big copies write around the cache, so they don't push out what the
+       next blits need. Smaller ones are better off in it. */
+    if (SDL_HasSSE() && w * h >= SDL_STREAMING_THRESHOLD) {
         while (h--) {
             SDL_memcpySSE(dst, src, w);
             src += srcskip;
             dst += dstskip;
         }
+        _mm_sfence();
         return;
     }
 #endif
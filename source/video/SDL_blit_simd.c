@@ -0,0 +1,1270 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2019 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+/* SIMD versions of the SDL_blit_auto.c blitters for the 8888 formats whose
+   colour channels sit in the same bytes of the source and destination pixel,
+   which covers ARGB8888/RGB888 and ABGR8888/BGR888 in any combination. Every
+   modulate, blend and scale combination goes through the same code, and the
+   results match the generated blitters bit for bit.
+
+   Colour-keyed copies between 16-bit surfaces of one format, between those
+   8888 formats, and from RGB565 to them are here too, matching the
+   SDL_blit_N.c key blitters.
+
+   SDL_ConvertPixels() goes straight to the row converters at the end of the
+   file for the common 32, 24 and 16-bit RGB formats, without setting up
+   surfaces or a blit map.
+*/
+
+#include "SDL_video.h"
+#include "SDL_blit.h"
+#include "SDL_blit_simd.h"
+#include "SDL_pixels_c.h"
+
+#ifdef __SSE2__
+#define HAVE_SSE2_INTRINSICS 1
+#include <emmintrin.h>
+#endif
+
+#if HAVE_SSE_INTRINSICS || HAVE_SSE2_INTRINSICS
+
+/* What every pixel of a blit goes through, worked out from its flags once */
+typedef struct
+{
+    int mode;                   /* SDL_COPY_BLEND, SDL_COPY_BLEND_PREMULTIPLIED, SDL_COPY_ADD, SDL_COPY_MOD or 0 */
+    SDL_bool modulate;
+    SDL_bool modulate_alpha;
+    SDL_bool src_alpha;         /* otherwise the source is opaque */
+    Uint32 result_mask;         /* bits of the result that are stored */
+    Uint32 dst_mask;            /* bits of the destination that are kept */
+    Sint16 mod[8];              /* modulation of each byte of two pixels */
+    Sint16 alpha_mod[8];        /* alpha modulation of premultiplied colours */
+} SIMD_BlitState;
+
+typedef void (*SIMD_BlitRow) (const Uint32 * src, Uint32 * dst, int n,
+                              const SIMD_BlitState * state);
+
+/* Row functions for modulation only and each of the blend modes */
+typedef struct
+{
+    SIMD_BlitRow modulate;
+    SIMD_BlitRow blend;
+    SIMD_BlitRow blend_premultiplied;
+    SIMD_BlitRow add;
+    SIMD_BlitRow mod;
+} SIMD_BlitRows;
+
+/* Without modulation or blending there's nothing to vectorize */
+static void
+CopyRow(const Uint32 * src, Uint32 * dst, int n, const SIMD_BlitState * state)
+{
+    const Uint32 opaque = state->src_alpha ? 0 : 0xFF000000;
+    const Uint32 mask = state->result_mask;
+
+    while (n--) {
+        *dst++ = (*src++ | opaque) & mask;
+    }
+}
+
+static void
+SIMD_Blit(SDL_BlitInfo * info, const SIMD_BlitRows * rows)
+{
+    const int flags = info->flags;
+    SIMD_BlitRow blit_row;
+    SIMD_BlitState state;
+    SDL_bool copy_as_is;
+    Uint32 gathered[64];
+    int srcy, srcx;
+    int posy, posx;
+    int incy, incx;
+    int i;
+
+    state.mode = flags & (SDL_COPY_BLEND | SDL_COPY_BLEND_PREMULTIPLIED | SDL_COPY_ADD | SDL_COPY_MOD);
+    state.modulate = (flags & (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA)) ? SDL_TRUE : SDL_FALSE;
+    state.modulate_alpha = (flags & SDL_COPY_MODULATE_ALPHA) ? SDL_TRUE : SDL_FALSE;
+    state.src_alpha = info->src_fmt->Amask ? SDL_TRUE : SDL_FALSE;
+    for (i = 0; i < 8; i += 4) {
+        const SDL_bool color = (flags & SDL_COPY_MODULATE_COLOR) ? SDL_TRUE : SDL_FALSE;
+        state.mod[i + info->src_fmt->Rshift / 8] = color ? info->r : 255;
+        state.mod[i + info->src_fmt->Gshift / 8] = color ? info->g : 255;
+        state.mod[i + info->src_fmt->Bshift / 8] = color ? info->b : 255;
+        state.mod[i + 3] = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+        state.alpha_mod[i + 0] = state.alpha_mod[i + 1] = state.alpha_mod[i + 2] = info->a;
+        state.alpha_mod[i + 3] = 255;
+    }
+    if (!state.mode && !state.modulate && info->src_fmt->format == info->dst_fmt->format) {
+        /* a straight copy, which passes the unused byte of RGB888 through */
+        state.src_alpha = SDL_TRUE;
+        state.result_mask = 0xFFFFFFFF;
+        state.dst_mask = 0;
+    } else if (!info->dst_fmt->Amask) {
+        state.result_mask = 0x00FFFFFF;
+        state.dst_mask = 0;
+    } else if (state.mode == SDL_COPY_ADD || state.mode == SDL_COPY_MOD) {
+        state.result_mask = 0x00FFFFFF;
+        state.dst_mask = 0xFF000000;
+    } else {
+        state.result_mask = 0xFFFFFFFF;
+        state.dst_mask = 0;
+    }
+    copy_as_is = (!state.mode && !state.modulate && state.src_alpha &&
+                  state.result_mask == 0xFFFFFFFF) ? SDL_TRUE : SDL_FALSE;
+    switch (state.mode) {
+    case SDL_COPY_BLEND:
+        blit_row = rows->blend;
+        break;
+    case SDL_COPY_BLEND_PREMULTIPLIED:
+        blit_row = rows->blend_premultiplied;
+        break;
+    case SDL_COPY_ADD:
+        blit_row = rows->add;
+        break;
+    case SDL_COPY_MOD:
+        blit_row = rows->mod;
+        break;
+    default:
+        blit_row = state.modulate ? rows->modulate : CopyRow;
+        break;
+    }
+
+    if (!(flags & SDL_COPY_NEAREST)) {
+        while (info->dst_h--) {
+            blit_row((const Uint32 *) info->src, (Uint32 *) info->dst, info->dst_w, &state);
+            info->src += info->src_pitch;
+            info->dst += info->dst_pitch;
+        }
+        return;
+    }
+
+    /* Scaled blits gather the source pixels for part of a row at a time */
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *) info->dst;
+        int n = info->dst_w;
+        srcx = -1;
+        posx = 0x10000L;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *) (info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = SDL_min(n, (int) SDL_arraysize(gathered));
+            /* a copy can gather straight into the destination and fix it up there */
+            Uint32 *buffer = (blit_row == CopyRow) ? dst : gathered;
+            for (i = 0; i < count; ++i) {
+                while (posx >= 0x10000L) {
+                    ++srcx;
+                    posx -= 0x10000L;
+                }
+                buffer[i] = src[srcx];
+                posx += incx;
+            }
+            if (!copy_as_is) {
+                blit_row(buffer, dst, count, &state);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+/* What a colour-keyed copy does with each pixel: it's left alone if its colour
+   bits match the key, otherwise it's stored as (src & and_mask) | or_mask */
+typedef struct
+{
+    Uint32 key;
+    Uint32 key_mask;
+    Uint32 and_mask;
+    Uint32 or_mask;
+} SIMD_KeyState;
+
+static void
+GetKeyState(const SDL_BlitInfo * info, SIMD_KeyState * state)
+{
+    const SDL_PixelFormat *srcfmt = info->src_fmt;
+    const SDL_PixelFormat *dstfmt = info->dst_fmt;
+
+    state->key_mask = ~srcfmt->Amask;
+    state->key = info->colorkey & state->key_mask;
+    state->and_mask = 0xFFFFFFFF;
+    state->or_mask = 0;
+    if (!dstfmt->Amask) {
+        state->and_mask = dstfmt->Rmask | dstfmt->Gmask | dstfmt->Bmask;
+    } else if (!srcfmt->Amask) {
+        state->or_mask = (Uint32) info->a << dstfmt->Ashift;
+    }
+    if (srcfmt->BytesPerPixel == 2) {
+        state->key_mask &= 0xFFFF;
+    }
+}
+
+/* RGB565 to one of the 8888 formats, rounded like SDL_expand_byte */
+SDL_FORCE_INLINE Uint32
+KeyPixel565to8888(Uint16 pixel, const SDL_PixelFormat * dstfmt, Uint32 or_mask)
+{
+    unsigned r, g, b;
+
+    RGB_FROM_RGB565(pixel, r, g, b);
+    return (r << dstfmt->Rshift) | (g << dstfmt->Gshift) | (b << dstfmt->Bshift) | or_mask;
+}
+
+#endif /* HAVE_SSE_INTRINSICS || HAVE_SSE2_INTRINSICS */
+
+#if HAVE_SSE2_INTRINSICS
+
+/* x / 255 in each 16-bit lane, rounded down like the scalar blitters do, for x <= 255 * 255 */
+#define DIV255_SSE2(x) \
+    _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(x, _mm_set1_epi16(1)), _mm_srli_epi16(x, 8)), 8)
+
+/* Up to four pixels at once, the channels of two of them in each half. The
+   mode is always a constant, so each row function only has its own blending. */
+SDL_FORCE_INLINE __m128i
+BlitPixels_SSE2(__m128i src, __m128i dst, const SIMD_BlitState * state, const int mode)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i full = _mm_set1_epi16(255);
+    const __m128i alpha_lanes = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+    __m128i s[2], d[2], a;
+    int i;
+
+    s[0] = _mm_unpacklo_epi8(src, zero);
+    s[1] = _mm_unpackhi_epi8(src, zero);
+    d[0] = _mm_unpacklo_epi8(dst, zero);
+    d[1] = _mm_unpackhi_epi8(dst, zero);
+
+    for (i = 0; i < 2; ++i) {
+        if (!state->src_alpha) {
+            s[i] = _mm_or_si128(s[i], _mm_and_si128(alpha_lanes, full));
+        }
+        if (state->modulate) {
+            s[i] = DIV255_SSE2(_mm_mullo_epi16(s[i], _mm_loadu_si128((const __m128i *) state->mod)));
+        }
+        switch (mode) {
+        case SDL_COPY_BLEND:
+        case SDL_COPY_ADD:
+            /* premultiply the colour, keeping the alpha */
+            a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s[i], 0xFF), 0xFF);
+            d[i] = (mode == SDL_COPY_BLEND) ?
+                DIV255_SSE2(_mm_mullo_epi16(_mm_sub_epi16(full, a), d[i])) : d[i];
+            a = _mm_or_si128(_mm_andnot_si128(alpha_lanes, a), _mm_and_si128(alpha_lanes, full));
+            s[i] = DIV255_SSE2(_mm_mullo_epi16(s[i], a));
+            /* adding saturates when packed */
+            s[i] = _mm_add_epi16(s[i], d[i]);
+            break;
+        case SDL_COPY_BLEND_PREMULTIPLIED:
+            if (state->modulate_alpha) {
+                s[i] = DIV255_SSE2(_mm_mullo_epi16(s[i], _mm_loadu_si128((const __m128i *) state->alpha_mod)));
+            }
+            a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s[i], 0xFF), 0xFF);
+            d[i] = DIV255_SSE2(_mm_mullo_epi16(_mm_sub_epi16(full, a), d[i]));
+            s[i] = _mm_add_epi16(s[i], d[i]);
+            break;
+        case SDL_COPY_MOD:
+            s[i] = DIV255_SSE2(_mm_mullo_epi16(s[i], d[i]));
+            break;
+        }
+    }
+
+    return _mm_or_si128(_mm_and_si128(_mm_packus_epi16(s[0], s[1]), _mm_set1_epi32(state->result_mask)),
+                        _mm_and_si128(dst, _mm_set1_epi32(state->dst_mask)));
+}
+
+#define DEFINE_BLIT_ROW_SSE2(name, mode) \
+static void name(const Uint32 *src, Uint32 *dst, int n, const SIMD_BlitState *state) \
+{ \
+    while (n >= 4) { \
+        const __m128i s = _mm_loadu_si128((const __m128i *) src); \
+        const __m128i d = _mm_loadu_si128((const __m128i *) dst); \
+        _mm_storeu_si128((__m128i *) dst, BlitPixels_SSE2(s, d, state, mode)); \
+        src += 4; \
+        dst += 4; \
+        n -= 4; \
+    } \
+    while (n--) { \
+        const __m128i s = _mm_cvtsi32_si128(*src); \
+        const __m128i d = _mm_cvtsi32_si128(*dst); \
+        *dst = (Uint32) _mm_cvtsi128_si32(BlitPixels_SSE2(s, d, state, mode)); \
+        ++src; \
+        ++dst; \
+    } \
+}
+/* *INDENT-OFF* */
+DEFINE_BLIT_ROW_SSE2(BlitRowModulate_SSE2, 0)
+DEFINE_BLIT_ROW_SSE2(BlitRowBlend_SSE2, SDL_COPY_BLEND)
+DEFINE_BLIT_ROW_SSE2(BlitRowBlendPremultiplied_SSE2, SDL_COPY_BLEND_PREMULTIPLIED)
+DEFINE_BLIT_ROW_SSE2(BlitRowAdd_SSE2, SDL_COPY_ADD)
+DEFINE_BLIT_ROW_SSE2(BlitRowMod_SSE2, SDL_COPY_MOD)
+/* *INDENT-ON* */
+
+static const SIMD_BlitRows rows_SSE2 = {
+    BlitRowModulate_SSE2, BlitRowBlend_SSE2, BlitRowBlendPremultiplied_SSE2,
+    BlitRowAdd_SSE2, BlitRowMod_SSE2
+};
+
+static void
+SDL_Blit_8888_SSE2(SDL_BlitInfo * info)
+{
+    SIMD_Blit(info, &rows_SSE2);
+}
+
+/* Eight pixels at a time, keeping the destination wherever the key matched */
+static void
+SDL_BlitKey16_SSE2(SDL_BlitInfo * info)
+{
+    SIMD_KeyState state;
+    __m128i key, key_mask;
+    int n;
+
+    GetKeyState(info, &state);
+    key = _mm_set1_epi16((short) state.key);
+    key_mask = _mm_set1_epi16((short) state.key_mask);
+
+    while (info->dst_h--) {
+        const Uint16 *src = (const Uint16 *) info->src;
+        Uint16 *dst = (Uint16 *) info->dst;
+        for (n = info->dst_w; n >= 8; n -= 8, src += 8, dst += 8) {
+            const __m128i s = _mm_loadu_si128((const __m128i *) src);
+            const __m128i d = _mm_loadu_si128((const __m128i *) dst);
+            const __m128i keyed = _mm_cmpeq_epi16(_mm_and_si128(s, key_mask), key);
+            _mm_storeu_si128((__m128i *) dst, _mm_or_si128(_mm_and_si128(keyed, d), _mm_andnot_si128(keyed, s)));
+        }
+        for (; n; --n, ++src, ++dst) {
+            if ((*src & state.key_mask) != state.key) {
+                *dst = *src;
+            }
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+/* Four pixels at a time */
+static void
+SDL_BlitKey32_SSE2(SDL_BlitInfo * info)
+{
+    SIMD_KeyState state;
+    __m128i key, key_mask, and_mask, or_mask;
+    int n;
+
+    GetKeyState(info, &state);
+    key = _mm_set1_epi32(state.key);
+    key_mask = _mm_set1_epi32(state.key_mask);
+    and_mask = _mm_set1_epi32(state.and_mask);
+    or_mask = _mm_set1_epi32(state.or_mask);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *) info->src;
+        Uint32 *dst = (Uint32 *) info->dst;
+        for (n = info->dst_w; n >= 4; n -= 4, src += 4, dst += 4) {
+            const __m128i s = _mm_loadu_si128((const __m128i *) src);
+            const __m128i d = _mm_loadu_si128((const __m128i *) dst);
+            const __m128i keyed = _mm_cmpeq_epi32(_mm_and_si128(s, key_mask), key);
+            const __m128i p = _mm_or_si128(_mm_and_si128(s, and_mask), or_mask);
+            _mm_storeu_si128((__m128i *) dst, _mm_or_si128(_mm_and_si128(keyed, d), _mm_andnot_si128(keyed, p)));
+        }
+        for (; n; --n, ++src, ++dst) {
+            if ((*src & state.key_mask) != state.key) {
+                *dst = (*src & state.and_mask) | state.or_mask;
+            }
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+/* Eight pixels at a time. The channels are widened with multiplies that round
+   the same as the expand tables, then paired up into the bytes of the result. */
+static void
+SDL_BlitKey565to8888_SSE2(SDL_BlitInfo * info)
+{
+    const SDL_PixelFormat *dstfmt = info->dst_fmt;
+    const SDL_bool red_first = (dstfmt->Rshift == 0) ? SDL_TRUE : SDL_FALSE;
+    SIMD_KeyState state;
+    __m128i key, key_mask, alpha;
+    int n;
+
+    GetKeyState(info, &state);
+    key = _mm_set1_epi16((short) state.key);
+    key_mask = _mm_set1_epi16((short) state.key_mask);
+    alpha = _mm_set1_epi16((short) (state.or_mask >> 16));
+
+    while (info->dst_h--) {
+        const Uint16 *src = (const Uint16 *) info->src;
+        Uint32 *dst = (Uint32 *) info->dst;
+        for (n = info->dst_w; n >= 8; n -= 8, src += 8, dst += 8) {
+            const __m128i s = _mm_loadu_si128((const __m128i *) src);
+            const __m128i keyed = _mm_cmpeq_epi16(_mm_and_si128(s, key_mask), key);
+            const __m128i r = _mm_mulhi_epi16(_mm_and_si128(_mm_srli_epi16(s, 3), _mm_set1_epi16(0x1F00)), _mm_set1_epi16(2106));
+            const __m128i g = _mm_mulhi_epi16(_mm_and_si128(s, _mm_set1_epi16(0x07E0)), _mm_set1_epi16(8290));
+            const __m128i b = _mm_mulhi_epi16(_mm_and_si128(_mm_slli_epi16(s, 8), _mm_set1_epi16(0x1F00)), _mm_set1_epi16(2106));
+            const __m128i lo = _mm_or_si128(_mm_slli_epi16(g, 8), red_first ? r : b);
+            const __m128i hi = _mm_or_si128(alpha, red_first ? b : r);
+            __m128i p, d, k;
+
+            p = _mm_unpacklo_epi16(lo, hi);
+            k = _mm_unpacklo_epi16(keyed, keyed);
+            d = _mm_loadu_si128((const __m128i *) dst);
+            _mm_storeu_si128((__m128i *) dst, _mm_or_si128(_mm_and_si128(k, d), _mm_andnot_si128(k, p)));
+            p = _mm_unpackhi_epi16(lo, hi);
+            k = _mm_unpackhi_epi16(keyed, keyed);
+            d = _mm_loadu_si128((const __m128i *) (dst + 4));
+            _mm_storeu_si128((__m128i *) (dst + 4), _mm_or_si128(_mm_and_si128(k, d), _mm_andnot_si128(k, p)));
+        }
+        for (; n; --n, ++src, ++dst) {
+            if ((*src & state.key_mask) != state.key) {
+                *dst = KeyPixel565to8888(*src, dstfmt, state.or_mask);
+            }
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+#endif /* HAVE_SSE2_INTRINSICS */
+
+#if HAVE_SSE_INTRINSICS
+
+/* MMX registers only hold one pixel's channels, but the Pentium III has SSE's
+   additions to them, which include the shuffle used to spread the alpha */
+#define DIV255_MMX(x) \
+    _mm_srli_pi16(_mm_add_pi16(_mm_add_pi16(x, _mm_set1_pi16(1)), _mm_srli_pi16(x, 8)), 8)
+
+SDL_FORCE_INLINE Uint32
+BlitPixel_MMX(Uint32 src, Uint32 dst, __m64 mod, __m64 alpha_mod,
+              const SIMD_BlitState * state, const int mode)
+{
+    const __m64 zero = _mm_setzero_si64();
+    const __m64 full = _mm_set1_pi16(255);
+    const __m64 alpha_lane = _mm_set_pi16(-1, 0, 0, 0);
+    __m64 s, d, a;
+
+    s = _mm_unpacklo_pi8(_mm_cvtsi32_si64(src), zero);
+    d = _mm_unpacklo_pi8(_mm_cvtsi32_si64(dst), zero);
+
+    if (!state->src_alpha) {
+        s = _mm_or_si64(s, _mm_and_si64(alpha_lane, full));
+    }
+    if (state->modulate) {
+        s = DIV255_MMX(_mm_mullo_pi16(s, mod));
+    }
+    switch (mode) {
+    case SDL_COPY_BLEND:
+    case SDL_COPY_ADD:
+        /* premultiply the colour, keeping the alpha */
+        a = _mm_shuffle_pi16(s, 0xFF);
+        if (mode == SDL_COPY_BLEND) {
+            d = DIV255_MMX(_mm_mullo_pi16(_mm_sub_pi16(full, a), d));
+        }
+        a = _mm_or_si64(_mm_andnot_si64(alpha_lane, a), _mm_and_si64(alpha_lane, full));
+        s = DIV255_MMX(_mm_mullo_pi16(s, a));
+        /* adding saturates when packed */
+        s = _mm_add_pi16(s, d);
+        break;
+    case SDL_COPY_BLEND_PREMULTIPLIED:
+        if (state->modulate_alpha) {
+            s = DIV255_MMX(_mm_mullo_pi16(s, alpha_mod));
+        }
+        a = _mm_shuffle_pi16(s, 0xFF);
+        d = DIV255_MMX(_mm_mullo_pi16(_mm_sub_pi16(full, a), d));
+        s = _mm_add_pi16(s, d);
+        break;
+    case SDL_COPY_MOD:
+        s = DIV255_MMX(_mm_mullo_pi16(s, d));
+        break;
+    }
+
+    return ((Uint32) _mm_cvtsi64_si32(_mm_packs_pu16(s, zero)) & state->result_mask) |
+           (dst & state->dst_mask);
+}
+
+#define DEFINE_BLIT_ROW_MMX(name, mode) \
+static void name(const Uint32 *src, Uint32 *dst, int n, const SIMD_BlitState *state) \
+{ \
+    const __m64 mod = _mm_set_pi16(state->mod[3], state->mod[2], state->mod[1], state->mod[0]); \
+    const __m64 alpha_mod = _mm_set_pi16(255, state->alpha_mod[0], state->alpha_mod[0], state->alpha_mod[0]); \
+    while (n >= 4) { \
+        dst[0] = BlitPixel_MMX(src[0], dst[0], mod, alpha_mod, state, mode); \
+        dst[1] = BlitPixel_MMX(src[1], dst[1], mod, alpha_mod, state, mode); \
+        dst[2] = BlitPixel_MMX(src[2], dst[2], mod, alpha_mod, state, mode); \
+        dst[3] = BlitPixel_MMX(src[3], dst[3], mod, alpha_mod, state, mode); \
+        src += 4; \
+        dst += 4; \
+        n -= 4; \
+    } \
+    while (n--) { \
+        *dst = BlitPixel_MMX(*src, *dst, mod, alpha_mod, state, mode); \
+        ++src; \
+        ++dst; \
+    } \
+}
+/* *INDENT-OFF* */
+DEFINE_BLIT_ROW_MMX(BlitRowModulate_MMX, 0)
+DEFINE_BLIT_ROW_MMX(BlitRowBlend_MMX, SDL_COPY_BLEND)
+DEFINE_BLIT_ROW_MMX(BlitRowBlendPremultiplied_MMX, SDL_COPY_BLEND_PREMULTIPLIED)
+DEFINE_BLIT_ROW_MMX(BlitRowAdd_MMX, SDL_COPY_ADD)
+DEFINE_BLIT_ROW_MMX(BlitRowMod_MMX, SDL_COPY_MOD)
+/* *INDENT-ON* */
+
+static const SIMD_BlitRows rows_MMX = {
+    BlitRowModulate_MMX, BlitRowBlend_MMX, BlitRowBlendPremultiplied_MMX,
+    BlitRowAdd_MMX, BlitRowMod_MMX
+};
+
+static void
+SDL_Blit_8888_MMX(SDL_BlitInfo * info)
+{
+    SIMD_Blit(info, &rows_MMX);
+    _mm_empty();
+}
+
+/* Four pixels at a time, keeping the destination wherever the key matched */
+static void
+SDL_BlitKey16_MMX(SDL_BlitInfo * info)
+{
+    SIMD_KeyState state;
+    __m64 key, key_mask;
+    int n;
+
+    GetKeyState(info, &state);
+    key = _mm_set1_pi16((short) state.key);
+    key_mask = _mm_set1_pi16((short) state.key_mask);
+
+    while (info->dst_h--) {
+        const Uint16 *src = (const Uint16 *) info->src;
+        Uint16 *dst = (Uint16 *) info->dst;
+        for (n = info->dst_w; n >= 4; n -= 4, src += 4, dst += 4) {
+            const __m64 s = *(const __m64 *) src;
+            const __m64 d = *(const __m64 *) dst;
+            const __m64 keyed = _mm_cmpeq_pi16(_mm_and_si64(s, key_mask), key);
+            *(__m64 *) dst = _mm_or_si64(_mm_and_si64(keyed, d), _mm_andnot_si64(keyed, s));
+        }
+        for (; n; --n, ++src, ++dst) {
+            if ((*src & state.key_mask) != state.key) {
+                *dst = *src;
+            }
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+    _mm_empty();
+}
+
+/* Four pixels at a time, two in each register */
+static void
+SDL_BlitKey32_MMX(SDL_BlitInfo * info)
+{
+    SIMD_KeyState state;
+    __m64 key, key_mask, and_mask, or_mask;
+    int n, i;
+
+    GetKeyState(info, &state);
+    key = _mm_set1_pi32(state.key);
+    key_mask = _mm_set1_pi32(state.key_mask);
+    and_mask = _mm_set1_pi32(state.and_mask);
+    or_mask = _mm_set1_pi32(state.or_mask);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *) info->src;
+        Uint32 *dst = (Uint32 *) info->dst;
+        for (n = info->dst_w; n >= 4; n -= 4, src += 4, dst += 4) {
+            for (i = 0; i < 4; i += 2) {
+                const __m64 s = *(const __m64 *) (src + i);
+                const __m64 d = *(const __m64 *) (dst + i);
+                const __m64 keyed = _mm_cmpeq_pi32(_mm_and_si64(s, key_mask), key);
+                const __m64 p = _mm_or_si64(_mm_and_si64(s, and_mask), or_mask);
+                *(__m64 *) (dst + i) = _mm_or_si64(_mm_and_si64(keyed, d), _mm_andnot_si64(keyed, p));
+            }
+        }
+        for (; n; --n, ++src, ++dst) {
+            if ((*src & state.key_mask) != state.key) {
+                *dst = (*src & state.and_mask) | state.or_mask;
+            }
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+    _mm_empty();
+}
+
+/* Four pixels at a time, widened like the SSE2 version */
+static void
+SDL_BlitKey565to8888_MMX(SDL_BlitInfo * info)
+{
+    const SDL_PixelFormat *dstfmt = info->dst_fmt;
+    const SDL_bool red_first = (dstfmt->Rshift == 0) ? SDL_TRUE : SDL_FALSE;
+    SIMD_KeyState state;
+    __m64 key, key_mask, alpha;
+    int n;
+
+    GetKeyState(info, &state);
+    key = _mm_set1_pi16((short) state.key);
+    key_mask = _mm_set1_pi16((short) state.key_mask);
+    alpha = _mm_set1_pi16((short) (state.or_mask >> 16));
+
+    while (info->dst_h--) {
+        const Uint16 *src = (const Uint16 *) info->src;
+        Uint32 *dst = (Uint32 *) info->dst;
+        for (n = info->dst_w; n >= 4; n -= 4, src += 4, dst += 4) {
+            const __m64 s = *(const __m64 *) src;
+            const __m64 keyed = _mm_cmpeq_pi16(_mm_and_si64(s, key_mask), key);
+            const __m64 r = _mm_mulhi_pi16(_mm_and_si64(_mm_srli_pi16(s, 3), _mm_set1_pi16(0x1F00)), _mm_set1_pi16(2106));
+            const __m64 g = _mm_mulhi_pi16(_mm_and_si64(s, _mm_set1_pi16(0x07E0)), _mm_set1_pi16(8290));
+            const __m64 b = _mm_mulhi_pi16(_mm_and_si64(_mm_slli_pi16(s, 8), _mm_set1_pi16(0x1F00)), _mm_set1_pi16(2106));
+            const __m64 lo = _mm_or_si64(_mm_slli_pi16(g, 8), red_first ? r : b);
+            const __m64 hi = _mm_or_si64(alpha, red_first ? b : r);
+            __m64 p, k;
+
+            p = _mm_unpacklo_pi16(lo, hi);
+            k = _mm_unpacklo_pi16(keyed, keyed);
+            *(__m64 *) dst = _mm_or_si64(_mm_and_si64(k, *(const __m64 *) dst), _mm_andnot_si64(k, p));
+            p = _mm_unpackhi_pi16(lo, hi);
+            k = _mm_unpackhi_pi16(keyed, keyed);
+            *(__m64 *) (dst + 2) = _mm_or_si64(_mm_and_si64(k, *(const __m64 *) (dst + 2)), _mm_andnot_si64(k, p));
+        }
+        for (; n; --n, ++src, ++dst) {
+            if ((*src & state.key_mask) != state.key) {
+                *dst = KeyPixel565to8888(*src, dstfmt, state.or_mask);
+            }
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+    _mm_empty();
+}
+
+#endif /* HAVE_SSE_INTRINSICS */
+
+#define SIMD_BLIT_FLAGS (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_BLEND_PREMULTIPLIED | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST)
+
+#define SIMD_BLIT_ENTRIES(cpu, func) \
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, SIMD_BLIT_FLAGS, cpu, func }, \
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, SIMD_BLIT_FLAGS, cpu, func }, \
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, SIMD_BLIT_FLAGS, cpu, func }, \
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, SIMD_BLIT_FLAGS, cpu, func }, \
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, SIMD_BLIT_FLAGS, cpu, func }, \
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ABGR8888, SIMD_BLIT_FLAGS, cpu, func }, \
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, SIMD_BLIT_FLAGS, cpu, func }, \
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ABGR8888, SIMD_BLIT_FLAGS, cpu, func },
+
+/* *INDENT-OFF* */
+SDL_BlitFuncEntry SDL_SIMDBlitFuncTable[] = {
+#if HAVE_SSE2_INTRINSICS
+    SIMD_BLIT_ENTRIES(SDL_CPU_SSE2, SDL_Blit_8888_SSE2)
+#endif
+#if HAVE_SSE_INTRINSICS
+    SIMD_BLIT_ENTRIES(SDL_CPU_MMX | SDL_CPU_SSE, SDL_Blit_8888_MMX)
+#endif
+    { 0, 0, 0, 0, NULL }
+};
+/* *INDENT-ON* */
+
+#define SIMD_KEY_BLIT_ENTRIES(cpu, key16, key32, key565) \
+    { SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_RGB565, SDL_COPY_COLORKEY, cpu, key16 }, \
+    { SDL_PIXELFORMAT_BGR565, SDL_PIXELFORMAT_BGR565, SDL_COPY_COLORKEY, cpu, key16 }, \
+    { SDL_PIXELFORMAT_RGB555, SDL_PIXELFORMAT_RGB555, SDL_COPY_COLORKEY, cpu, key16 }, \
+    { SDL_PIXELFORMAT_ARGB1555, SDL_PIXELFORMAT_ARGB1555, SDL_COPY_COLORKEY, cpu, key16 }, \
+    { SDL_PIXELFORMAT_ARGB4444, SDL_PIXELFORMAT_ARGB4444, SDL_COPY_COLORKEY, cpu, key16 }, \
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, SDL_COPY_COLORKEY, cpu, key32 }, \
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, SDL_COPY_COLORKEY, cpu, key32 }, \
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, SDL_COPY_COLORKEY, cpu, key32 }, \
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, SDL_COPY_COLORKEY, cpu, key32 }, \
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, SDL_COPY_COLORKEY, cpu, key32 }, \
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ABGR8888, SDL_COPY_COLORKEY, cpu, key32 }, \
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, SDL_COPY_COLORKEY, cpu, key32 }, \
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ABGR8888, SDL_COPY_COLORKEY, cpu, key32 }, \
+    { SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_RGB888, SDL_COPY_COLORKEY, cpu, key565 }, \
+    { SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_ARGB8888, SDL_COPY_COLORKEY, cpu, key565 }, \
+    { SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_BGR888, SDL_COPY_COLORKEY, cpu, key565 }, \
+    { SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_ABGR8888, SDL_COPY_COLORKEY, cpu, key565 },
+
+/* *INDENT-OFF* */
+SDL_BlitFuncEntry SDL_SIMDKeyBlitFuncTable[] = {
+#if HAVE_SSE2_INTRINSICS
+    SIMD_KEY_BLIT_ENTRIES(SDL_CPU_SSE2, SDL_BlitKey16_SSE2, SDL_BlitKey32_SSE2, SDL_BlitKey565to8888_SSE2)
+#endif
+#if HAVE_SSE_INTRINSICS
+    SIMD_KEY_BLIT_ENTRIES(SDL_CPU_MMX, SDL_BlitKey16_MMX, SDL_BlitKey32_MMX, SDL_BlitKey565to8888_MMX)
+#endif
+    { 0, 0, 0, 0, NULL }
+};
+/* *INDENT-ON* */
+
+/* Direct conversions for SDL_ConvertPixels() between the packed RGB formats,
+   a row at a time, with nothing to set up but the shifts below. Each channel
+   keeps the bits the destination has room for and is moved to its place in
+   the destination pixel, while 5 and 6-bit channels are widened the way the
+   blit map's blitters do it. Unused bits of the destination are zeroed.
+
+   Only the SIMD converters are used: the scalar ones below finish off the
+   rows, and without SSE2 the blit map's blitters are as fast for everything
+   but RGB555, which only has the generic ones. */
+
+/* Channels that stay where they are share keep_mask. The ones that move the
+   same distance share a move, where the bits in mask are shifted by shift:
+   left for the first num_left moves, right for the others. or_mask fills in
+   the alpha of a destination the source has no alpha for. */
+typedef struct
+{
+    Uint32 keep_mask;
+    int num_left;
+    int num_moves;
+    Uint32 mask[4];
+    int shift[4];
+    Uint32 or_mask;
+
+    /* 16-bit sources: the red, green and blue bits are shifted by wide_left
+       and wide_right, masked with wide_mask and multiplied by wide_mult,
+       which leaves the widened channel in the low byte, like the colour-key
+       blitters do it. Bits in wide_split are widened on their own and added
+       in. It's then shifted left by dst_shift. */
+    int wide_left[3];
+    int wide_right[3];
+    Uint16 wide_mask[3];
+    Uint16 wide_split[3];
+    Uint16 wide_mult[3];
+    int dst_shift[3];
+    SDL_PixelFormat src_fmt;
+} SIMD_ConvertState;
+
+typedef void (*SIMD_ConvertRow) (const Uint8 * src, Uint8 * dst, int n,
+                                 const SIMD_ConvertState * state);
+
+typedef struct
+{
+    int src_bpp;
+    int dst_bpp;
+    Uint32 cpu;
+    Uint32 format;      /* 0, or the format one side has to be */
+    SIMD_ConvertRow func;
+} SIMD_ConvertRowEntry;
+
+static SDL_bool
+IsDirectConvertFormat(Uint32 format)
+{
+    switch (format) {
+    case SDL_PIXELFORMAT_ARGB8888:
+    case SDL_PIXELFORMAT_ABGR8888:
+    case SDL_PIXELFORMAT_RGBA8888:
+    case SDL_PIXELFORMAT_BGRA8888:
+    case SDL_PIXELFORMAT_RGB888:
+    case SDL_PIXELFORMAT_BGR888:
+    case SDL_PIXELFORMAT_RGB24:
+    case SDL_PIXELFORMAT_BGR24:
+    case SDL_PIXELFORMAT_RGB565:
+    case SDL_PIXELFORMAT_RGB555:
+        return SDL_TRUE;
+    default:
+        return SDL_FALSE;
+    }
+}
+
+static void
+AddChannelMove(SIMD_ConvertState * state, Uint32 src_mask, int src_shift,
+               int src_loss, int dst_shift, int dst_loss)
+{
+    /* The bits the destination keeps, and how far they go */
+    const Uint32 mask = src_mask & (src_mask << (dst_loss - src_loss));
+    const int distance = dst_shift - (src_shift + dst_loss - src_loss);
+    const int first = (distance > 0) ? 0 : state->num_left;
+    const int last = (distance > 0) ? state->num_left : state->num_moves;
+    const int shift = (distance > 0) ? distance : -distance;
+    int i;
+
+    if (distance == 0) {
+        state->keep_mask |= mask;
+        return;
+    }
+    for (i = first; i < last; ++i) {
+        if (state->shift[i] == shift) {
+            state->mask[i] |= mask;
+            return;
+        }
+    }
+    /* make room after the other moves the same way */
+    for (i = state->num_moves; i > last; --i) {
+        state->mask[i] = state->mask[i - 1];
+        state->shift[i] = state->shift[i - 1];
+    }
+    state->mask[last] = mask;
+    state->shift[last] = shift;
+    if (distance > 0) {
+        ++state->num_left;
+    }
+    ++state->num_moves;
+}
+
+static void
+AddChannelWiden(SIMD_ConvertState * state, int i, Uint32 src_mask, int src_shift,
+                int src_loss, int dst_shift)
+{
+    /* 5-bit channels are multiplied from bit 8, 6-bit ones from bit 5 */
+    const int from = (src_loss == 3) ? 8 : 5;
+
+    state->wide_left[i] = (from > src_shift) ? (from - src_shift) : 0;
+    state->wide_right[i] = (from < src_shift) ? (src_shift - from) : 0;
+    state->wide_mask[i] = (Uint16) ((src_mask >> src_shift) << from);
+    state->wide_mult[i] = (src_loss == 3) ? 2106 : 8290;
+    if (src_loss == 2) {
+        /* The RGB565 lookup tables of the blit map path widen the top and
+           bottom three bits of green separately and add them up */
+        state->wide_split[i] = 0x07 << from;
+        state->wide_mask[i] &= ~state->wide_split[i];
+    }
+    state->dst_shift[i] = dst_shift;
+}
+
+static void
+GetConvertState(Uint32 src_format, Uint32 dst_format, SIMD_ConvertState * state)
+{
+    const SDL_PixelFormat *srcfmt = &state->src_fmt;
+    SDL_PixelFormat dst_fmt;
+    const SDL_PixelFormat *dstfmt = &dst_fmt;
+
+    SDL_zerop(state);
+    SDL_InitFormat(&state->src_fmt, src_format);
+    SDL_InitFormat(&dst_fmt, dst_format);
+
+    if (srcfmt->BytesPerPixel == 2) {
+        AddChannelWiden(state, 0, srcfmt->Rmask, srcfmt->Rshift, srcfmt->Rloss, dstfmt->Rshift);
+        AddChannelWiden(state, 1, srcfmt->Gmask, srcfmt->Gshift, srcfmt->Gloss, dstfmt->Gshift);
+        AddChannelWiden(state, 2, srcfmt->Bmask, srcfmt->Bshift, srcfmt->Bloss, dstfmt->Bshift);
+    } else {
+        AddChannelMove(state, srcfmt->Rmask, srcfmt->Rshift, srcfmt->Rloss, dstfmt->Rshift, dstfmt->Rloss);
+        AddChannelMove(state, srcfmt->Gmask, srcfmt->Gshift, srcfmt->Gloss, dstfmt->Gshift, dstfmt->Gloss);
+        AddChannelMove(state, srcfmt->Bmask, srcfmt->Bshift, srcfmt->Bloss, dstfmt->Bshift, dstfmt->Bloss);
+        if (srcfmt->Amask && dstfmt->Amask) {
+            AddChannelMove(state, srcfmt->Amask, srcfmt->Ashift, srcfmt->Aloss, dstfmt->Ashift, dstfmt->Aloss);
+        }
+    }
+    if (dstfmt->Amask && !srcfmt->Amask) {
+        state->or_mask = dstfmt->Amask;
+    }
+}
+
+SDL_FORCE_INLINE Uint32
+MovePixel(Uint32 pixel, const SIMD_ConvertState * state)
+{
+    Uint32 result = (pixel & state->keep_mask) | state->or_mask;
+    int i;
+
+    for (i = 0; i < state->num_left; ++i) {
+        result |= (pixel & state->mask[i]) << state->shift[i];
+    }
+    for (; i < state->num_moves; ++i) {
+        result |= (pixel & state->mask[i]) >> state->shift[i];
+    }
+    return result;
+}
+
+SDL_FORCE_INLINE Uint32
+WidenPixel(Uint32 pixel, const SIMD_ConvertState * state)
+{
+    const SDL_PixelFormat *srcfmt = &state->src_fmt;
+    unsigned r, g, b;
+
+    RGB_FROM_PIXEL(pixel, srcfmt, r, g, b);
+    if (state->wide_split[1]) {
+        const Uint32 g6 = (pixel & srcfmt->Gmask) >> srcfmt->Gshift;
+        g = SDL_expand_byte[2][g6 & 0x38] + SDL_expand_byte[2][g6 & 0x07];
+    }
+    return (r << state->dst_shift[0]) | (g << state->dst_shift[1]) |
+           (b << state->dst_shift[2]) | state->or_mask;
+}
+
+static void
+ConvertRow32to32(const Uint8 * src, Uint8 * dst, int n, const SIMD_ConvertState * state)
+{
+    const Uint32 *s = (const Uint32 *) src;
+    Uint32 *d = (Uint32 *) dst;
+
+    while (n--) {
+        *d++ = MovePixel(*s++, state);
+    }
+}
+
+static void
+ConvertRow32to16(const Uint8 * src, Uint8 * dst, int n, const SIMD_ConvertState * state)
+{
+    const Uint32 *s = (const Uint32 *) src;
+    Uint16 *d = (Uint16 *) dst;
+
+    while (n--) {
+        *d++ = (Uint16) MovePixel(*s++, state);
+    }
+}
+
+static void
+ConvertRow16to32(const Uint8 * src, Uint8 * dst, int n, const SIMD_ConvertState * state)
+{
+    const Uint16 *s = (const Uint16 *) src;
+    Uint32 *d = (Uint32 *) dst;
+
+    while (n--) {
+        *d++ = WidenPixel(*s++, state);
+    }
+}
+
+static void
+ConvertRow24to32(const Uint8 * src, Uint8 * dst, int n, const SIMD_ConvertState * state)
+{
+    Uint32 *d = (Uint32 *) dst;
+    Uint32 pixel;
+
+    while (n--) {
+        RETRIEVE_RGB_PIXEL(src, 3, pixel);
+        *d++ = MovePixel(pixel, state);
+        src += 3;
+    }
+}
+
+static void
+ConvertRow32to24(const Uint8 * src, Uint8 * dst, int n, const SIMD_ConvertState * state)
+{
+    const Uint32 *s = (const Uint32 *) src;
+    Uint32 pixel;
+
+    while (n--) {
+        pixel = MovePixel(*s++, state);
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+        dst[0] = (Uint8) pixel;
+        dst[1] = (Uint8) (pixel >> 8);
+        dst[2] = (Uint8) (pixel >> 16);
+#else
+        dst[0] = (Uint8) (pixel >> 16);
+        dst[1] = (Uint8) (pixel >> 8);
+        dst[2] = (Uint8) pixel;
+#endif
+        dst += 3;
+    }
+}
+
+#if HAVE_SSE2_INTRINSICS
+
+#define MOVE_PIXELS_SSE2(pixels, result) \
+    do { \
+        int m; \
+        result = _mm_or_si128(or_mask, _mm_and_si128(pixels, keep_mask)); \
+        for (m = 0; m < num_left; ++m) { \
+            result = _mm_or_si128(result, _mm_sll_epi32(_mm_and_si128(pixels, mask[m]), shift[m])); \
+        } \
+        for (; m < num_moves; ++m) { \
+            result = _mm_or_si128(result, _mm_srl_epi32(_mm_and_si128(pixels, mask[m]), shift[m])); \
+        } \
+    } while (0)
+
+#define SETUP_MOVES_SSE2 \
+    __m128i mask[4], shift[4]; \
+    const __m128i keep_mask = _mm_set1_epi32((int) state->keep_mask); \
+    const __m128i or_mask = _mm_set1_epi32((int) state->or_mask); \
+    const int num_left = state->num_left; \
+    const int num_moves = state->num_moves; \
+    int i; \
+    for (i = 0; i < num_moves; ++i) { \
+        mask[i] = _mm_set1_epi32((int) state->mask[i]); \
+        shift[i] = _mm_cvtsi32_si128(state->shift[i]); \
+    }
+
+static void
+ConvertRow32to32_SSE2(const Uint8 * src, Uint8 * dst, int n, const SIMD_ConvertState * state)
+{
+    SETUP_MOVES_SSE2
+
+    for (; n >= 4; n -= 4, src += 16, dst += 16) {
+        const __m128i s = _mm_loadu_si128((const __m128i *) src);
+        __m128i d;
+
+        MOVE_PIXELS_SSE2(s, d);
+        _mm_storeu_si128((__m128i *) dst, d);
+    }
+    ConvertRow32to32(src, dst, n, state);
+}
+
+/* Eight pixels at a time, packed down to 16 bits with a signed saturate that
+   the shifts keep from clamping */
+static void
+ConvertRow32to16_SSE2(const Uint8 * src, Uint8 * dst, int n, const SIMD_ConvertState * state)
+{
+    SETUP_MOVES_SSE2
+
+    for (; n >= 8; n -= 8, src += 32, dst += 16) {
+        const __m128i s0 = _mm_loadu_si128((const __m128i *) src);
+        const __m128i s1 = _mm_loadu_si128((const __m128i *) (src + 16));
+        __m128i d0, d1;
+
+        MOVE_PIXELS_SSE2(s0, d0);
+        MOVE_PIXELS_SSE2(s1, d1);
+        d0 = _mm_srai_epi32(_mm_slli_epi32(d0, 16), 16);
+        d1 = _mm_srai_epi32(_mm_slli_epi32(d1, 16), 16);
+        _mm_storeu_si128((__m128i *) dst, _mm_packs_epi32(d0, d1));
+    }
+    ConvertRow32to16(src, dst, n, state);
+}
+
+/* Eight pixels at a time, widened like SDL_BlitKey565to8888_SSE2() */
+static void
+ConvertRow16to32_SSE2(const Uint8 * src, Uint8 * dst, int n, const SIMD_ConvertState * state)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i or_mask = _mm_set1_epi32((int) state->or_mask);
+    __m128i wide_mask[3], wide_mult[3], wide_left[3], wide_right[3], dst_shift[3];
+    const __m128i green_split = _mm_set1_epi16((short) state->wide_split[1]);
+    int i;
+
+    for (i = 0; i < 3; ++i) {
+        wide_mask[i] = _mm_set1_epi16((short) state->wide_mask[i]);
+        wide_mult[i] = _mm_set1_epi16((short) state->wide_mult[i]);
+        wide_left[i] = _mm_cvtsi32_si128(state->wide_left[i]);
+        wide_right[i] = _mm_cvtsi32_si128(state->wide_right[i]);
+        dst_shift[i] = _mm_cvtsi32_si128(state->dst_shift[i]);
+    }
+
+    for (; n >= 8; n -= 8, src += 16, dst += 32) {
+        const __m128i s = _mm_loadu_si128((const __m128i *) src);
+        __m128i d0 = or_mask, d1 = or_mask;
+
+        for (i = 0; i < 3; ++i) {
+            const __m128i aligned = _mm_srl_epi16(_mm_sll_epi16(s, wide_left[i]), wide_right[i]);
+            __m128i c = _mm_mulhi_epi16(_mm_and_si128(aligned, wide_mask[i]), wide_mult[i]);
+
+            if (i == 1) {
+                c = _mm_add_epi16(c, _mm_mulhi_epi16(_mm_and_si128(aligned, green_split), wide_mult[i]));
+            }
+            d0 = _mm_or_si128(d0, _mm_sll_epi32(_mm_unpacklo_epi16(c, zero), dst_shift[i]));
+            d1 = _mm_or_si128(d1, _mm_sll_epi32(_mm_unpackhi_epi16(c, zero), dst_shift[i]));
+        }
+        _mm_storeu_si128((__m128i *) dst, d0);
+        _mm_storeu_si128((__m128i *) (dst + 16), d1);
+    }
+    ConvertRow16to32(src, dst, n, state);
+}
+
+/* Four pixels at a time. Without a byte shuffle, the 12 bytes are loaded as
+   two overlapping 64-bit halves and spread out into pixels with shifts. */
+static void
+ConvertRow24to32_SSE2(const Uint8 * src, Uint8 * dst, int n, const SIMD_ConvertState * state)
+{
+    const __m128i low = _mm_set_epi32(0, 0, 0, 0x00FFFFFF);
+    const __m128i high = _mm_set_epi32(0, 0, 0x00FFFFFF, 0);
+    SETUP_MOVES_SSE2
+
+    for (; n >= 4; n -= 4, src += 12, dst += 16) {
+        const __m128i q0 = _mm_loadl_epi64((const __m128i *) src);
+        const __m128i q1 = _mm_loadl_epi64((const __m128i *) (src + 4));
+        const __m128i p01 = _mm_or_si128(_mm_and_si128(q0, low), _mm_and_si128(_mm_slli_epi64(q0, 8), high));
+        const __m128i p23 = _mm_or_si128(_mm_and_si128(_mm_srli_epi64(q1, 16), low), _mm_and_si128(_mm_srli_epi64(q1, 8), high));
+        __m128i d;
+
+        MOVE_PIXELS_SSE2(_mm_unpacklo_epi64(p01, p23), d);
+        _mm_storeu_si128((__m128i *) dst, d);
+    }
+    ConvertRow24to32(src, dst, n, state);
+}
+
+/* Four pixels at a time, the other way around */
+static void
+ConvertRow32to24_SSE2(const Uint8 * src, Uint8 * dst, int n, const SIMD_ConvertState * state)
+{
+    const __m128i low = _mm_set_epi32(0, 0x00FFFFFF, 0, 0x00FFFFFF);
+    const __m128i high = _mm_set_epi32(0x0000FFFF, 0xFF000000, 0x0000FFFF, 0xFF000000);
+    SETUP_MOVES_SSE2
+
+    for (; n >= 4; n -= 4, src += 16, dst += 12) {
+        const __m128i s = _mm_loadu_si128((const __m128i *) src);
+        __m128i d, b;
+
+        MOVE_PIXELS_SSE2(s, d);
+        /* six bytes in each half */
+        d = _mm_or_si128(_mm_and_si128(d, low), _mm_and_si128(_mm_srli_epi64(d, 8), high));
+        b = _mm_srli_si128(d, 8);
+        _mm_storel_epi64((__m128i *) dst, _mm_or_si128(d, _mm_slli_epi64(b, 48)));
+        *(Uint32 *) (dst + 8) = (Uint32) _mm_cvtsi128_si32(_mm_srli_epi64(b, 16));
+    }
+    ConvertRow32to24(src, dst, n, state);
+}
+
+#endif /* HAVE_SSE2_INTRINSICS */
+
+#if HAVE_SSE_INTRINSICS
+
+#define MOVE_PIXELS_MMX(pixels, result) \
+    do { \
+        int m; \
+        result = _mm_or_si64(or_mask, _mm_and_si64(pixels, keep_mask)); \
+        for (m = 0; m < num_left; ++m) { \
+            result = _mm_or_si64(result, _mm_sll_pi32(_mm_and_si64(pixels, mask[m]), shift[m])); \
+        } \
+        for (; m < num_moves; ++m) { \
+            result = _mm_or_si64(result, _mm_srl_pi32(_mm_and_si64(pixels, mask[m]), shift[m])); \
+        } \
+    } while (0)
+
+#define SETUP_MOVES_MMX \
+    __m64 mask[4], shift[4]; \
+    const __m64 keep_mask = _mm_set1_pi32((int) state->keep_mask); \
+    const __m64 or_mask = _mm_set1_pi32((int) state->or_mask); \
+    const int num_left = state->num_left; \
+    const int num_moves = state->num_moves; \
+    int i; \
+    for (i = 0; i < num_moves; ++i) { \
+        mask[i] = _mm_set1_pi32((int) state->mask[i]); \
+        shift[i] = _mm_cvtsi32_si64(state->shift[i]); \
+    }
+
+static void
+ConvertRow32to16_MMX(const Uint8 * src, Uint8 * dst, int n, const SIMD_ConvertState * state)
+{
+    SETUP_MOVES_MMX
+
+    for (; n >= 4; n -= 4, src += 16, dst += 8) {
+        const __m64 s0 = *(const __m64 *) src;
+        const __m64 s1 = *(const __m64 *) (src + 8);
+        __m64 d0, d1;
+
+        MOVE_PIXELS_MMX(s0, d0);
+        MOVE_PIXELS_MMX(s1, d1);
+        d0 = _mm_srai_pi32(_mm_slli_pi32(d0, 16), 16);
+        d1 = _mm_srai_pi32(_mm_slli_pi32(d1, 16), 16);
+        *(__m64 *) dst = _mm_packs_pi32(d0, d1);
+    }
+    _mm_empty();
+    ConvertRow32to16(src, dst, n, state);
+}
+
+/* Four pixels at a time, widened like the SSE2 version */
+static void
+ConvertRow16to32_MMX(const Uint8 * src, Uint8 * dst, int n, const SIMD_ConvertState * state)
+{
+    const __m64 zero = _mm_setzero_si64();
+    const __m64 or_mask = _mm_set1_pi32((int) state->or_mask);
+    __m64 wide_mask[3], wide_mult[3], wide_left[3], wide_right[3], dst_shift[3];
+    const __m64 green_split = _mm_set1_pi16((short) state->wide_split[1]);
+    int i;
+
+    for (i = 0; i < 3; ++i) {
+        wide_mask[i] = _mm_set1_pi16((short) state->wide_mask[i]);
+        wide_mult[i] = _mm_set1_pi16((short) state->wide_mult[i]);
+        wide_left[i] = _mm_cvtsi32_si64(state->wide_left[i]);
+        wide_right[i] = _mm_cvtsi32_si64(state->wide_right[i]);
+        dst_shift[i] = _mm_cvtsi32_si64(state->dst_shift[i]);
+    }
+
+    for (; n >= 4; n -= 4, src += 8, dst += 16) {
+        const __m64 s = *(const __m64 *) src;
+        __m64 d0 = or_mask, d1 = or_mask;
+
+        for (i = 0; i < 3; ++i) {
+            const __m64 aligned = _mm_srl_pi16(_mm_sll_pi16(s, wide_left[i]), wide_right[i]);
+            __m64 c = _mm_mulhi_pi16(_mm_and_si64(aligned, wide_mask[i]), wide_mult[i]);
+
+            if (i == 1) {
+                c = _mm_add_pi16(c, _mm_mulhi_pi16(_mm_and_si64(aligned, green_split), wide_mult[i]));
+            }
+            d0 = _mm_or_si64(d0, _mm_sll_pi32(_mm_unpacklo_pi16(c, zero), dst_shift[i]));
+            d1 = _mm_or_si64(d1, _mm_sll_pi32(_mm_unpackhi_pi16(c, zero), dst_shift[i]));
+        }
+        *(__m64 *) dst = d0;
+        *(__m64 *) (dst + 8) = d1;
+    }
+    _mm_empty();
+    ConvertRow16to32(src, dst, n, state);
+}
+
+#endif /* HAVE_SSE_INTRINSICS */
+
+/* *INDENT-OFF* */
+static const SIMD_ConvertRowEntry convert_rows[] = {
+#if HAVE_SSE2_INTRINSICS
+    { 4, 4, SDL_CPU_SSE2, 0, ConvertRow32to32_SSE2 },
+    { 4, 2, SDL_CPU_SSE2, 0, ConvertRow32to16_SSE2 },
+    { 2, 4, SDL_CPU_SSE2, 0, ConvertRow16to32_SSE2 },
+    { 3, 4, SDL_CPU_SSE2, 0, ConvertRow24to32_SSE2 },
+    { 4, 3, SDL_CPU_SSE2, 0, ConvertRow32to24_SSE2 },
+#endif
+#if HAVE_SSE_INTRINSICS
+    { 4, 2, SDL_CPU_MMX, SDL_PIXELFORMAT_RGB555, ConvertRow32to16_MMX },
+    { 2, 4, SDL_CPU_MMX, SDL_PIXELFORMAT_RGB555, ConvertRow16to32_MMX },
+#endif
+    { 0, 0, 0, 0, NULL }
+};
+/* *INDENT-ON* */
+
+static SIMD_ConvertRow
+FindConvertRow(Uint32 src_format, Uint32 dst_format)
+{
+    const Uint32 features = SDL_GetBlitCPUFeatures();
+    const int src_bpp = SDL_BYTESPERPIXEL(src_format);
+    const int dst_bpp = SDL_BYTESPERPIXEL(dst_format);
+    const SIMD_ConvertRowEntry *entry;
+
+    if (!IsDirectConvertFormat(src_format) || !IsDirectConvertFormat(dst_format)) {
+        return NULL;
+    }
+    for (entry = convert_rows; entry->func; ++entry) {
+        if (entry->src_bpp == src_bpp && entry->dst_bpp == dst_bpp &&
+            (entry->cpu & features) == entry->cpu &&
+            (!entry->format || entry->format == src_format || entry->format == dst_format)) {
+            break;
+        }
+    }
+    return entry->func;
+}
+
+SDL_bool
+SDL_HasConvertPixels_RGB_to_RGB(Uint32 src_format, Uint32 dst_format)
+{
+    return FindConvertRow(src_format, dst_format) ? SDL_TRUE : SDL_FALSE;
+}
+
+SDL_bool
+SDL_ConvertPixels_RGB_to_RGB(int width, int height,
+                             Uint32 src_format, const void * src, int src_pitch,
+                             Uint32 dst_format, void * dst, int dst_pitch)
+{
+    SIMD_ConvertRow convert_row;
+    SIMD_ConvertState state;
+
+    if (width <= 0 || height <= 0) {
+        return SDL_FALSE;
+    }
+    convert_row = FindConvertRow(src_format, dst_format);
+    if (!convert_row) {
+        return SDL_FALSE;
+    }
+
+    GetConvertState(src_format, dst_format, &state);
+    while (height--) {
+        convert_row((const Uint8 *) src, (Uint8 *) dst, width, &state);
+        src = (const Uint8 *) src + src_pitch;
+        dst = (Uint8 *) dst + dst_pitch;
+    }
+    return SDL_TRUE;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
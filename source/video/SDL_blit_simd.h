@@ -0,0 +1,44 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2019 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+/* *INDENT-OFF* */
+
+/* SIMD versions of the SDL_blit_auto.c blitters, tried before them */
+extern SDL_BlitFuncEntry SDL_SIMDBlitFuncTable[];
+
+/* SIMD versions of the SDL_blit_N.c colour-key blitters, for blits that only
+   have SDL_COPY_COLORKEY set */
+extern SDL_BlitFuncEntry SDL_SIMDKeyBlitFuncTable[];
+
+/* Converts between the 8888, RGB888, 24-bit, RGB565 and RGB555 formats, when
+   one side is 32 bits a pixel and the CPU has SSE2, or has MMX and the other
+   side is RGB555. Returns SDL_FALSE, without setting an error, when it can't. */
+extern SDL_bool SDL_ConvertPixels_RGB_to_RGB(int width, int height,
+                                             Uint32 src_format, const void * src, int src_pitch,
+                                             Uint32 dst_format, void * dst, int dst_pitch);
+
+/* Whether SDL_ConvertPixels_RGB_to_RGB() can do this conversion */
+extern SDL_bool SDL_HasConvertPixels_RGB_to_RGB(Uint32 src_format, Uint32 dst_format);
+
+/* *INDENT-ON* */
+
+/* vi: set ts=4 sw=4 expandtab: */
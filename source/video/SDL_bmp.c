@@ -83,105 +83,94 @@ static void CorrectAlphaChannel(SDL_Surface *surface)
     }
 }
 
-SDL_Surface *
-SDL_LoadBMP_RW(SDL_RWops * src, int freesrc)
+/* Everything in a BMP file before its pixels */
+typedef struct
 {
-    SDL_bool was_error;
-    Sint64 fp_offset = 0;
-    int bmpPitch;
-    int i, pad;
-    SDL_Surface *surface;
-    Uint32 Rmask = 0;
-    Uint32 Gmask = 0;
-    Uint32 Bmask = 0;
-    Uint32 Amask = 0;
-    SDL_Palette *palette;
-    Uint8 *bits;
-    Uint8 *top, *end;
+    Sint64 fp_offset;
+    Uint32 bfOffBits;
+    Uint32 biSize;
+    Sint32 biWidth;
+    Sint32 biHeight;
     SDL_bool topDown;
-    int ExpandBMP;
+    Uint16 biBitCount;          /* 8 for 1 and 4 bit images, which are expanded */
+    int ExpandBMP;              /* the bits per pixel in the file, when expanded */
+    Uint32 biCompression;
+    Uint32 Rmask;
+    Uint32 Gmask;
+    Uint32 Bmask;
+    Uint32 Amask;
+    SDL_bool correctAlpha;
+    Uint32 biClrUsed;
+    SDL_Color colors[256];
+} SDL_BMPHeader;
+
+/* Reads the headers and palette, leaving src just past the palette */
+static int
+ReadBMPHeader(SDL_RWops * src, SDL_BMPHeader * header)
+{
+    int i;
     SDL_bool haveRGBMasks = SDL_FALSE;
     SDL_bool haveAlphaMask = SDL_FALSE;
-    SDL_bool correctAlpha = SDL_FALSE;
 
     /* The Win32 BMP file header (14 bytes) */
     char magic[2];
     /* Uint32 bfSize = 0; */
     /* Uint16 bfReserved1 = 0; */
     /* Uint16 bfReserved2 = 0; */
-    Uint32 bfOffBits = 0;
 
     /* The Win32 BITMAPINFOHEADER struct (40 bytes) */
-    Uint32 biSize = 0;
-    Sint32 biWidth = 0;
-    Sint32 biHeight = 0;
     /* Uint16 biPlanes = 0; */
-    Uint16 biBitCount = 0;
-    Uint32 biCompression = 0;
     /* Uint32 biSizeImage = 0; */
     /* Sint32 biXPelsPerMeter = 0; */
     /* Sint32 biYPelsPerMeter = 0; */
-    Uint32 biClrUsed = 0;
     /* Uint32 biClrImportant = 0; */
 
     (void) haveRGBMasks;
     (void) haveAlphaMask;
 
-    /* Make sure we are passed a valid data source */
-    surface = NULL;
-    was_error = SDL_FALSE;
-    if (src == NULL) {
-        was_error = SDL_TRUE;
-        goto done;
-    }
+    SDL_zerop(header);
 
     /* Read in the BMP file header */
-    fp_offset = SDL_RWtell(src);
+    header->fp_offset = SDL_RWtell(src);
     SDL_ClearError();
     if (SDL_RWread(src, magic, 1, 2) != 2) {
-        SDL_Error(SDL_EFREAD);
-        was_error = SDL_TRUE;
-        goto done;
+        return SDL_Error(SDL_EFREAD);
     }
     if (SDL_strncmp(magic, "BM", 2) != 0) {
-        SDL_SetError("File is not a Windows BMP file");
-        was_error = SDL_TRUE;
-        goto done;
+        return SDL_SetError("File is not a Windows BMP file");
     }
     /* bfSize = */ SDL_ReadLE32(src);
     /* bfReserved1 = */ SDL_ReadLE16(src);
     /* bfReserved2 = */ SDL_ReadLE16(src);
-    bfOffBits = SDL_ReadLE32(src);
+    header->bfOffBits = SDL_ReadLE32(src);
 
     /* Read the Win32 BITMAPINFOHEADER */
-    biSize = SDL_ReadLE32(src);
-    if (biSize == 12) {   /* really old BITMAPCOREHEADER */
-        biWidth = (Uint32) SDL_ReadLE16(src);
-        biHeight = (Uint32) SDL_ReadLE16(src);
+    header->biSize = SDL_ReadLE32(src);
+    if (header->biSize == 12) {   /* really old BITMAPCOREHEADER */
+        header->biWidth = (Uint32) SDL_ReadLE16(src);
+        header->biHeight = (Uint32) SDL_ReadLE16(src);
         /* biPlanes = */ SDL_ReadLE16(src);
-        biBitCount = SDL_ReadLE16(src);
-        biCompression = BI_RGB;
-    } else if (biSize >= 40) {  /* some version of BITMAPINFOHEADER */
+        header->biBitCount = SDL_ReadLE16(src);
+        header->biCompression = BI_RGB;
+    } else if (header->biSize >= 40) {  /* some version of BITMAPINFOHEADER */
         Uint32 headerSize;
-        biWidth = SDL_ReadLE32(src);
-        biHeight = SDL_ReadLE32(src);
+        header->biWidth = SDL_ReadLE32(src);
+        header->biHeight = SDL_ReadLE32(src);
         /* biPlanes = */ SDL_ReadLE16(src);
-        biBitCount = SDL_ReadLE16(src);
-        biCompression = SDL_ReadLE32(src);
+        header->biBitCount = SDL_ReadLE16(src);
+        header->biCompression = SDL_ReadLE32(src);
         /* biSizeImage = */ SDL_ReadLE32(src);
         /* biXPelsPerMeter = */ SDL_ReadLE32(src);
         /* biYPelsPerMeter = */ SDL_ReadLE32(src);
-        biClrUsed = SDL_ReadLE32(src);
+        header->biClrUsed = SDL_ReadLE32(src);
         /* biClrImportant = */ SDL_ReadLE32(src);
 
         /* 64 == BITMAPCOREHEADER2, an incompatible OS/2 2.x extension. Skip this stuff for now. */
-        if (biSize == 64) {
+        if (header->biSize == 64) {
             /* ignore these extra fields. */
-            if (biCompression == BI_BITFIELDS) {
+            if (header->biCompression == BI_BITFIELDS) {
                 /* this value is actually huffman compression in this variant. */
-                SDL_SetError("Compressed BMP files not supported");
-                was_error = SDL_TRUE;
-                goto done;
+                return SDL_SetError("Compressed BMP files not supported");
             }
         } else {
             /* This is complicated. If compression is BI_BITFIELDS, then
@@ -191,25 +180,25 @@ SDL_LoadBMP_RW(SDL_RWops * src, int freesrc)
                these masks stored in the exact same place, but strictly
                speaking, this is the bmiColors field in BITMAPINFO immediately
                following the legacy v1 info header, just past biSize. */
-            if (biCompression == BI_BITFIELDS) {
+            if (header->biCompression == BI_BITFIELDS) {
                 haveRGBMasks = SDL_TRUE;
-                Rmask = SDL_ReadLE32(src);
-                Gmask = SDL_ReadLE32(src);
-                Bmask = SDL_ReadLE32(src);
+                header->Rmask = SDL_ReadLE32(src);
+                header->Gmask = SDL_ReadLE32(src);
+                header->Bmask = SDL_ReadLE32(src);
 
                 /* ...v3 adds an alpha mask. */
-                if (biSize >= 56) {  /* BITMAPV3INFOHEADER; adds alpha mask */
+                if (header->biSize >= 56) {  /* BITMAPV3INFOHEADER; adds alpha mask */
                     haveAlphaMask = SDL_TRUE;
-                    Amask = SDL_ReadLE32(src);
+                    header->Amask = SDL_ReadLE32(src);
                 }
             } else {
                 /* the mask fields are ignored for v2+ headers if not BI_BITFIELD. */
-                if (biSize >= 52) {  /* BITMAPV2INFOHEADER; adds RGB masks */
+                if (header->biSize >= 52) {  /* BITMAPV2INFOHEADER; adds RGB masks */
                     /*Rmask = */ SDL_ReadLE32(src);
                     /*Gmask = */ SDL_ReadLE32(src);
                     /*Bmask = */ SDL_ReadLE32(src);
                 }
-                if (biSize >= 56) {  /* BITMAPV3INFOHEADER; adds alpha mask */
+                if (header->biSize >= 56) {  /* BITMAPV3INFOHEADER; adds alpha mask */
                     /*Amask = */ SDL_ReadLE32(src);
                 }
             }
@@ -221,76 +210,72 @@ SDL_LoadBMP_RW(SDL_RWops * src, int freesrc)
         }
 
         /* skip any header bytes we didn't handle... */
-        headerSize = (Uint32) (SDL_RWtell(src) - (fp_offset + 14));
-        if (biSize > headerSize) {
-            SDL_RWseek(src, (biSize - headerSize), RW_SEEK_CUR);
+        headerSize = (Uint32) (SDL_RWtell(src) - (header->fp_offset + 14));
+        if (header->biSize > headerSize) {
+            SDL_RWseek(src, (header->biSize - headerSize), RW_SEEK_CUR);
         }
     }
-    if (biHeight < 0) {
-        topDown = SDL_TRUE;
-        biHeight = -biHeight;
+    if (header->biHeight < 0) {
+        header->topDown = SDL_TRUE;
+        header->biHeight = -header->biHeight;
     } else {
-        topDown = SDL_FALSE;
+        header->topDown = SDL_FALSE;
     }
 
     /* Check for read error */
     if (SDL_strcmp(SDL_GetError(), "") != 0) {
-        was_error = SDL_TRUE;
-        goto done;
+        return -1;
     }
 
     /* Expand 1 and 4 bit bitmaps to 8 bits per pixel */
-    switch (biBitCount) {
+    switch (header->biBitCount) {
     case 1:
     case 4:
-        ExpandBMP = biBitCount;
-        biBitCount = 8;
+        header->ExpandBMP = header->biBitCount;
+        header->biBitCount = 8;
         break;
-    case 2:
-    case 3:
-    case 5:
-    case 6:
-    case 7:
-		SDL_SetError("%d-bpp BMP images are not supported", biBitCount);
-        was_error = SDL_TRUE;
-        goto done;
-    default:
-        ExpandBMP = 0;
+    case 8:
+    case 15:
+    case 16:
+    case 24:
+    case 32:
+        header->ExpandBMP = 0;
         break;
+    default:
+        return SDL_SetError("%d-bpp BMP images are not supported", header->biBitCount);
     }
 
-    /* We don't support any BMP compression right now */
-    switch (biCompression) {
+    switch (header->biCompression) {
     case BI_RGB:
         /* If there are no masks, use the defaults */
         SDL_assert(!haveRGBMasks);
         SDL_assert(!haveAlphaMask);
         /* Default values for the BMP format */
-        switch (biBitCount) {
+        switch (header->biBitCount) {
         case 15:
         case 16:
-            Rmask = 0x7C00;
-            Gmask = 0x03E0;
-            Bmask = 0x001F;
+            header->Rmask = 0x7C00;
+            header->Gmask = 0x03E0;
+            header->Bmask = 0x001F;
             break;
         case 24:
 #if SDL_BYTEORDER == SDL_BIG_ENDIAN
-            Rmask = 0x000000FF;
-            Gmask = 0x0000FF00;
-            Bmask = 0x00FF0000;
+            header->Rmask = 0x000000FF;
+            header->Gmask = 0x0000FF00;
+            header->Bmask = 0x00FF0000;
 #else
-            Rmask = 0x00FF0000;
-            Gmask = 0x0000FF00;
-            Bmask = 0x000000FF;
+            header->Rmask = 0x00FF0000;
+            header->Gmask = 0x0000FF00;
+            header->Bmask = 0x000000FF;
 #endif
             break;
         case 32:
             /* We don't know if this has alpha channel or not */
-            correctAlpha = SDL_TRUE;
-            Amask = 0xFF000000;
-            Rmask = 0x00FF0000;
-            Gmask = 0x0000FF00;
-            Bmask = 0x000000FF;
+            header->correctAlpha = SDL_TRUE;
+            header->Amask = 0xFF000000;
+            header->Rmask = 0x00FF0000;
+            header->Gmask = 0x0000FF00;
+            header->Bmask = 0x000000FF;
             break;
         default:
             break;
@@ -300,74 +285,111 @@ SDL_LoadBMP_RW(SDL_RWops * src, int freesrc)
     case BI_BITFIELDS:
         break;  /* we handled this in the info header. */
 
+    case BI_RLE8:
+    case BI_RLE4:
+        /* run-length encoded palette images, only read by SDL_LoadBMP_RWFormat() */
+        if (header->biCompression != (Uint32) (header->ExpandBMP == 4 ? BI_RLE4 : BI_RLE8) ||
+            header->biBitCount != 8 || header->ExpandBMP == 1) {
+            return SDL_SetError("Compressed BMP files not supported");
+        }
+        break;
+
     default:
+        return SDL_SetError("Compressed BMP files not supported");
+    }
+
+    /* Load the palette, if any */
+    if (header->biBitCount <= 8) {
+        if (header->biClrUsed == 0) {
+            header->biClrUsed = 1 << header->biBitCount;
+        } else if (header->biClrUsed > (Uint32)(1 << header->biBitCount)) {
+            return SDL_SetError("BMP file has an invalid number of colors");
+        }
+        /* colors a truncated file doesn't have stay white, as in a new palette */
+        SDL_memset(header->colors, 0xFF, sizeof(header->colors));
+        if (header->biSize == 12) {
+            for (i = 0; i < (int) header->biClrUsed; ++i) {
+                SDL_RWread(src, &header->colors[i].b, 1, 1);
+                SDL_RWread(src, &header->colors[i].g, 1, 1);
+                SDL_RWread(src, &header->colors[i].r, 1, 1);
+                header->colors[i].a = SDL_ALPHA_OPAQUE;
+            }
+        } else {
+            for (i = 0; i < (int) header->biClrUsed; ++i) {
+                SDL_RWread(src, &header->colors[i].b, 1, 1);
+                SDL_RWread(src, &header->colors[i].g, 1, 1);
+                SDL_RWread(src, &header->colors[i].r, 1, 1);
+                SDL_RWread(src, &header->colors[i].a, 1, 1);
+
+                /* According to Microsoft documentation, the fourth element
+                   is reserved and must be zero, so we shouldn't treat it as
+                   alpha.
+                */
+                header->colors[i].a = SDL_ALPHA_OPAQUE;
+            }
+        }
+    }
+    return 0;
+}
+
+SDL_Surface *
+SDL_LoadBMP_RW(SDL_RWops * src, int freesrc)
+{
+    SDL_bool was_error;
+    SDL_BMPHeader header;
+    int bmpPitch;
+    int i, pad;
+    SDL_Surface *surface;
+    SDL_Palette *palette;
+    Uint8 *bits;
+    Uint8 *top, *end;
+    Uint32 biClrUsed;
+    Uint16 biBitCount;
+    int ExpandBMP;
+
+    /* Make sure we are passed a valid data source */
+    surface = NULL;
+    was_error = SDL_FALSE;
+    header.fp_offset = 0;
+    if (src == NULL) {
+        was_error = SDL_TRUE;
+        goto done;
+    }
+
+    if (ReadBMPHeader(src, &header) < 0) {
+        was_error = SDL_TRUE;
+        goto done;
+    }
+    if (header.biCompression != BI_RGB && header.biCompression != BI_BITFIELDS) {
         SDL_SetError("Compressed BMP files not supported");
         was_error = SDL_TRUE;
         goto done;
     }
+    biBitCount = header.biBitCount;
+    biClrUsed = header.biClrUsed;
+    ExpandBMP = header.ExpandBMP;
 
     /* Create a compatible surface, note that the colors are RGB ordered */
     surface =
-        SDL_CreateRGBSurface(0, biWidth, biHeight, biBitCount, Rmask, Gmask,
-                             Bmask, Amask);
+        SDL_CreateRGBSurface(0, header.biWidth, header.biHeight, biBitCount,
+                             header.Rmask, header.Gmask, header.Bmask, header.Amask);
     if (surface == NULL) {
         was_error = SDL_TRUE;
         goto done;
     }
 
-    /* Load the palette, if any */
+    /* Set the palette, if any */
     palette = (surface->format)->palette;
     if (palette) {
         SDL_assert(biBitCount <= 8);
-        if (biClrUsed == 0) {
-            biClrUsed = 1 << biBitCount;
-		} else if (biClrUsed > (Uint32)(1 << biBitCount)) {
-			SDL_SetError("BMP file has an invalid number of colors");
-			was_error = SDL_TRUE;
-			goto done;
-        }
-        if ((int) biClrUsed > palette->ncolors) {
-            SDL_Color *colors;
-            int ncolors = biClrUsed;
-            colors =
-                (SDL_Color *) SDL_realloc(palette->colors,
-                                          ncolors *
-                                          sizeof(*palette->colors));
-            if (!colors) {
-                SDL_OutOfMemory();
-                was_error = SDL_TRUE;
-                goto done;
-            }
-            palette->ncolors = ncolors;
-            palette->colors = colors;
-        } else if ((int) biClrUsed < palette->ncolors) {
+        if ((int) biClrUsed < palette->ncolors) {
             palette->ncolors = biClrUsed;
         }
-        if (biSize == 12) {
-            for (i = 0; i < (int) biClrUsed; ++i) {
-                SDL_RWread(src, &palette->colors[i].b, 1, 1);
-                SDL_RWread(src, &palette->colors[i].g, 1, 1);
-                SDL_RWread(src, &palette->colors[i].r, 1, 1);
-                palette->colors[i].a = SDL_ALPHA_OPAQUE;
-            }
-        } else {
-            for (i = 0; i < (int) biClrUsed; ++i) {
-                SDL_RWread(src, &palette->colors[i].b, 1, 1);
-                SDL_RWread(src, &palette->colors[i].g, 1, 1);
-                SDL_RWread(src, &palette->colors[i].r, 1, 1);
-                SDL_RWread(src, &palette->colors[i].a, 1, 1);
-
-                /* According to Microsoft documentation, the fourth element
-                   is reserved and must be zero, so we shouldn't treat it as
-                   alpha.
-                */
-                palette->colors[i].a = SDL_ALPHA_OPAQUE;
-            }
-        }
+        SDL_memcpy(palette->colors, header.colors, biClrUsed * sizeof(SDL_Color));
     }
 
     /* Read the surface pixels.  Note that the bmp image is upside down */
-    if (SDL_RWseek(src, fp_offset + bfOffBits, RW_SEEK_SET) < 0) {
+    if (SDL_RWseek(src, header.fp_offset + header.bfOffBits, RW_SEEK_SET) < 0) {
         SDL_Error(SDL_EFSEEK);
         was_error = SDL_TRUE;
         goto done;
@@ -376,18 +398,18 @@ SDL_LoadBMP_RW(SDL_RWops * src, int freesrc)
     end = (Uint8 *)surface->pixels+(surface->h*surface->pitch);
     switch (ExpandBMP) {
     case 1:
-        bmpPitch = (biWidth + 7) >> 3;
+        bmpPitch = (header.biWidth + 7) >> 3;
         pad = (((bmpPitch) % 4) ? (4 - ((bmpPitch) % 4)) : 0);
         break;
     case 4:
-        bmpPitch = (biWidth + 1) >> 1;
+        bmpPitch = (header.biWidth + 1) >> 1;
         pad = (((bmpPitch) % 4) ? (4 - ((bmpPitch) % 4)) : 0);
         break;
     default:
         pad = ((surface->pitch % 4) ? (4 - (surface->pitch % 4)) : 0);
         break;
     }
-    if (topDown) {
+    if (header.topDown) {
         bits = top;
     } else {
         bits = end - surface->pitch;
@@ -461,19 +483,448 @@ SDL_LoadBMP_RW(SDL_RWops * src, int freesrc)
                 SDL_RWread(src, &padbyte, 1, 1);
             }
         }
-        if (topDown) {
+        if (header.topDown) {
             bits += surface->pitch;
         } else {
             bits -= surface->pitch;
         }
     }
-    if (correctAlpha) {
+    if (header.correctAlpha) {
         CorrectAlphaChannel(surface);
     }
   done:
     if (was_error) {
         if (src) {
-            SDL_RWseek(src, fp_offset, RW_SEEK_SET);
+            SDL_RWseek(src, header.fp_offset, RW_SEEK_SET);
+        }
+        SDL_FreeSurface(surface);
+        surface = NULL;
+    }
+    if (freesrc && src) {
+        SDL_RWclose(src);
+    }
+    return (surface);
+}
+
+/* The pixels are read this many bytes at a time, or a row at a time when
+   rows are longer */
+#define BMP_BLOCK_SIZE  (64 * 1024)
+
+typedef struct
+{
+    SDL_RWops *src;
+    Uint8 *buffer;
+    size_t size;
+    size_t pos;
+    size_t len;
+} SDL_BMPReader;
+
+/* Returns the next length bytes of the file, or NULL if it ends first */
+static Uint8 *
+ReadBMPBytes(SDL_BMPReader * reader, size_t length)
+{
+    Uint8 *bytes;
+
+    if (reader->len - reader->pos < length) {
+        size_t left = reader->len - reader->pos;
+
+        SDL_memmove(reader->buffer, reader->buffer + reader->pos, left);
+        reader->pos = 0;
+        reader->len = left + SDL_RWread(reader->src, reader->buffer + left, 1, reader->size - left);
+        if (reader->len < length) {
+            return NULL;
+        }
+    }
+    bytes = reader->buffer + reader->pos;
+    reader->pos += length;
+    return bytes;
+}
+
+/* Converts a row of the file, y rows from its start, into its place in surface */
+static int
+BlitBMPRow(const SDL_BMPHeader * header, SDL_Surface * row, void * pixels,
+           SDL_Surface * surface, int y)
+{
+    SDL_Rect srcrect, dstrect;
+    int i;
+
+    if (header->biBitCount <= 8 && header->biClrUsed < 256) {
+        const Uint8 *indices = (const Uint8 *) pixels;
+        for (i = 0; i < surface->w; ++i) {
+            if (indices[i] >= header->biClrUsed) {
+                return SDL_SetError("A BMP image contains a pixel with a color out of the palette");
+            }
+        }
+    }
+
+    srcrect.x = 0;
+    srcrect.y = 0;
+    srcrect.w = surface->w;
+    srcrect.h = 1;
+    dstrect = srcrect;
+    dstrect.y = header->topDown ? y : (surface->h - 1 - y);
+    row->pixels = pixels;
+    return SDL_LowerBlit(row, &srcrect, surface, &dstrect);
+}
+
+/* Clears the alpha of the first rows of the file, converted before any of
+   its alpha was seen to be set */
+static void
+ClearBMPAlpha(const SDL_BMPHeader * header, SDL_Surface * surface, int rows)
+{
+    const Uint32 Amask = surface->format->Amask;
+    int x, y;
+
+    for (y = 0; y < rows; ++y) {
+        Uint8 *bits = (Uint8 *) surface->pixels +
+                      (header->topDown ? y : (surface->h - 1 - y)) * surface->pitch;
+
+        switch (surface->format->BytesPerPixel) {
+        case 2:
+            for (x = 0; x < surface->w; ++x) {
+                ((Uint16 *) bits)[x] &= (Uint16) ~Amask;
+            }
+            break;
+        case 4:
+            for (x = 0; x < surface->w; ++x) {
+                ((Uint32 *) bits)[x] &= ~Amask;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+/* Decodes BI_RLE8 and BI_RLE4 pixels a row at a time into indices. Pixels
+   skipped over by the encoding are left as the first color. */
+static int
+DecodeBMPRLE(const SDL_BMPHeader * header, SDL_BMPReader * reader,
+             SDL_Surface * row, Uint8 * indices, SDL_Surface * surface)
+{
+    const SDL_bool rle4 = (header->biCompression == BI_RLE4);
+    const int w = surface->w;
+    const int h = surface->h;
+    const Uint8 *bytes;
+    int x = 0, y = 0;
+    int i, count;
+    Uint8 value;
+
+    SDL_memset(indices, 0, w);
+    while (y < h) {
+        bytes = ReadBMPBytes(reader, 2);
+        if (!bytes) {
+            return SDL_Error(SDL_EFREAD);
+        }
+        count = bytes[0];
+        value = bytes[1];
+
+        if (count) {
+            /* a run of one index, or of two taking turns for RLE4 */
+            for (i = 0; i < count && x < w; ++i, ++x) {
+                indices[x] = rle4 ? ((i & 1) ? (value & 0x0F) : (value >> 4)) : value;
+            }
+        } else if (value == 0 || value == 1) {
+            /* the end of the row, or of the image */
+            do {
+                if (BlitBMPRow(header, row, indices, surface, y) < 0) {
+                    return -1;
+                }
+                SDL_memset(indices, 0, w);
+                ++y;
+            } while (value == 1 && y < h);
+            x = 0;
+        } else if (value == 2) {
+            /* a jump right and down */
+            bytes = ReadBMPBytes(reader, 2);
+            if (!bytes) {
+                return SDL_Error(SDL_EFREAD);
+            }
+            x += bytes[0];
+            for (i = 0; i < bytes[1] && y < h; ++i) {
+                if (BlitBMPRow(header, row, indices, surface, y) < 0) {
+                    return -1;
+                }
+                SDL_memset(indices, 0, w);
+                ++y;
+            }
+        } else {
+            /* value indices as they are, padded to a whole number of words */
+            count = rle4 ? ((value + 1) / 2) : value;
+            bytes = ReadBMPBytes(reader, (count + 1) & ~1);
+            if (!bytes) {
+                return SDL_Error(SDL_EFREAD);
+            }
+            for (i = 0; i < value && x < w; ++i, ++x) {
+                indices[x] = rle4 ? ((i & 1) ? (bytes[i / 2] & 0x0F) : (bytes[i / 2] >> 4)) : bytes[i];
+            }
+        }
+    }
+    return 0;
+}
+
+SDL_Surface *
+SDL_LoadBMP_RWFormat(SDL_RWops * src, int freesrc, Uint32 format)
+{
+    SDL_bool was_error;
+    SDL_BMPHeader header;
+    SDL_BMPReader reader;
+    SDL_Surface *surface;
+    SDL_Surface *row;
+    SDL_Palette *palette;
+    Uint8 *indices;
+    Uint8 *bits;
+    Uint32 file_format;
+    Sint64 rowbytes;
+    int rowpitch;
+    SDL_bool hasAlpha;
+    int i, y;
+
+    /* Make sure we are passed a valid data source */
+    surface = NULL;
+    row = NULL;
+    indices = NULL;
+    was_error = SDL_FALSE;
+    hasAlpha = SDL_FALSE;
+    header.fp_offset = 0;
+    SDL_zero(reader);
+    if (src == NULL) {
+        was_error = SDL_TRUE;
+        goto done;
+    }
+
+    if (ReadBMPHeader(src, &header) < 0) {
+        was_error = SDL_TRUE;
+        goto done;
+    }
+    if (header.biWidth < 0) {
+        SDL_SetError("BMP file has an invalid width");
+        was_error = SDL_TRUE;
+        goto done;
+    }
+
+    /* The format of the rows in the file, with 1 and 4 bit indices expanded.
+       32-bit images that might have alpha are taken to be opaque until a
+       pixel with some alpha turns up. */
+    if (header.biBitCount <= 8) {
+        file_format = SDL_PIXELFORMAT_INDEX8;
+    } else {
+        file_format = SDL_MasksToPixelFormatEnum(header.biBitCount, header.Rmask, header.Gmask,
+                                                 header.Bmask, header.correctAlpha ? 0 : header.Amask);
+        if (file_format == SDL_PIXELFORMAT_UNKNOWN) {
+            SDL_SetError("Unknown pixel format");
+            was_error = SDL_TRUE;
+            goto done;
+        }
+    }
+    if (!format) {
+        format = SDL_MasksToPixelFormatEnum(header.biBitCount, header.Rmask, header.Gmask,
+                                            header.Bmask, header.Amask);
+        if (header.biBitCount <= 8) {
+            format = SDL_PIXELFORMAT_INDEX8;
+        }
+    }
+
+    /* Only the file's own palette can be decoded into, anything else is
+       worked out from the image in the file's format */
+    if ((SDL_ISPIXELFORMAT_INDEXED(format) && file_format != format) ||
+        SDL_ISPIXELFORMAT_FOURCC(format)) {
+        SDL_Surface *image;
+
+        if (SDL_RWseek(src, header.fp_offset, RW_SEEK_SET) < 0) {
+            SDL_Error(SDL_EFSEEK);
+            was_error = SDL_TRUE;
+            goto done;
+        }
+        image = SDL_LoadBMP_RWFormat(src, 0, 0);
+        if (image == NULL) {
+            goto done;
+        }
+        surface = SDL_ConvertSurfaceFormat(image, format, 0);
+        SDL_FreeSurface(image);
+        if (surface == NULL) {
+            was_error = SDL_TRUE;
+        }
+        goto done;
+    }
+
+    switch (header.ExpandBMP) {
+    case 1:
+        rowbytes = (((Sint64) header.biWidth + 7) / 8 + 3) & ~3;
+        break;
+    case 4:
+        rowbytes = (((Sint64) header.biWidth + 1) / 2 + 3) & ~3;
+        break;
+    default:
+        rowbytes = ((Sint64) header.biWidth * ((header.biBitCount + 7) / 8) + 3) & ~3;
+        break;
+    }
+    if (rowbytes > SDL_MAX_SINT32) {
+        SDL_OutOfMemory();
+        was_error = SDL_TRUE;
+        goto done;
+    }
+
+    /* 1 and 4 bit rows, and run-length encoded ones, are blitted from the
+       indices they're expanded into, not from the file */
+    if (header.ExpandBMP || header.biCompression == BI_RLE8 || header.biCompression == BI_RLE4) {
+        rowpitch = header.biWidth;
+    } else {
+        rowpitch = (int) rowbytes;
+    }
+
+    surface = SDL_CreateRGBSurfaceWithFormat(0, header.biWidth, header.biHeight, 0, format);
+    row = SDL_CreateRGBSurfaceWithFormatFrom(NULL, header.biWidth, 1, 0, rowpitch, file_format);
+    if (surface == NULL || row == NULL) {
+        was_error = SDL_TRUE;
+        goto done;
+    }
+    SDL_SetSurfaceBlendMode(row, SDL_BLENDMODE_NONE);
+
+    /* As SDL_ConvertSurface() leaves it, an image only blends if it had alpha */
+    if (!header.Amask) {
+        SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_NONE);
+    }
+
+    if (header.biBitCount <= 8) {
+        palette = SDL_AllocPalette(header.biClrUsed);
+        if (palette == NULL) {
+            was_error = SDL_TRUE;
+            goto done;
+        }
+        SDL_SetPaletteColors(palette, header.colors, 0, header.biClrUsed);
+        SDL_SetSurfacePalette(row, palette);
+        if (surface->format->palette) {
+            SDL_SetSurfacePalette(surface, palette);
+        }
+        SDL_FreePalette(palette);
+
+        indices = (Uint8 *) SDL_malloc(header.biWidth ? header.biWidth : 1);
+        if (indices == NULL) {
+            SDL_OutOfMemory();
+            was_error = SDL_TRUE;
+            goto done;
+        }
+    }
+
+    reader.src = src;
+    reader.size = (size_t) SDL_max(rowbytes, BMP_BLOCK_SIZE);
+    reader.buffer = (Uint8 *) SDL_malloc(reader.size);
+    if (reader.buffer == NULL) {
+        SDL_OutOfMemory();
+        was_error = SDL_TRUE;
+        goto done;
+    }
+
+    /* Read the surface pixels.  Note that the bmp image is upside down */
+    if (SDL_RWseek(src, header.fp_offset + header.bfOffBits, RW_SEEK_SET) < 0) {
+        SDL_Error(SDL_EFSEEK);
+        was_error = SDL_TRUE;
+        goto done;
+    }
+    if (surface->w == 0) {
+        goto done;
+    }
+    if (header.biCompression == BI_RLE8 || header.biCompression == BI_RLE4) {
+        if (DecodeBMPRLE(&header, &reader, row, indices, surface) < 0) {
+            was_error = SDL_TRUE;
+        }
+        goto done;
+    }
+
+    for (y = 0; y < surface->h; ++y) {
+        bits = ReadBMPBytes(&reader, (size_t) rowbytes);
+        if (!bits) {
+            SDL_Error(SDL_EFREAD);
+            was_error = SDL_TRUE;
+            goto done;
+        }
+
+        switch (header.ExpandBMP) {
+        case 1:
+        case 4:{
+                Uint8 pixel = 0;
+                int shift = (8 - header.ExpandBMP);
+                for (i = 0; i < surface->w; ++i) {
+                    if (i % (8 / header.ExpandBMP) == 0) {
+                        pixel = *bits++;
+                    }
+                    indices[i] = (pixel >> shift);
+                    pixel <<= header.ExpandBMP;
+                }
+                bits = indices;
+            }
+            break;
+
+        default:
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+            /* Byte-swap the pixels if needed. Note that the 24bpp
+               case has already been taken care of above. */
+            switch (header.biBitCount) {
+            case 15:
+            case 16:{
+                    Uint16 *pix = (Uint16 *) bits;
+                    for (i = 0; i < surface->w; i++)
+                        pix[i] = SDL_Swap16(pix[i]);
+                    break;
+                }
+
+            case 32:{
+                    Uint32 *pix = (Uint32 *) bits;
+                    for (i = 0; i < surface->w; i++)
+                        pix[i] = SDL_Swap32(pix[i]);
+                    break;
+                }
+            }
+#endif
+            break;
+        }
+
+        if (header.correctAlpha && !hasAlpha) {
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+            const Uint8 *alpha = bits;
+#else
+            const Uint8 *alpha = bits + 3;
+#endif
+            for (i = 0; i < surface->w; ++i, alpha += 4) {
+                if (*alpha != 0) {
+                    hasAlpha = SDL_TRUE;
+                    break;
+                }
+            }
+            if (hasAlpha) {
+                /* the image has alpha after all, so the rows before this had none */
+                SDL_FreeSurface(row);
+                row = SDL_CreateRGBSurfaceWithFormatFrom(NULL, surface->w, 1, 0, (int) rowbytes,
+                                                         SDL_PIXELFORMAT_ARGB8888);
+                if (row == NULL) {
+                    was_error = SDL_TRUE;
+                    goto done;
+                }
+                SDL_SetSurfaceBlendMode(row, SDL_BLENDMODE_NONE);
+                ClearBMPAlpha(&header, surface, y);
+            }
+        }
+
+        if (BlitBMPRow(&header, row, bits, surface, y) < 0) {
+            was_error = SDL_TRUE;
+            goto done;
+        }
+    }
+
+  done:
+    if (reader.buffer) {
+        /* leave the stream just past the pixels read */
+        if (!was_error && reader.len > reader.pos) {
+            SDL_RWseek(src, -(Sint64) (reader.len - reader.pos), RW_SEEK_CUR);
+        }
+        SDL_free(reader.buffer);
+    }
+    SDL_free(indices);
+    SDL_FreeSurface(row);
+    if (was_error) {
+        if (src) {
+            SDL_RWseek(src, header.fp_offset, RW_SEEK_SET);
         }
         SDL_FreeSurface(surface);
         surface = NULL;
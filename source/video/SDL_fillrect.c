@@ -24,7 +24,7 @@
 #include "SDL_blit.h"
 
 
-#ifdef __SSE__
+#if HAVE_SSE_INTRINSICS
 /* *INDENT-OFF* */
 
 #ifdef _MSC_VER
@@ -45,20 +45,22 @@
     c128 = *(__m128 *)cccc;
 #endif
 
-#define SSE_WORK \
+/* Stores 64 bytes at a time, with regular stores or ones that write around
+   the cache, and the fence that makes the latter visible after the fill */
+#define SSE_WORK(store) \
     for (i = n / 64; i--;) { \
-        _mm_stream_ps((float *)(p+0), c128); \
-        _mm_stream_ps((float *)(p+16), c128); \
-        _mm_stream_ps((float *)(p+32), c128); \
-        _mm_stream_ps((float *)(p+48), c128); \
+        store((float *)(p+0), c128); \
+        store((float *)(p+16), c128); \
+        store((float *)(p+32), c128); \
+        store((float *)(p+48), c128); \
         p += 64; \
     }
 
-#define SSE_END
+#define SSE_END(end) end
 
-#define DEFINE_SSE_FILLRECT(bpp, type) \
+#define DEFINE_SSE_FILLRECT(bpp, type, suffix, store, end) \
 static void \
-SDL_FillRect##bpp##SSE(Uint8 *pixels, int pitch, Uint32 color, int w, int h) \
+SDL_FillRect##bpp##suffix(Uint8 *pixels, int pitch, Uint32 color, int w, int h) \
 { \
     int i, n; \
     Uint8 *p = NULL; \
@@ -79,7 +81,7 @@ SDL_FillRect##bpp##SSE(Uint8 *pixels, int pitch, Uint32 color, int w, int h) \
                     p += bpp; \
                 } \
             } \
-            SSE_WORK; \
+            SSE_WORK(store); \
         } \
         if (n & 63) { \
             int remainder = (n & 63); \
@@ -92,43 +94,48 @@ SDL_FillRect##bpp##SSE(Uint8 *pixels, int pitch, Uint32 color, int w, int h) \
         pixels += pitch; \
     } \
  \
-    SSE_END; \
+    SSE_END(end); \
 }
 
-static void
-SDL_FillRect1SSE(Uint8 *pixels, int pitch, Uint32 color, int w, int h)
-{
-    int i, n;
-
-    SSE_BEGIN;
-    while (h--) {
-        Uint8 *p = pixels;
-        n = w;
-
-        if (n > 63) {
-            int adjust = 16 - ((uintptr_t)p & 15);
-            if (adjust) {
-                n -= adjust;
-                SDL_memset(p, color, adjust);
-                p += adjust;
-            }
-            SSE_WORK;
-        }
-        if (n & 63) {
-            int remainder = (n & 63);
-            SDL_memset(p, color, remainder);
-        }
-        pixels += pitch;
-    }
-
-    SSE_END;
+#define DEFINE_SSE_FILLRECT1(suffix, store, end) \
+static void \
+SDL_FillRect1##suffix(Uint8 *pixels, int pitch, Uint32 color, int w, int h) \
+{ \
+    int i, n; \
+ \
+    SSE_BEGIN; \
+    while (h--) { \
+        Uint8 *p = pixels; \
+        n = w; \
+ \
+        if (n > 63) { \
+            int adjust = 16 - ((uintptr_t)p & 15); \
+            if (adjust) { \
+                n -= adjust; \
+                SDL_memset(p, color, adjust); \
+                p += adjust; \
+            } \
+            SSE_WORK(store); \
+        } \
+        if (n & 63) { \
+            int remainder = (n & 63); \
+            SDL_memset(p, color, remainder); \
+        } \
+        pixels += pitch; \
+    } \
+ \
+    SSE_END(end); \
 }
-/* DEFINE_SSE_FILLRECT(1, Uint8) */
-DEFINE_SSE_FILLRECT(2, Uint16)
-DEFINE_SSE_FILLRECT(4, Uint32)
+
+DEFINE_SSE_FILLRECT1(SSE, _mm_store_ps, (void) 0)
+DEFINE_SSE_FILLRECT(2, Uint16, SSE, _mm_store_ps, (void) 0)
+DEFINE_SSE_FILLRECT(4, Uint32, SSE, _mm_store_ps, (void) 0)
+DEFINE_SSE_FILLRECT1(SSEStream, _mm_stream_ps, _mm_sfence())
+DEFINE_SSE_FILLRECT(2, Uint16, SSEStream, _mm_stream_ps, _mm_sfence())
+DEFINE_SSE_FILLRECT(4, Uint32, SSEStream, _mm_stream_ps, _mm_sfence())
 
 /* *INDENT-ON* */
-#endif /* __SSE__ */
+#endif /* HAVE_SSE_INTRINSICS */
 
 static void
 SDL_FillRect1(Uint8 * pixels, int pitch, Uint32 color, int w, int h)
@@ -238,6 +245,7 @@ SDL_FillRect(SDL_Surface * dst, const SDL_Rect * rect, Uint32 color)
 {
     SDL_Rect clipped;
     Uint8 *pixels;
+    SDL_bool stream;
 
     if (!dst) {
         return SDL_SetError("Passed NULL destination surface");
@@ -263,6 +271,19 @@ SDL_FillRect(SDL_Surface * dst, const SDL_Rect * rect, Uint32 color)
         }
     }
 
+    /* RLE surfaces are decoded to be filled, which also throws away any RLE
+       data set aside, and encoded again after */
+    if (SDL_MUSTLOCK(dst) && !dst->locked) {
+        int retval;
+
+        if (SDL_LockSurface(dst) < 0) {
+            return -1;
+        }
+        retval = SDL_FillRect(dst, rect, color);
+        SDL_UnlockSurface(dst);
+        return retval;
+    }
+
     /* Perform software fill */
     if (!dst->pixels) {
         return SDL_SetError("SDL_FillRect(): You must lock the surface");
@@ -271,14 +292,22 @@ SDL_FillRect(SDL_Surface * dst, const SDL_Rect * rect, Uint32 color)
     pixels = (Uint8 *) dst->pixels + rect->y * dst->pitch +
                                      rect->x * dst->format->BytesPerPixel;
 
+    /* Big fills, like clearing the screen, write around the cache to leave
+       what the next blits need in it */
+    stream = (rect->w * dst->format->BytesPerPixel * rect->h >= SDL_STREAMING_THRESHOLD) ? SDL_TRUE : SDL_FALSE;
+
     switch (dst->format->BytesPerPixel) {
     case 1:
         {
             color |= (color << 8);
             color |= (color << 16);
-#ifdef __SSE__
+#if HAVE_SSE_INTRINSICS
             if (SDL_HasSSE()) {
-                SDL_FillRect1SSE(pixels, dst->pitch, color, rect->w, rect->h);
+                if (stream) {
+                    SDL_FillRect1SSEStream(pixels, dst->pitch, color, rect->w, rect->h);
+                } else {
+                    SDL_FillRect1SSE(pixels, dst->pitch, color, rect->w, rect->h);
+                }
                 break;
             }
 #endif
@@ -289,9 +318,13 @@ SDL_FillRect(SDL_Surface * dst, const SDL_Rect * rect, Uint32 color)
     case 2:
         {
             color |= (color << 16);
-#ifdef __SSE__
+#if HAVE_SSE_INTRINSICS
             if (SDL_HasSSE()) {
-                SDL_FillRect2SSE(pixels, dst->pitch, color, rect->w, rect->h);
+                if (stream) {
+                    SDL_FillRect2SSEStream(pixels, dst->pitch, color, rect->w, rect->h);
+                } else {
+                    SDL_FillRect2SSE(pixels, dst->pitch, color, rect->w, rect->h);
+                }
                 break;
             }
 #endif
@@ -308,9 +341,13 @@ SDL_FillRect(SDL_Surface * dst, const SDL_Rect * rect, Uint32 color)
 
     case 4:
         {
-#ifdef __SSE__
+#if HAVE_SSE_INTRINSICS
             if (SDL_HasSSE()) {
-                SDL_FillRect4SSE(pixels, dst->pitch, color, rect->w, rect->h);
+                if (stream) {
+                    SDL_FillRect4SSEStream(pixels, dst->pitch, color, rect->w, rect->h);
+                } else {
+                    SDL_FillRect4SSE(pixels, dst->pitch, color, rect->w, rect->h);
+                }
                 break;
             }
 #endif
@@ -330,10 +367,23 @@ SDL_FillRects(SDL_Surface * dst, const SDL_Rect * rects, int count,
     int i;
     int status = 0;
 
+    if (!dst) {
+        return SDL_SetError("Passed NULL destination surface");
+    }
     if (!rects) {
         return SDL_SetError("SDL_FillRects() passed NULL rects");
     }
 
+    /* one lock for all of them, rather than encoding RLE again for each */
+    if (SDL_MUSTLOCK(dst) && !dst->locked) {
+        if (SDL_LockSurface(dst) < 0) {
+            return -1;
+        }
+        status = SDL_FillRects(dst, rects, count, color);
+        SDL_UnlockSurface(dst);
+        return status;
+    }
+
     for (i = 0; i < count; ++i) {
         status += SDL_FillRect(dst, &rects[i], color);
     }
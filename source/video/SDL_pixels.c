@@ -906,12 +906,30 @@ Map1to1(SDL_Palette * src, SDL_Palette * dst, int *identical)
 }
 
 /* Map from Palette to BitField */
+static void
+Fill1toN(Uint8 * map, SDL_Palette * pal, Uint8 Rmod, Uint8 Gmod, Uint8 Bmod, Uint8 Amod,
+         SDL_PixelFormat * dst)
+{
+    int i;
+    int bpp;
+
+    bpp = ((dst->BytesPerPixel == 3) ? 4 : dst->BytesPerPixel);
+
+    /* We memory copy to the pixel map so the endianness is preserved */
+    for (i = 0; i < pal->ncolors; ++i) {
+        Uint8 R = (Uint8) ((pal->colors[i].r * Rmod) / 255);
+        Uint8 G = (Uint8) ((pal->colors[i].g * Gmod) / 255);
+        Uint8 B = (Uint8) ((pal->colors[i].b * Bmod) / 255);
+        Uint8 A = (Uint8) ((pal->colors[i].a * Amod) / 255);
+        ASSEMBLE_RGBA(&map[i * bpp], dst->BytesPerPixel, dst, R, G, B, A);
+    }
+}
+
 static Uint8 *
 Map1toN(SDL_PixelFormat * src, Uint8 Rmod, Uint8 Gmod, Uint8 Bmod, Uint8 Amod,
         SDL_PixelFormat * dst)
 {
     Uint8 *map;
-    int i;
     int bpp;
     SDL_Palette *pal = src->palette;
 
@@ -922,14 +940,7 @@ Map1toN(SDL_PixelFormat * src, Uint8 Rmod, Uint8 Gmod, Uint8 Bmod, Uint8 Amod,
         return (NULL);
     }
 
-    /* We memory copy to the pixel map so the endianness is preserved */
-    for (i = 0; i < pal->ncolors; ++i) {
-        Uint8 R = (Uint8) ((pal->colors[i].r * Rmod) / 255);
-        Uint8 G = (Uint8) ((pal->colors[i].g * Gmod) / 255);
-        Uint8 B = (Uint8) ((pal->colors[i].b * Bmod) / 255);
-        Uint8 A = (Uint8) ((pal->colors[i].a * Amod) / 255);
-        ASSEMBLE_RGBA(&map[i * bpp], dst->BytesPerPixel, dst, R, G, B, A);
-    }
+    Fill1toN(map, pal, Rmod, Gmod, Bmod, Amod, dst);
     return (map);
 }
 
@@ -968,12 +979,10 @@ SDL_AllocBlitMap(void)
     return (map);
 }
 
-void
-SDL_InvalidateMap(SDL_BlitMap * map)
+/* Forgets the mapping to the current destination, but not the ones set aside */
+static void
+ClearMap(SDL_BlitMap * map)
 {
-    if (!map) {
-        return;
-    }
     if (map->dst) {
         /* Release our reference to the surface - see the note below */
         if (--map->dst->refcount <= 0) {
@@ -985,6 +994,140 @@ SDL_InvalidateMap(SDL_BlitMap * map)
     map->dst_palette_version = 0;
     SDL_free(map->info.table);
     map->info.table = NULL;
+
+    /* loaded RLE data is only good for the flags and palette it came with */
+    map->rle_loaded = SDL_FALSE;
+
+    /* the remembered blitters and RLE data were for the old mapping */
+    map->num_cached = 0;
+    map->next_cached = 0;
+    SDL_free(map->rle_data);
+    map->rle_data = NULL;
+}
+
+void
+SDL_InvalidateMap(SDL_BlitMap * map)
+{
+    int i;
+
+    if (!map) {
+        return;
+    }
+    ClearMap(map);
+
+    /* the mappings set aside were worked out for the surface as it was */
+    for (i = 0; i < SDL_BLIT_MAP_CACHE_SIZE; ++i) {
+        SDL_free(map->map_cache[i].table);
+        map->map_cache[i].table = NULL;
+        map->map_cache[i].dst_format = 0;
+    }
+}
+
+/* Only mappings to RGB destinations are set aside: RLE data is made from the
+   surface's pixels as well, and palette tables from the destination's palette */
+static SDL_bool
+IsMapCacheable(SDL_Surface * src, SDL_Surface * dst)
+{
+    const SDL_BlitMap *map = src->map;
+
+    return (dst && !SDL_ISPIXELFORMAT_INDEXED(dst->format->format) &&
+            !(src->flags & SDL_RLEACCEL) && !(map->info.flags & SDL_COPY_RLE_MASK) &&
+            !map->rle_data && !map->rle_loaded);
+}
+
+/* Sets aside the mapping to the current destination, taking its table along */
+static void
+CacheMap(SDL_Surface * src)
+{
+    SDL_BlitMap *map = src->map;
+    SDL_BlitMapCacheEntry *entry = NULL;
+    Uint32 format;
+    int i;
+
+    if (!map->blit || !map->data || !IsMapCacheable(src, map->dst)) {
+        return;
+    }
+    format = map->dst->format->format;
+
+    /* the entry for the same format or an unused one, else the oldest */
+    for (i = 0; i < SDL_BLIT_MAP_CACHE_SIZE; ++i) {
+        if (map->map_cache[i].dst_format == format || !map->map_cache[i].dst_format) {
+            entry = &map->map_cache[i];
+            break;
+        }
+    }
+    if (!entry) {
+        entry = &map->map_cache[0];
+        for (i = 1; i < SDL_BLIT_MAP_CACHE_SIZE; ++i) {
+            if ((map->map_clock - map->map_cache[i].last_used) >
+                (map->map_clock - entry->last_used)) {
+                entry = &map->map_cache[i];
+            }
+        }
+    }
+    SDL_free(entry->table);
+
+    entry->dst_format = format;
+    entry->last_used = map->map_clock++;
+    entry->identity = map->identity;
+    entry->table = map->info.table;
+    entry->src_palette_version = map->src_palette_version;
+    entry->r = map->info.r;
+    entry->g = map->info.g;
+    entry->b = map->info.b;
+    entry->a = map->info.a;
+    entry->blit = map->blit;
+    entry->func = (SDL_BlitFunc) map->data;
+    entry->blit_key = map->blit_key;
+    SDL_memcpy(entry->cache, map->cache, sizeof(entry->cache));
+    entry->num_cached = map->num_cached;
+    entry->next_cached = map->next_cached;
+    map->info.table = NULL;
+}
+
+/* Takes back the mapping set aside for the format of dst, if there is one */
+static SDL_bool
+UncacheMap(SDL_Surface * src, SDL_Surface * dst)
+{
+    SDL_BlitMap *map = src->map;
+    int i;
+
+    if (!IsMapCacheable(src, dst)) {
+        return SDL_FALSE;
+    }
+    for (i = 0; i < SDL_BLIT_MAP_CACHE_SIZE; ++i) {
+        SDL_BlitMapCacheEntry *entry = &map->map_cache[i];
+
+        if (entry->dst_format != dst->format->format) {
+            continue;
+        }
+        /* palette tables have the modulation built in */
+        if (entry->table &&
+            (entry->r != map->info.r || entry->g != map->info.g ||
+             entry->b != map->info.b || entry->a != map->info.a)) {
+            continue;
+        }
+
+        ClearMap(map);
+        map->dst = dst;
+        ++dst->refcount;
+        map->identity = entry->identity;
+        map->info.table = entry->table;
+        map->info.dst_fmt = dst->format;
+        map->info.dst_pitch = dst->pitch;
+        map->src_palette_version = entry->src_palette_version;
+        map->blit = entry->blit;
+        map->data = entry->func;
+        map->blit_key = entry->blit_key;
+        SDL_memcpy(map->cache, entry->cache, sizeof(map->cache));
+        map->num_cached = entry->num_cached;
+        map->next_cached = entry->next_cached;
+
+        entry->dst_format = 0;
+        entry->table = NULL;
+        return SDL_TRUE;
+    }
+    return SDL_FALSE;
 }
 
 int
@@ -993,13 +1136,18 @@ SDL_MapSurface(SDL_Surface * src, SDL_Surface * dst)
     SDL_PixelFormat *srcfmt;
     SDL_PixelFormat *dstfmt;
     SDL_BlitMap *map;
+    SDL_bool rle_loaded;
 
-    /* Clear out any previous mapping */
+    /* Clear out any previous mapping, but leave RLE data that was loaded
+       ready-made for SDL_CalculateBlit() to try with this destination, and
+       the mappings set aside for other destinations */
     map = src->map;
-    if ((src->flags & SDL_RLEACCEL) == SDL_RLEACCEL) {
+    rle_loaded = map->rle_loaded;
+    if ((src->flags & SDL_RLEACCEL) == SDL_RLEACCEL && !rle_loaded) {
         SDL_UnRLESurface(src, 1);
     }
-    SDL_InvalidateMap(map);
+    ClearMap(map);
+    map->rle_loaded = rle_loaded;
 
     /* Figure out what kind of mapping we're doing */
     map->identity = 0;
@@ -1073,6 +1221,62 @@ SDL_MapSurface(SDL_Surface * src, SDL_Surface * dst)
     return (SDL_CalculateBlit(src));
 }
 
+int
+SDL_ValidateMap(SDL_Surface * src, SDL_Surface * dst)
+{
+    SDL_BlitMap *map = src->map;
+
+    if (map->dst != dst) {
+        if (map->dst && map->dst->format == dst->format && !dst->format->palette) {
+            /* Everything worked out for the old destination holds for one of
+               the same format, RLE data included */
+            ++dst->refcount;
+            if (--map->dst->refcount <= 0) {
+                SDL_FreeSurface(map->dst);
+            }
+            map->dst = dst;
+            map->info.dst_pitch = dst->pitch;
+        } else {
+            /* Going back to a format it was blitted to before takes back the
+               mapping set aside for it */
+            CacheMap(src);
+            if (!UncacheMap(src, dst)) {
+                return SDL_MapSurface(src, dst);
+            }
+        }
+    }
+
+    /* When only the colors of a palette changed, the table it's blitted to
+       other formats with is filled in again, and the blitter stays */
+    if (map->dst == dst && map->info.table && !dst->format->palette &&
+        src->format->palette && map->src_palette_version != src->format->palette->version) {
+        Fill1toN(map->info.table, src->format->palette, map->info.r, map->info.g,
+                 map->info.b, map->info.a, dst->format);
+        map->src_palette_version = src->format->palette->version;
+    }
+
+    if ((src->map->dst != dst) ||
+        (dst->format->palette &&
+         src->map->dst_palette_version != dst->format->palette->version) ||
+        (src->format->palette &&
+         src->map->src_palette_version != src->format->palette->version)) {
+        return SDL_MapSurface(src, dst);
+    }
+    if (!src->map->blit || (SDL_COPY_BLIT_KEY(src->map->info.flags) != src->map->blit_key)) {
+        return SDL_UpdateBlit(src);
+    }
+    return 0;
+}
+
+void
+SDL_ReleaseMapDestination(SDL_Surface * src)
+{
+    if (src->map && src->map->dst) {
+        CacheMap(src);
+        ClearMap(src->map);
+    }
+}
+
 void
 SDL_FreeBlitMap(SDL_BlitMap * map)
 {
@@ -35,6 +35,13 @@ extern int SDL_InitFormat(SDL_PixelFormat * format, Uint32 pixel_format);
 extern SDL_BlitMap *SDL_AllocBlitMap(void);
 extern void SDL_InvalidateMap(SDL_BlitMap * map);
 extern int SDL_MapSurface(SDL_Surface * src, SDL_Surface * dst);
+/* Remaps src only if dst or either palette changed since it was last mapped, and
+   catches the blitter up with any changes to its blit flags. A new dst of the
+   same format, or of a format src was recently mapped to, needs no remapping. */
+extern int SDL_ValidateMap(SDL_Surface * src, SDL_Surface * dst);
+/* Lets go of src's destination, setting the mapping to it aside as
+   SDL_ValidateMap() does when src is blitted somewhere else */
+extern void SDL_ReleaseMapDestination(SDL_Surface * src);
 extern void SDL_FreeBlitMap(SDL_BlitMap * map);
 
 /* Miscellaneous functions */
@@ -26,179 +26,199 @@
    April 27, 2000 - Sam Lantinga
 */
 
+#include "SDL_atomic.h"
 #include "SDL_video.h"
 #include "SDL_blit.h"
 
-/* This isn't ready for general consumption yet - it should be folded
-   into the general blitting mechanism.
+/* Which source pixel each destination column comes from depends only on the
+   pixel size and the two widths, so it is worked out once into a table of
+   byte offsets, and the last few tables are kept for reuse. Blits that
+   alternate between a handful of sizes each frame then never rebuild them.
 */
+#define STRETCH_CACHE_SIZE  4
 
-#if ((defined(_MSC_VER) && defined(_M_IX86))    || \
-     (defined(__WATCOMC__) && defined(__386__)) || \
-     (defined(__GNUC__) && defined(__i386__))) && SDL_ASSEMBLY_ROUTINES
-/* There's a bug with gcc 4.4.1 and -O2 where srcp doesn't get the correct
- * value after the first scanline.  FIXME? */
-/* #define USE_ASM_STRETCH */
-#endif
-
-#ifdef USE_ASM_STRETCH
-
-#ifdef HAVE_MPROTECT
-#include <sys/types.h>
-#include <sys/mman.h>
-#endif
-#ifdef __GNUC__
-#define PAGE_ALIGNED __attribute__((__aligned__(4096)))
-#else
-#define PAGE_ALIGNED
-#endif
-
-#if defined(_M_IX86) || defined(__i386__) || defined(__386__)
-#define PREFIX16    0x66
-#define STORE_BYTE  0xAA
-#define STORE_WORD  0xAB
-#define LOAD_BYTE   0xAC
-#define LOAD_WORD   0xAD
-#define RETURN      0xC3
-#else
-#error Need assembly opcodes for this architecture
-#endif
-
-static unsigned char copy_row[4096] PAGE_ALIGNED;
-
-static int
-generate_rowbytes(int src_w, int dst_w, int bpp)
+typedef struct
 {
-    static struct
-    {
-        int bpp;
-        int src_w;
-        int dst_w;
-        int status;
-    } last;
+    int bpp;
+    int src_w;
+    int dst_w;
+    int refcount;       /* one for being in the cache, one for each blit using it */
+    int *offsets;       /* byte offset into the source row for each destination pixel */
+} SDL_StretchColumns;
 
-    int i;
-    int pos, inc;
-    unsigned char *eip, *fence;
-    unsigned char load, store;
+/* Most recently used first */
+static SDL_StretchColumns *stretch_cache[STRETCH_CACHE_SIZE];
+static SDL_SpinLock stretch_lock = 0;
 
-    /* See if we need to regenerate the copy buffer */
-    if ((src_w == last.src_w) && (dst_w == last.dst_w) && (bpp == last.bpp)) {
-        return (last.status);
-    }
-    last.bpp = bpp;
-    last.src_w = src_w;
-    last.dst_w = dst_w;
-    last.status = -1;
+static SDL_StretchColumns *
+CreateColumns(int bpp, int src_w, int dst_w)
+{
+    SDL_StretchColumns *columns;
+    int i, pos, inc, src_x;
 
-    switch (bpp) {
-    case 1:
-        load = LOAD_BYTE;
-        store = STORE_BYTE;
-        break;
-    case 2:
-    case 4:
-        load = LOAD_WORD;
-        store = STORE_WORD;
-        break;
-    default:
-        return SDL_SetError("ASM stretch of %d bytes isn't supported", bpp);
+    columns = (SDL_StretchColumns *) SDL_malloc(sizeof(*columns));
+    if (!columns) {
+        SDL_OutOfMemory();
+        return NULL;
     }
-#ifdef HAVE_MPROTECT
-    /* Make the code writeable */
-    if (mprotect(copy_row, sizeof(copy_row), PROT_READ | PROT_WRITE) < 0) {
-        return SDL_SetError("Couldn't make copy buffer writeable");
+    columns->offsets = (int *) SDL_malloc(dst_w * sizeof(int));
+    if (!columns->offsets) {
+        SDL_free(columns);
+        SDL_OutOfMemory();
+        return NULL;
     }
-#endif
+    columns->bpp = bpp;
+    columns->src_w = src_w;
+    columns->dst_w = dst_w;
+    columns->refcount = 1;
+
+    /* Step through the source the same way the rows are stepped through */
     pos = 0x10000;
     inc = (src_w << 16) / dst_w;
-    eip = copy_row;
-    fence = copy_row + sizeof(copy_row)-2;
+    src_x = -1;
     for (i = 0; i < dst_w; ++i) {
         while (pos >= 0x10000L) {
-            if (eip == fence) {
-                return -1;
-            }
-            if (bpp == 2) {
-                *eip++ = PREFIX16;
-            }
-            *eip++ = load;
+            ++src_x;
             pos -= 0x10000L;
         }
-        if (eip == fence) {
-            return -1;
-        }
-        if (bpp == 2) {
-            *eip++ = PREFIX16;
-        }
-        *eip++ = store;
+        columns->offsets[i] = src_x * bpp;
         pos += inc;
     }
-    *eip++ = RETURN;
+    return columns;
+}
 
-#ifdef HAVE_MPROTECT
-    /* Make the code executable but not writeable */
-    if (mprotect(copy_row, sizeof(copy_row), PROT_READ | PROT_EXEC) < 0) {
-        return SDL_SetError("Couldn't make copy buffer executable");
+static void
+ReleaseColumns(SDL_StretchColumns *columns)
+{
+    SDL_AtomicLock(&stretch_lock);
+    if (--columns->refcount > 0) {
+        columns = NULL;
+    }
+    SDL_AtomicUnlock(&stretch_lock);
+
+    if (columns) {
+        SDL_free(columns->offsets);
+        SDL_free(columns);
     }
-#endif
-    last.status = 0;
-    return (0);
 }
 
-#endif /* USE_ASM_STRETCH */
+/* Returns the column table for this stretch with a reference held on it */
+static SDL_StretchColumns *
+GetColumns(int bpp, int src_w, int dst_w)
+{
+    SDL_StretchColumns *columns;
+    SDL_StretchColumns *evicted = NULL;
+    int i;
+
+    SDL_AtomicLock(&stretch_lock);
+    for (i = 0; i < STRETCH_CACHE_SIZE && stretch_cache[i]; ++i) {
+        columns = stretch_cache[i];
+        if (columns->bpp == bpp && columns->src_w == src_w && columns->dst_w == dst_w) {
+            /* Move it to the front */
+            SDL_memmove(&stretch_cache[1], &stretch_cache[0], i * sizeof(columns));
+            stretch_cache[0] = columns;
+            ++columns->refcount;
+            SDL_AtomicUnlock(&stretch_lock);
+            return columns;
+        }
+    }
+    SDL_AtomicUnlock(&stretch_lock);
+
+    /* Build it without holding the lock, it's the slow part */
+    columns = CreateColumns(bpp, src_w, dst_w);
+    if (!columns) {
+        return NULL;
+    }
+
+    SDL_AtomicLock(&stretch_lock);
+    evicted = stretch_cache[STRETCH_CACHE_SIZE - 1];
+    SDL_memmove(&stretch_cache[1], &stretch_cache[0], (STRETCH_CACHE_SIZE - 1) * sizeof(columns));
+    stretch_cache[0] = columns;
+    ++columns->refcount;
+    SDL_AtomicUnlock(&stretch_lock);
+
+    /* Blits still using the table it pushed out free it when they're done */
+    if (evicted) {
+        ReleaseColumns(evicted);
+    }
+    return columns;
+}
+
+void
+SDL_QuitStretch(void)
+{
+    SDL_StretchColumns *cache[STRETCH_CACHE_SIZE];
+    int i;
 
-#define DEFINE_COPY_ROW(name, type)         \
-static void name(type *src, int src_w, type *dst, int dst_w)    \
+    SDL_AtomicLock(&stretch_lock);
+    SDL_memcpy(cache, stretch_cache, sizeof(cache));
+    SDL_zero(stretch_cache);
+    SDL_AtomicUnlock(&stretch_lock);
+
+    for (i = 0; i < STRETCH_CACHE_SIZE && cache[i]; ++i) {
+        ReleaseColumns(cache[i]);
+    }
+}
+
+#define DEFINE_STRETCH_ROW(name, type)      \
+static void name(const Uint8 *src, Uint8 *dst, const int *offsets, int width)   \
 {                                           \
+    type *d = (type *) dst;                 \
     int i;                                  \
-    int pos, inc;                           \
-    type pixel = 0;                         \
                                             \
-    pos = 0x10000;                          \
-    inc = (src_w << 16) / dst_w;            \
-    for ( i=dst_w; i>0; --i ) {             \
-        while ( pos >= 0x10000L ) {         \
-            pixel = *src++;                 \
-            pos -= 0x10000L;                \
-        }                                   \
-        *dst++ = pixel;                     \
-        pos += inc;                         \
+    for (i = 0; i + 4 <= width; i += 4) {   \
+        d[i + 0] = *(const type *) (src + offsets[i + 0]);  \
+        d[i + 1] = *(const type *) (src + offsets[i + 1]);  \
+        d[i + 2] = *(const type *) (src + offsets[i + 2]);  \
+        d[i + 3] = *(const type *) (src + offsets[i + 3]);  \
+    }                                       \
+    for (; i < width; ++i) {                \
+        d[i] = *(const type *) (src + offsets[i]);          \
     }                                       \
 }
 /* *INDENT-OFF* */
-DEFINE_COPY_ROW(copy_row1, Uint8)
-DEFINE_COPY_ROW(copy_row2, Uint16)
-DEFINE_COPY_ROW(copy_row4, Uint32)
+DEFINE_STRETCH_ROW(stretch_row1, Uint8)
+DEFINE_STRETCH_ROW(stretch_row2, Uint16)
+DEFINE_STRETCH_ROW(stretch_row4, Uint32)
 /* *INDENT-ON* */
 
-/* The ASM code doesn't handle 24-bpp stretch blits */
 static void
-copy_row3(Uint8 * src, int src_w, Uint8 * dst, int dst_w)
+stretch_row3(const Uint8 *src, Uint8 *dst, const int *offsets, int width)
 {
     int i;
-    int pos, inc;
-    Uint8 pixel[3] = { 0, 0, 0 };
 
-    pos = 0x10000;
-    inc = (src_w << 16) / dst_w;
-    for (i = dst_w; i > 0; --i) {
-        while (pos >= 0x10000L) {
-            pixel[0] = *src++;
-            pixel[1] = *src++;
-            pixel[2] = *src++;
-            pos -= 0x10000L;
-        }
+    for (i = 0; i < width; ++i) {
+        const Uint8 *pixel = src + offsets[i];
         *dst++ = pixel[0];
         *dst++ = pixel[1];
         *dst++ = pixel[2];
-        pos += inc;
     }
 }
 
-/* Perform a stretch blit between two surfaces of the same format.
-   NOTE:  This function is not safe to call from multiple threads!
-*/
+#ifdef __SSE2__
+/* Loads are still one pixel at a time, but four go out in a single store */
+static void
+stretch_row4_SSE2(const Uint8 *src, Uint8 *dst, const int *offsets, int width)
+{
+    Uint32 *d = (Uint32 *) dst;
+    int i;
+
+    for (i = 0; i + 4 <= width; i += 4) {
+        const __m128i p0 = _mm_cvtsi32_si128(*(const int *) (src + offsets[i + 0]));
+        const __m128i p1 = _mm_cvtsi32_si128(*(const int *) (src + offsets[i + 1]));
+        const __m128i p2 = _mm_cvtsi32_si128(*(const int *) (src + offsets[i + 2]));
+        const __m128i p3 = _mm_cvtsi32_si128(*(const int *) (src + offsets[i + 3]));
+        const __m128i lo = _mm_unpacklo_epi32(p0, p1);
+        const __m128i hi = _mm_unpacklo_epi32(p2, p3);
+        _mm_storeu_si128((__m128i *) (d + i), _mm_unpacklo_epi64(lo, hi));
+    }
+    for (; i < width; ++i) {
+        d[i] = *(const Uint32 *) (src + offsets[i]);
+    }
+}
+#endif /* __SSE2__ */
+
+/* Perform a stretch blit between two surfaces of the same format. */
 int
 SDL_SoftStretch(SDL_Surface * src, const SDL_Rect * srcrect,
                 SDL_Surface * dst, const SDL_Rect * dstrect)
@@ -210,14 +230,12 @@ SDL_SoftStretch(SDL_Surface * src, const SDL_Rect * srcrect,
     int src_row, dst_row;
     Uint8 *srcp = NULL;
     Uint8 *dstp;
+    Uint8 *last_srcp = NULL;
+    Uint8 *last_dstp = NULL;
     SDL_Rect full_src;
     SDL_Rect full_dst;
-#ifdef USE_ASM_STRETCH
-    SDL_bool use_asm = SDL_TRUE;
-#ifdef __GNUC__
-    int u1, u2;
-#endif
-#endif /* USE_ASM_STRETCH */
+    SDL_StretchColumns *columns;
+    void (*stretch_row)(const Uint8 *, Uint8 *, const int *, int);
     const int bpp = dst->format->BytesPerPixel;
 
     if (src->format->format != dst->format->format) {
@@ -251,22 +269,54 @@ SDL_SoftStretch(SDL_Surface * src, const SDL_Rect * srcrect,
         full_dst.h = dst->h;
         dstrect = &full_dst;
     }
+    if (dstrect->w <= 0 || dstrect->h <= 0) {
+        return 0;
+    }
+
+    switch (bpp) {
+    case 1:
+        stretch_row = stretch_row1;
+        break;
+    case 2:
+        stretch_row = stretch_row2;
+        break;
+    case 3:
+        stretch_row = stretch_row3;
+        break;
+    case 4:
+        stretch_row = stretch_row4;
+#ifdef __SSE2__
+        if (SDL_HasSSE2()) {
+            stretch_row = stretch_row4_SSE2;
+        }
+#endif
+        break;
+    default:
+        return SDL_SetError("Stretch of %d bytes per pixel isn't supported", bpp);
+    }
+
+    columns = GetColumns(bpp, srcrect->w, dstrect->w);
+    if (!columns) {
+        return -1;
+    }
 
     /* Lock the destination if it's in hardware */
     dst_locked = 0;
     if (SDL_MUSTLOCK(dst)) {
         if (SDL_LockSurface(dst) < 0) {
+            ReleaseColumns(columns);
             return SDL_SetError("Unable to lock destination surface");
         }
         dst_locked = 1;
     }
-    /* Lock the source if it's in hardware */
+    /* Lock the source if it's in hardware or its pixels are RLE encoded */
     src_locked = 0;
-    if (SDL_MUSTLOCK(src)) {
+    if (SDL_MUSTLOCK(src) && !src->pixels) {
         if (SDL_LockSurface(src) < 0) {
             if (dst_locked) {
                 SDL_UnlockSurface(dst);
             }
+            ReleaseColumns(columns);
             return SDL_SetError("Unable to lock source surface");
         }
         src_locked = 1;
@@ -278,13 +328,6 @@ SDL_SoftStretch(SDL_Surface * src, const SDL_Rect * srcrect,
     src_row = srcrect->y;
     dst_row = dstrect->y;
 
-#ifdef USE_ASM_STRETCH
-    /* Write the opcodes for this stretch */
-    if ((bpp == 3) || (generate_rowbytes(srcrect->w, dstrect->w, bpp) < 0)) {
-        use_asm = SDL_FALSE;
-    }
-#endif
-
     /* Perform the stretch blit */
     for (dst_maxrow = dst_row + dstrect->h; dst_row < dst_maxrow; ++dst_row) {
         dstp = (Uint8 *) dst->pixels + (dst_row * dst->pitch)
@@ -295,48 +338,14 @@ SDL_SoftStretch(SDL_Surface * src, const SDL_Rect * srcrect,
             ++src_row;
             pos -= 0x10000L;
         }
-#ifdef USE_ASM_STRETCH
-        if (use_asm) {
-#ifdef __GNUC__
-            __asm__ __volatile__("call *%4":"=&D"(u1), "=&S"(u2)
-                                 :"0"(dstp), "1"(srcp), "r"(copy_row)
-                                 :"memory");
-#elif defined(_MSC_VER) || defined(__WATCOMC__)
-            /* *INDENT-OFF* */
-            {
-                void *code = copy_row;
-                __asm {
-                    push edi
-                    push esi
-                    mov edi, dstp
-                    mov esi, srcp
-                    call dword ptr code
-                    pop esi
-                    pop edi
-                }
-            }
-            /* *INDENT-ON* */
-#else
-#error Need inline assembly for this compiler
-#endif
-        } else
-#endif
-            switch (bpp) {
-            case 1:
-                copy_row1(srcp, srcrect->w, dstp, dstrect->w);
-                break;
-            case 2:
-                copy_row2((Uint16 *) srcp, srcrect->w,
-                          (Uint16 *) dstp, dstrect->w);
-                break;
-            case 3:
-                copy_row3(srcp, srcrect->w, dstp, dstrect->w);
-                break;
-            case 4:
-                copy_row4((Uint32 *) srcp, srcrect->w,
-                          (Uint32 *) dstp, dstrect->w);
-                break;
-            }
+        if (srcp == last_srcp) {
+            /* Stretching vertically, this row is the same as the last one */
+            SDL_memcpy(dstp, last_dstp, dstrect->w * bpp);
+        } else {
+            stretch_row(srcp, dstp, columns->offsets, dstrect->w);
+            last_srcp = srcp;
+        }
+        last_dstp = dstp;
         pos += inc;
     }
 
@@ -347,6 +356,7 @@ SDL_SoftStretch(SDL_Surface * src, const SDL_Rect * srcrect,
     if (src_locked) {
         SDL_UnlockSurface(src);
     }
+    ReleaseColumns(columns);
     return (0);
 }
 
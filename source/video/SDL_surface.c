@@ -21,13 +21,27 @@
 #include "../SDL_internal.h"
 
 #include "SDL_video.h"
+#include "SDL_hints.h"
+#include "SDL_cpuinfo.h"
 #include "SDL_sysvideo.h"
 #include "SDL_blit.h"
+#include "SDL_blit_simd.h"
 #include "SDL_RLEaccel_c.h"
 #include "SDL_pixels_c.h"
 #include "SDL_yuv_c.h"
+#include "../thread/SDL_threadpool_c.h"
 
 
+/* Conversions of at least this many pixels are split into bands of rows, at
+   least CONVERT_MIN_BAND_HEIGHT tall, that are converted on a pool of threads */
+#define CONVERT_MIN_PIXELS          (256 * 256)
+#define CONVERT_MIN_BAND_HEIGHT     16
+
+/* Made the first time it's needed, and shared by every conversion */
+static SDL_ThreadPool *convert_pool = NULL;
+static SDL_bool convert_pool_made = SDL_FALSE;
+static SDL_SpinLock convert_lock = 0;
+
 /* Check to make sure we can safely check multiplication of surface w and pitch and it won't overflow size_t */
 SDL_COMPILE_TIME_ASSERT(surface_size_assumptions,
     sizeof(int) == sizeof(Sint32) && sizeof(size_t) >= sizeof(Sint32));
@@ -252,6 +266,7 @@ int
 SDL_SetColorKey(SDL_Surface * surface, int flag, Uint32 key)
 {
     int flags;
+    Uint32 colorkey;
 
     if (!surface) {
         return SDL_InvalidParamError("surface");
@@ -266,13 +281,15 @@ SDL_SetColorKey(SDL_Surface * surface, int flag, Uint32 key)
     }
 
     flags = surface->map->info.flags;
+    colorkey = surface->map->info.colorkey;
     if (flag) {
         surface->map->info.flags |= SDL_COPY_COLORKEY;
         surface->map->info.colorkey = key;
     } else {
         surface->map->info.flags &= ~SDL_COPY_COLORKEY;
     }
-    if (surface->map->info.flags != flags) {
+    /* RLE data is encoded with the key, so a new key needs it redone too */
+    if (surface->map->info.flags != flags || surface->map->info.colorkey != colorkey) {
         SDL_InvalidateMap(surface->map);
     }
 
@@ -412,8 +429,6 @@ SDL_ConvertColorkeyToAlpha(SDL_Surface * surface, SDL_bool ignore_alpha)
 int
 SDL_SetSurfaceColorMod(SDL_Surface * surface, Uint8 r, Uint8 g, Uint8 b)
 {
-    int flags;
-
     if (!surface) {
         return -1;
     }
@@ -422,15 +437,12 @@ SDL_SetSurfaceColorMod(SDL_Surface * surface, Uint8 r, Uint8 g, Uint8 b)
     surface->map->info.g = g;
     surface->map->info.b = b;
 
-    flags = surface->map->info.flags;
+    /* the next blit picks the blitter for the new flags, see SDL_ValidateMap() */
     if (r != 0xFF || g != 0xFF || b != 0xFF) {
         surface->map->info.flags |= SDL_COPY_MODULATE_COLOR;
     } else {
         surface->map->info.flags &= ~SDL_COPY_MODULATE_COLOR;
     }
-    if (surface->map->info.flags != flags) {
-        SDL_InvalidateMap(surface->map);
-    }
     return 0;
 }
 
@@ -457,23 +469,17 @@ SDL_GetSurfaceColorMod(SDL_Surface * surface, Uint8 * r, Uint8 * g, Uint8 * b)
 int
 SDL_SetSurfaceAlphaMod(SDL_Surface * surface, Uint8 alpha)
 {
-    int flags;
-
     if (!surface) {
         return -1;
     }
 
     surface->map->info.a = alpha;
 
-    flags = surface->map->info.flags;
     if (alpha != 0xFF) {
         surface->map->info.flags |= SDL_COPY_MODULATE_ALPHA;
     } else {
         surface->map->info.flags &= ~SDL_COPY_MODULATE_ALPHA;
     }
-    if (surface->map->info.flags != flags) {
-        SDL_InvalidateMap(surface->map);
-    }
     return 0;
 }
 
@@ -493,22 +499,24 @@ SDL_GetSurfaceAlphaMod(SDL_Surface * surface, Uint8 * alpha)
 int
 SDL_SetSurfaceBlendMode(SDL_Surface * surface, SDL_BlendMode blendMode)
 {
-    int flags, status;
+    int status;
 
     if (!surface) {
         return -1;
     }
 
     status = 0;
-    flags = surface->map->info.flags;
     surface->map->info.flags &=
-        ~(SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+        ~(SDL_COPY_BLEND | SDL_COPY_BLEND_PREMULTIPLIED | SDL_COPY_ADD | SDL_COPY_MOD);
     switch (blendMode) {
     case SDL_BLENDMODE_NONE:
         break;
     case SDL_BLENDMODE_BLEND:
         surface->map->info.flags |= SDL_COPY_BLEND;
         break;
+    case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+        surface->map->info.flags |= SDL_COPY_BLEND_PREMULTIPLIED;
+        break;
     case SDL_BLENDMODE_ADD:
         surface->map->info.flags |= SDL_COPY_ADD;
         break;
@@ -520,10 +528,6 @@ SDL_SetSurfaceBlendMode(SDL_Surface * surface, SDL_BlendMode blendMode)
         break;
     }
 
-    if (surface->map->info.flags != flags) {
-        SDL_InvalidateMap(surface->map);
-    }
-
     return status;
 }
 
@@ -539,10 +543,13 @@ SDL_GetSurfaceBlendMode(SDL_Surface * surface, SDL_BlendMode *blendMode)
     }
 
     switch (surface->map->
-            info.flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD)) {
+            info.flags & (SDL_COPY_BLEND | SDL_COPY_BLEND_PREMULTIPLIED | SDL_COPY_ADD | SDL_COPY_MOD)) {
     case SDL_COPY_BLEND:
         *blendMode = SDL_BLENDMODE_BLEND;
         break;
+    case SDL_COPY_BLEND_PREMULTIPLIED:
+        *blendMode = SDL_BLENDMODE_BLEND_PREMULTIPLIED;
+        break;
     case SDL_COPY_ADD:
         *blendMode = SDL_BLENDMODE_ADD;
         break;
@@ -556,6 +563,52 @@ SDL_GetSurfaceBlendMode(SDL_Surface * surface, SDL_BlendMode *blendMode)
     return 0;
 }
 
+int
+SDL_PremultiplySurfaceAlpha(SDL_Surface * surface)
+{
+    SDL_PixelFormat *fmt;
+    Uint8 *row;
+    int x, y, bpp;
+
+    if (!surface) {
+        return SDL_InvalidParamError("surface");
+    }
+
+    fmt = surface->format;
+    bpp = fmt->BytesPerPixel;
+    if (SDL_LockSurface(surface) < 0) {
+        return -1;
+    }
+
+    /* Without an alpha channel every pixel is opaque and stays as it is */
+    if (fmt->Amask) {
+        row = (Uint8 *) surface->pixels;
+        for (y = 0; y < surface->h; ++y) {
+            Uint8 *buf = row;
+            for (x = 0; x < surface->w; ++x) {
+                Uint32 pixel;
+                unsigned r, g, b, a;
+
+                DISEMBLE_RGBA(buf, bpp, fmt, pixel, r, g, b, a);
+                if (a != SDL_ALPHA_OPAQUE) {
+                    /* Rounded the same way as the blitters blending straight alpha */
+                    r = (r * a) / 255;
+                    g = (g * a) / 255;
+                    b = (b * a) / 255;
+                    ASSEMBLE_RGBA(buf, bpp, fmt, r, g, b, a);
+                }
+                buf += bpp;
+            }
+            row += surface->pitch;
+        }
+    }
+
+    /* Set before unlocking, so RLE encoding sees the new blend mode */
+    SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+    SDL_UnlockSurface(surface);
+    return 0;
+}
+
 SDL_bool
 SDL_SetClipRect(SDL_Surface * surface, const SDL_Rect * rect)
 {
@@ -604,19 +657,8 @@ SDL_LowerBlit(SDL_Surface * src, SDL_Rect * srcrect,
               SDL_Surface * dst, SDL_Rect * dstrect)
 {
     /* Check to make sure the blit mapping is valid */
-    if ((src->map->dst != dst) ||
-        (dst->format->palette &&
-         src->map->dst_palette_version != dst->format->palette->version) ||
-        (src->format->palette &&
-         src->map->src_palette_version != src->format->palette->version)) {
-        if (SDL_MapSurface(src, dst) < 0) {
-            return (-1);
-        }
-        /* just here for debugging */
-/*         printf */
-/*             ("src = 0x%08X src->flags = %08X src->map->info.flags = %08x\ndst = 0x%08X dst->flags = %08X dst->map->info.flags = %08X\nsrc->map->blit = 0x%08x\n", */
-/*              src, dst->flags, src->map->info.flags, dst, dst->flags, */
-/*              dst->map->info.flags, src->map->blit); */
+    if (SDL_ValidateMap(src, dst) < 0) {
+        return (-1);
     }
     return (src->map->blit(src, srcrect, dst, dstrect));
 }
@@ -704,10 +746,7 @@ SDL_UpperBlit(SDL_Surface * src, const SDL_Rect * srcrect,
     }
 
     /* Switch back to a fast blit if we were previously stretching */
-    if (src->map->info.flags & SDL_COPY_NEAREST) {
-        src->map->info.flags &= ~SDL_COPY_NEAREST;
-        SDL_InvalidateMap(src->map);
-    }
+    src->map->info.flags &= ~SDL_COPY_NEAREST;
 
     if (w > 0 && h > 0) {
         SDL_Rect sr;
@@ -881,14 +920,11 @@ SDL_LowerBlitScaled(SDL_Surface * src, SDL_Rect * srcrect,
 {
     static const Uint32 complex_copy_flags = (
         SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA |
-        SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD |
+        SDL_COPY_BLEND | SDL_COPY_BLEND_PREMULTIPLIED | SDL_COPY_ADD | SDL_COPY_MOD |
         SDL_COPY_COLORKEY
     );
 
-    if (!(src->map->info.flags & SDL_COPY_NEAREST)) {
-        src->map->info.flags |= SDL_COPY_NEAREST;
-        SDL_InvalidateMap(src->map);
-    }
+    src->map->info.flags |= SDL_COPY_NEAREST;
 
     if ( !(src->map->info.flags & complex_copy_flags) &&
          src->format->format == dst->format->format &&
@@ -947,6 +983,148 @@ SDL_DuplicateSurface(SDL_Surface * surface)
     return SDL_ConvertSurface(surface, surface->format, surface->flags);
 }
 
+/* One conversion split into bands of rows. Each band is either blitted from
+   src_surface to dst_surface, or converted straight from src to dst. */
+typedef struct
+{
+    int num_bands;
+    int width;
+    int height;
+    SDL_Surface *src_surface;
+    SDL_Surface *dst_surface;
+    Uint32 src_format;
+    const Uint8 *src;
+    int src_pitch;
+    Uint32 dst_format;
+    Uint8 *dst;
+    int dst_pitch;
+} SDL_ConvertBands;
+
+static SDL_ThreadPool *
+GetConvertPool(void)
+{
+    SDL_ThreadPool *pool = NULL;
+    SDL_ThreadPool *extra = NULL;
+    const char *hint;
+    int threads;
+
+    SDL_AtomicLock(&convert_lock);
+    if (convert_pool_made) {
+        pool = convert_pool;
+        SDL_AtomicUnlock(&convert_lock);
+        return pool;
+    }
+    SDL_AtomicUnlock(&convert_lock);
+
+    /* Threads to convert with; there's no point with only one core */
+    hint = SDL_GetHint(SDL_HINT_CONVERT_THREADS);
+    threads = hint ? SDL_atoi(hint) : 0;
+    if (threads <= 0) {
+        threads = SDL_GetCPUCount();
+    }
+    if (threads > 1) {
+        pool = SDL_CreateThreadPool("SDLConvert", threads);
+    }
+
+    SDL_AtomicLock(&convert_lock);
+    if (convert_pool_made) {
+        /* another thread got there first */
+        extra = pool;
+    } else {
+        convert_pool = pool;
+        convert_pool_made = SDL_TRUE;
+    }
+    pool = convert_pool;
+    SDL_AtomicUnlock(&convert_lock);
+
+    SDL_DestroyThreadPool(extra);
+    return pool;
+}
+
+void
+SDL_QuitConvert(void)
+{
+    SDL_ThreadPool *pool;
+
+    SDL_AtomicLock(&convert_lock);
+    pool = convert_pool;
+    convert_pool = NULL;
+    convert_pool_made = SDL_FALSE;
+    SDL_AtomicUnlock(&convert_lock);
+
+    SDL_DestroyThreadPool(pool);
+}
+
+static void SDLCALL
+ConvertBand(void *userdata, int index)
+{
+    SDL_ConvertBands *bands = (SDL_ConvertBands *) userdata;
+    const int y = (bands->height * index) / bands->num_bands;
+    const int h = ((bands->height * (index + 1)) / bands->num_bands) - y;
+
+    if (bands->src_surface) {
+        SDL_Rect rect;
+
+        rect.x = 0;
+        rect.y = y;
+        rect.w = bands->width;
+        rect.h = h;
+        SDL_LowerBlit(bands->src_surface, &rect, bands->dst_surface, &rect);
+    } else {
+        SDL_ConvertPixels_RGB_to_RGB(bands->width, h,
+                                     bands->src_format, bands->src + y * bands->src_pitch, bands->src_pitch,
+                                     bands->dst_format, bands->dst + y * bands->dst_pitch, bands->dst_pitch);
+    }
+}
+
+/* Every row is converted on its own, so the bands give the same result as
+   doing it all on this thread */
+static void
+RunConvertBands(SDL_ConvertBands *bands)
+{
+    SDL_ThreadPool *pool = NULL;
+
+    bands->num_bands = 1;
+    if ((Sint64) bands->width * bands->height >= CONVERT_MIN_PIXELS) {
+        pool = GetConvertPool();
+    }
+    if (pool) {
+        bands->num_bands = SDL_min(SDL_GetThreadPoolSize(pool) * 2,
+                                   bands->height / CONVERT_MIN_BAND_HEIGHT);
+        bands->num_bands = SDL_max(bands->num_bands, 1);
+    }
+    SDL_RunThreadPool(pool, ConvertBand, bands, bands->num_bands);
+}
+
+/* Blits all of src to dst, which is the same size */
+static int
+ConvertBlit(SDL_Surface * src, SDL_Surface * dst)
+{
+    SDL_ConvertBands bands;
+    SDL_Rect rect;
+
+    /* The bands can't touch the map while it's shared, so it's set up first.
+       Locking isn't shared either, so surfaces that need it are done here. */
+    if (SDL_ValidateMap(src, dst) < 0) {
+        return -1;
+    }
+    if (SDL_MUSTLOCK(src) || SDL_MUSTLOCK(dst)) {
+        rect.x = 0;
+        rect.y = 0;
+        rect.w = src->w;
+        rect.h = src->h;
+        return SDL_LowerBlit(src, &rect, dst, &rect);
+    }
+
+    SDL_zero(bands);
+    bands.width = src->w;
+    bands.height = src->h;
+    bands.src_surface = src;
+    bands.dst_surface = dst;
+    RunConvertBands(&bands);
+    return 0;
+}
+
 /*
  * Convert a surface into the specified pixel format.
  */
@@ -957,7 +1135,6 @@ SDL_ConvertSurface(SDL_Surface * surface, const SDL_PixelFormat * format,
     SDL_Surface *convert;
     Uint32 copy_flags;
     SDL_Color copy_color;
-    SDL_Rect bounds;
     int ret;
 
     if (!surface) {
@@ -1015,11 +1192,7 @@ SDL_ConvertSurface(SDL_Surface * surface, const SDL_PixelFormat * format,
     SDL_InvalidateMap(surface->map);
 
     /* Copy over the image data */
-    bounds.x = 0;
-    bounds.y = 0;
-    bounds.w = surface->w;
-    bounds.h = surface->h;
-    ret = SDL_LowerBlit(surface, &bounds, convert, &bounds);
+    ret = ConvertBlit(surface, convert);
 
     /* Clean up the original surface, and update converted surface */
     convert->map->info.r = copy_color.r;
@@ -1028,7 +1201,7 @@ SDL_ConvertSurface(SDL_Surface * surface, const SDL_PixelFormat * format,
     convert->map->info.a = copy_color.a;
     convert->map->info.flags =
         (copy_flags &
-         ~(SDL_COPY_COLORKEY | SDL_COPY_BLEND
+         ~(SDL_COPY_COLORKEY | SDL_COPY_BLEND | SDL_COPY_BLEND_PREMULTIPLIED
            | SDL_COPY_RLE_DESIRED | SDL_COPY_RLE_COLORKEY |
            SDL_COPY_RLE_ALPHAKEY));
     surface->map->info.r = copy_color.r;
@@ -1107,7 +1280,12 @@ SDL_ConvertSurface(SDL_Surface * surface, const SDL_PixelFormat * format,
      * alpha channel or alpha modulation */
     if ((surface->format->Amask && format->Amask) ||
         (copy_flags & SDL_COPY_MODULATE_ALPHA)) {
-        SDL_SetSurfaceBlendMode(convert, SDL_BLENDMODE_BLEND);
+        /* The pixels keep whatever kind of alpha they had */
+        if (copy_flags & SDL_COPY_BLEND_PREMULTIPLIED) {
+            SDL_SetSurfaceBlendMode(convert, SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+        } else {
+            SDL_SetSurfaceBlendMode(convert, SDL_BLENDMODE_BLEND);
+        }
     }
     if ((copy_flags & SDL_COPY_RLE_DESIRED) || (flags & SDL_RLEACCEL)) {
         SDL_SetSurfaceRLE(convert, SDL_RLEACCEL);
@@ -1181,7 +1359,6 @@ int SDL_ConvertPixels(int width, int height,
     SDL_Surface src_surface, dst_surface;
     SDL_PixelFormat src_fmt, dst_fmt;
     SDL_BlitMap src_blitmap, dst_blitmap;
-    SDL_Rect rect;
     void *nonconst_src = (void *) src;
 
     /* Check to make sure we are blitting somewhere, so we don't crash */
@@ -1213,6 +1390,23 @@ int SDL_ConvertPixels(int width, int height,
         return 0;
     }
 
+    /* Common RGB formats are converted straight, without surfaces or a blit map */
+    if (width > 0 && height > 0 && SDL_HasConvertPixels_RGB_to_RGB(src_format, dst_format)) {
+        SDL_ConvertBands bands;
+
+        SDL_zero(bands);
+        bands.width = width;
+        bands.height = height;
+        bands.src_format = src_format;
+        bands.src = (const Uint8 *) src;
+        bands.src_pitch = src_pitch;
+        bands.dst_format = dst_format;
+        bands.dst = (Uint8 *) dst;
+        bands.dst_pitch = dst_pitch;
+        RunConvertBands(&bands);
+        return 0;
+    }
+
     if (!SDL_CreateSurfaceOnStack(width, height, src_format, nonconst_src,
                                   src_pitch,
                                   &src_surface, &src_fmt, &src_blitmap)) {
@@ -1223,12 +1417,7 @@ int SDL_ConvertPixels(int width, int height,
         return -1;
     }
 
-    /* Set up the rect and go! */
-    rect.x = 0;
-    rect.y = 0;
-    rect.w = width;
-    rect.h = height;
-    return SDL_LowerBlit(&src_surface, &rect, &dst_surface, &rect);
+    return ConvertBlit(&src_surface, &dst_surface);
 }
 
 /*
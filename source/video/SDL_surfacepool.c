@@ -0,0 +1,330 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2019 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+/* Surface pool: idle surfaces kept for reuse, by pixel format and size */
+
+#include "SDL_video.h"
+#include "SDL_blit.h"
+#include "SDL_RLEaccel_c.h"
+#include "SDL_pixels_c.h"
+
+/* Surfaces of each format and size go in their own bucket. The pitch follows
+   from the format and width for every surface SDL allocates the pixels of, so
+   it isn't part of the key. When all the buckets are taken, the one borrowed
+   from least recently is emptied and given to the new size. */
+#define SDL_SURFACE_POOL_BUCKETS    32
+
+typedef struct SDL_SurfacePoolBucket
+{
+    Uint32 format;
+    int w, h;
+    Uint32 last_used;
+    SDL_Surface **surfaces;
+    int num_surfaces;
+    int max_surfaces;
+} SDL_SurfacePoolBucket;
+
+struct SDL_SurfacePool
+{
+    int max_bytes;
+    int idle_bytes;
+    int idle_surfaces;
+    Uint32 clock;
+    Uint32 hits;
+    Uint32 misses;
+    Uint32 returns;
+    Uint32 discards;
+    SDL_SurfacePoolBucket buckets[SDL_SURFACE_POOL_BUCKETS];
+    int num_buckets;
+    int last_bucket;
+};
+
+static int
+SurfaceBytes(const SDL_Surface * surface)
+{
+    return surface->h * surface->pitch;
+}
+
+static SDL_SurfacePoolBucket *
+FindBucket(SDL_SurfacePool * pool, Uint32 format, int w, int h)
+{
+    SDL_SurfacePoolBucket *bucket;
+    int i;
+
+    /* the same size is usually asked for over and over */
+    if (pool->last_bucket < pool->num_buckets) {
+        bucket = &pool->buckets[pool->last_bucket];
+        if (bucket->format == format && bucket->w == w && bucket->h == h) {
+            return bucket;
+        }
+    }
+    for (i = 0; i < pool->num_buckets; ++i) {
+        bucket = &pool->buckets[i];
+        if (bucket->format == format && bucket->w == w && bucket->h == h) {
+            pool->last_bucket = i;
+            return bucket;
+        }
+    }
+    return NULL;
+}
+
+static void
+DiscardSurface(SDL_SurfacePool * pool, SDL_SurfacePoolBucket * bucket)
+{
+    SDL_Surface *surface = bucket->surfaces[--bucket->num_surfaces];
+
+    pool->idle_bytes -= SurfaceBytes(surface);
+    --pool->idle_surfaces;
+    ++pool->discards;
+    SDL_FreeSurface(surface);
+}
+
+/* The bucket borrowed from least recently that has surfaces, other than except */
+static SDL_SurfacePoolBucket *
+OldestBucket(SDL_SurfacePool * pool, const SDL_SurfacePoolBucket * except)
+{
+    SDL_SurfacePoolBucket *oldest = NULL;
+    int i;
+
+    for (i = 0; i < pool->num_buckets; ++i) {
+        SDL_SurfacePoolBucket *bucket = &pool->buckets[i];
+
+        if (bucket == except || !bucket->num_surfaces) {
+            continue;
+        }
+        if (!oldest || (pool->clock - bucket->last_used) > (pool->clock - oldest->last_used)) {
+            oldest = bucket;
+        }
+    }
+    return oldest;
+}
+
+static SDL_SurfacePoolBucket *
+GetBucket(SDL_SurfacePool * pool, Uint32 format, int w, int h)
+{
+    SDL_SurfacePoolBucket *bucket = FindBucket(pool, format, w, h);
+    int i;
+
+    if (bucket) {
+        return bucket;
+    }
+
+    if (pool->num_buckets < SDL_SURFACE_POOL_BUCKETS) {
+        bucket = &pool->buckets[pool->num_buckets++];
+    } else {
+        bucket = &pool->buckets[0];
+        for (i = 1; i < pool->num_buckets; ++i) {
+            if ((pool->clock - pool->buckets[i].last_used) > (pool->clock - bucket->last_used)) {
+                bucket = &pool->buckets[i];
+            }
+        }
+        while (bucket->num_surfaces) {
+            DiscardSurface(pool, bucket);
+        }
+    }
+    bucket->format = format;
+    bucket->w = w;
+    bucket->h = h;
+    bucket->last_used = pool->clock++;
+    pool->last_bucket = (int) (bucket - pool->buckets);
+    return bucket;
+}
+
+/* Puts the surface back the way SDL_CreateRGBSurfaceWithFormat() makes it,
+   apart from the pixels and palette */
+static void
+ResetSurface(SDL_Surface * surface)
+{
+    while (surface->locked > 0) {
+        SDL_UnlockSurface(surface);
+    }
+    if (surface->flags & SDL_RLEACCEL) {
+        SDL_UnRLESurface(surface, 1);
+    }
+    SDL_SetSurfaceRLE(surface, 0);
+    SDL_SetColorKey(surface, SDL_FALSE, 0);
+    SDL_SetSurfaceColorMod(surface, 255, 255, 255);
+    SDL_SetSurfaceAlphaMod(surface, 255);
+    SDL_SetSurfaceBlendMode(surface, surface->format->Amask ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_NONE);
+    SDL_SetClipRect(surface, NULL);
+    surface->userdata = NULL;
+
+    /* An idle surface shouldn't keep what it was blitted to alive, but the
+       mapping is set aside, so the next blit to that format is still quick */
+    SDL_ReleaseMapDestination(surface);
+}
+
+SDL_SurfacePool *
+SDL_CreateSurfacePool(int max_bytes)
+{
+    SDL_SurfacePool *pool;
+
+    if (max_bytes < 0) {
+        SDL_InvalidParamError("max_bytes");
+        return NULL;
+    }
+
+    pool = (SDL_SurfacePool *) SDL_calloc(1, sizeof(*pool));
+    if (!pool) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    pool->max_bytes = max_bytes;
+    return pool;
+}
+
+SDL_Surface *
+SDL_BorrowPoolSurface(SDL_SurfacePool * pool, int width, int height, Uint32 format)
+{
+    SDL_SurfacePoolBucket *bucket;
+    SDL_Surface *surface;
+
+    if (!pool) {
+        SDL_InvalidParamError("pool");
+        return NULL;
+    }
+    if (width < 0) {
+        SDL_InvalidParamError("width");
+        return NULL;
+    }
+    if (height < 0) {
+        SDL_InvalidParamError("height");
+        return NULL;
+    }
+
+    bucket = FindBucket(pool, format, width, height);
+    if (bucket) {
+        bucket->last_used = pool->clock++;
+        if (bucket->num_surfaces) {
+            surface = bucket->surfaces[--bucket->num_surfaces];
+            pool->idle_bytes -= SurfaceBytes(surface);
+            --pool->idle_surfaces;
+            ++pool->hits;
+            return surface;
+        }
+    }
+
+    surface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 0, format);
+    if (surface) {
+        ++pool->misses;
+    }
+    return surface;
+}
+
+void
+SDL_ReturnPoolSurface(SDL_SurfacePool * pool, SDL_Surface * surface)
+{
+    SDL_SurfacePoolBucket *bucket, *oldest;
+    int bytes;
+
+    if (!surface) {
+        return;
+    }
+    if (!pool) {
+        SDL_FreeSurface(surface);
+        return;
+    }
+
+    bytes = SurfaceBytes(surface);
+    if ((surface->flags & (SDL_PREALLOC | SDL_DONTFREE)) ||
+        (pool->max_bytes && bytes > pool->max_bytes)) {
+        ++pool->discards;
+        SDL_FreeSurface(surface);
+        return;
+    }
+
+    ResetSurface(surface);
+
+    bucket = GetBucket(pool, surface->format->format, surface->w, surface->h);
+    while (pool->max_bytes && pool->idle_bytes + bytes > pool->max_bytes) {
+        oldest = OldestBucket(pool, bucket);
+        if (!oldest) {
+            /* only surfaces of this size are left, and it has enough of them */
+            ++pool->discards;
+            SDL_FreeSurface(surface);
+            return;
+        }
+        DiscardSurface(pool, oldest);
+    }
+
+    if (bucket->num_surfaces == bucket->max_surfaces) {
+        int max_surfaces = bucket->max_surfaces ? bucket->max_surfaces * 2 : 4;
+        SDL_Surface **surfaces = (SDL_Surface **) SDL_realloc(bucket->surfaces, max_surfaces * sizeof(*surfaces));
+        if (!surfaces) {
+            ++pool->discards;
+            SDL_FreeSurface(surface);
+            return;
+        }
+        bucket->surfaces = surfaces;
+        bucket->max_surfaces = max_surfaces;
+    }
+    bucket->surfaces[bucket->num_surfaces++] = surface;
+    pool->idle_bytes += bytes;
+    ++pool->idle_surfaces;
+    ++pool->returns;
+}
+
+int
+SDL_GetSurfacePoolStats(SDL_SurfacePool * pool, SDL_SurfacePoolStats * stats)
+{
+    if (!pool) {
+        return SDL_InvalidParamError("pool");
+    }
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+
+    stats->hits = pool->hits;
+    stats->misses = pool->misses;
+    stats->returns = pool->returns;
+    stats->discards = pool->discards;
+    stats->idle_surfaces = pool->idle_surfaces;
+    stats->idle_bytes = pool->idle_bytes;
+    if (pool->hits + pool->misses) {
+        stats->hit_rate = (float) pool->hits / (float) (pool->hits + pool->misses);
+    } else {
+        stats->hit_rate = 0.0f;
+    }
+    return 0;
+}
+
+void
+SDL_DestroySurfacePool(SDL_SurfacePool * pool)
+{
+    int i, j;
+
+    if (!pool) {
+        return;
+    }
+
+    for (i = 0; i < pool->num_buckets; ++i) {
+        SDL_SurfacePoolBucket *bucket = &pool->buckets[i];
+
+        for (j = 0; j < bucket->num_surfaces; ++j) {
+            SDL_FreeSurface(bucket->surfaces[j]);
+        }
+        SDL_free(bucket->surfaces);
+    }
+    SDL_free(pool);
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
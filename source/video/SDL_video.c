@@ -365,33 +365,73 @@ SDL_CreateWindowTexture(SDL_VideoDevice *unused, SDL_Window * window, Uint32 * f
     return 0;
 }
 
+/* What one texture upload costs on top of the pixels it copies, in pixels */
+#define SDL_WINDOWTEXTURE_UPLOAD_COST   (64 * 64)
+
+static int
+SDL_UpdateWindowTextureRect(SDL_WindowTextureData *data, const SDL_Rect * rect)
+{
+    void *src;
+
+    src = (void *)((Uint8 *)data->pixels +
+                    rect->y * data->pitch +
+                    rect->x * data->bytes_per_pixel);
+    return SDL_UpdateTexture(data->texture, rect, src, data->pitch);
+}
+
 static int
 SDL_UpdateWindowTexture(SDL_VideoDevice *unused, SDL_Window * window, const SDL_Rect * rects, int numrects)
 {
     SDL_WindowTextureData *data;
-    SDL_Rect rect;
-    void *src;
+    SDL_Rect bounds, rect, clipped;
+    int i, cost, merged_cost;
 
     data = SDL_GetWindowData(window, SDL_WINDOWTEXTUREDATA);
     if (!data || !data->texture) {
         return SDL_SetError("No window texture data");
     }
 
-    /* Update a single rect that contains subrects for best DMA performance */
-    if (SDL_GetSpanEnclosingRect(window->w, window->h, numrects, rects, &rect)) {
-        src = (void *)((Uint8 *)data->pixels +
-                        rect.y * data->pitch +
-                        rect.x * data->bytes_per_pixel);
-        if (SDL_UpdateTexture(data->texture, &rect, src, data->pitch) < 0) {
-            return -1;
+    if (!SDL_GetSpanEnclosingRect(window->w, window->h, numrects, rects, &rect)) {
+        return 0;
+    }
+
+    /* A single rect that contains the subrects is best for DMA performance,
+       unless the subrects are few and far apart enough that copying the
+       space between them costs more than uploading each of them */
+    bounds.x = 0;
+    bounds.y = 0;
+    bounds.w = window->w;
+    bounds.h = window->h;
+
+    merged_cost = rect.w * rect.h + SDL_WINDOWTEXTURE_UPLOAD_COST;
+    cost = 0;
+    for (i = 0; i < numrects && cost < merged_cost; ++i) {
+        if (SDL_IntersectRect(&rects[i], &bounds, &clipped)) {
+            cost += clipped.w * clipped.h + SDL_WINDOWTEXTURE_UPLOAD_COST;
         }
+    }
 
-        if (SDL_RenderCopy(data->renderer, data->texture, NULL, NULL) < 0) {
+    if (cost < merged_cost) {
+        for (i = 0; i < numrects; ++i) {
+            if (SDL_IntersectRect(&rects[i], &bounds, &clipped)) {
+                if (SDL_UpdateWindowTextureRect(data, &clipped) < 0) {
+                    return -1;
+                }
+            }
+        }
+    } else {
+        if (SDL_UpdateWindowTextureRect(data, &rect) < 0) {
             return -1;
         }
+    }
 
-        SDL_RenderPresent(data->renderer);
+    /* The renderer presents with a discarded back buffer, so the whole
+       window has to be drawn; only the uploads can be limited to the rects */
+    if (SDL_RenderCopy(data->renderer, data->texture, NULL, NULL) < 0) {
+        return -1;
     }
+
+    SDL_RenderPresent(data->renderer);
     return 0;
 }
 
@@ -2900,6 +2940,8 @@ SDL_VideoQuit(void)
     }
     SDL_free(_this->clipboard_text);
     _this->clipboard_text = NULL;
+    SDL_QuitStretch();
+    SDL_QuitConvert();
     _this->free(_this);
     _this = NULL;
 }